@@ -8,13 +8,13 @@
 #ifndef BEAST_EXAMPLE_HTTP_ASYNC_SERVER_H_INCLUDED
 #define BEAST_EXAMPLE_HTTP_ASYNC_SERVER_H_INCLUDED
 
-#include "file_body.hpp"
 #include "mime_type.hpp"
 
 #include <beast/http.hpp>
+#include <beast/core/flat_streambuf.hpp>
 #include <beast/core/placeholders.hpp>
-#include <beast/core/streambuf.hpp>
 #include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
 #include <cstddef>
 #include <cstdio>
 #include <iostream>
@@ -186,7 +186,7 @@ private:
     class peer : public std::enable_shared_from_this<peer>
     {
         int id_;
-        streambuf sb_;
+        flat_streambuf sb_;
         socket_type sock_;
         http_async_server& server_;
         boost::asio::io_service::strand strand_;
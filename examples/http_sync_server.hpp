@@ -8,13 +8,13 @@
 #ifndef BEAST_EXAMPLE_HTTP_SYNC_SERVER_H_INCLUDED
 #define BEAST_EXAMPLE_HTTP_SYNC_SERVER_H_INCLUDED
 
-#include "file_body.hpp"
 #include "mime_type.hpp"
 
 #include <beast/http.hpp>
+#include <beast/core/flat_streambuf.hpp>
 #include <beast/core/placeholders.hpp>
-#include <beast/core/streambuf.hpp>
 #include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
 #include <cstdint>
 #include <cstdio>
 #include <functional>
@@ -150,7 +150,7 @@ private:
     do_peer(int id, socket_type&& sock0)
     {
         socket_type sock(std::move(sock0));
-        streambuf sb;
+        flat_streambuf sb;
         error_code ec;
         for(;;)
         {
@@ -13,13 +13,19 @@
 #include <beast/core/bind_handler.hpp>
 #include <beast/core/buffer_cat.hpp>
 #include <beast/core/buffer_concepts.hpp>
+#include <beast/core/buffer_sequence_cache.hpp>
 #include <beast/core/buffers_adapter.hpp>
 #include <beast/core/consuming_buffers.hpp>
 #include <beast/core/error.hpp>
+#include <beast/core/flat_streambuf.hpp>
 #include <beast/core/handler_alloc.hpp>
+#include <beast/core/handler_arena.hpp>
 #include <beast/core/handler_concepts.hpp>
 #include <beast/core/placeholders.hpp>
+#include <beast/core/pool_allocator.hpp>
 #include <beast/core/prepare_buffers.hpp>
+#include <beast/core/read_until.hpp>
+#include <beast/core/ring_streambuf.hpp>
 #include <beast/core/static_streambuf.hpp>
 #include <beast/core/static_string.hpp>
 #include <beast/core/stream_concepts.hpp>
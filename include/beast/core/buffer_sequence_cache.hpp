@@ -0,0 +1,142 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_BUFFER_SEQUENCE_CACHE_HPP
+#define BEAST_BUFFER_SEQUENCE_CACHE_HPP
+
+#include <beast/core/buffer_concepts.hpp>
+#include <boost/asio/buffer.hpp>
+#include <cstddef>
+
+namespace beast {
+
+/** Adapter which flattens a `ConstBufferSequence` into an array.
+
+    Sequences such as those returned by @ref buffer_cat, or those
+    of @ref consuming_buffers and @ref prepared_buffers, are iterated
+    lazily, which costs some work for every buffer each time they are
+    walked. A stream walks the sequence on every call to `write_some`
+    to build its list of buffers for the system call.
+
+    This adapter walks the wrapped sequence once, storing the non-empty
+    buffers in a fixed size array, and presents that array as its own
+    sequence. Iterating it is as cheap as iterating an array, and
+    @ref consume removes bytes from the front without walking the
+    wrapped sequence again. When the wrapped sequence has more than
+    `N` non-empty buffers, the adapter presents the first `N`, and
+    loads the next ones when those are consumed.
+
+    Copying or moving the adapter walks the wrapped sequence again,
+    since its buffers may refer to storage within the sequence. To
+    write from the adapter asynchronously, keep it in place and give
+    the stream a range over its buffers.
+
+    The wrapped sequence is copied into the adapter. Ownership of the
+    underlying memory is not transferred, the application is still
+    responsible for managing its lifetime.
+
+    @tparam ConstBufferSequence The buffer sequence to wrap.
+
+    @tparam N The largest number of buffers presented at once.
+*/
+template<class ConstBufferSequence, std::size_t N = 16>
+class buffer_sequence_cache
+{
+    static_assert(is_ConstBufferSequence<ConstBufferSequence>::value,
+        "ConstBufferSequence requirements not met");
+
+    static_assert(N > 0, "N must be positive");
+
+    ConstBufferSequence bs_;
+    boost::asio::const_buffer v_[N];
+    std::size_t first_ = 0;     // first buffer in v_
+    std::size_t last_ = 0;      // one past the last buffer in v_
+    std::size_t next_ = 0;      // buffers of bs_ loaded so far
+    std::size_t consumed_ = 0;  // bytes consumed so far
+    bool more_ = false;         // true if bs_ has more to load
+
+public:
+    /// The type for each element in the list of buffers.
+    using value_type = boost::asio::const_buffer;
+
+    /// A bidirectional iterator type that may be used to read elements.
+    using const_iterator = boost::asio::const_buffer const*;
+
+    /** Move constructor.
+
+        The wrapped sequence is moved, and the adapter
+        has the same bytes consumed as the other adapter.
+    */
+    buffer_sequence_cache(buffer_sequence_cache&&);
+
+    /** Copy constructor.
+
+        The wrapped sequence is copied, and the adapter
+        has the same bytes consumed as the other adapter.
+    */
+    buffer_sequence_cache(buffer_sequence_cache const&);
+
+    /** Move assignment.
+
+        The wrapped sequence is moved, and the adapter
+        has the same bytes consumed as the other adapter.
+    */
+    buffer_sequence_cache& operator=(buffer_sequence_cache&&);
+
+    /** Copy assignment.
+
+        The wrapped sequence is copied, and the adapter
+        has the same bytes consumed as the other adapter.
+    */
+    buffer_sequence_cache& operator=(buffer_sequence_cache const&);
+
+    /** Construct the adapter.
+
+        @param buffers The buffer sequence to wrap. A copy of
+        the sequence is made.
+    */
+    explicit
+    buffer_sequence_cache(ConstBufferSequence const& buffers);
+
+    /// Get a bidirectional iterator to the first element.
+    const_iterator
+    begin() const
+    {
+        return v_ + first_;
+    }
+
+    /// Get a bidirectional iterator to one past the last element.
+    const_iterator
+    end() const
+    {
+        return v_ + last_;
+    }
+
+    /// Returns `true` if every byte has been consumed.
+    bool
+    empty() const
+    {
+        return first_ == last_;
+    }
+
+    /// Remove bytes from the front of the sequence.
+    void
+    consume(std::size_t n);
+
+private:
+    void
+    reset(std::size_t consumed);
+
+    void
+    fill();
+};
+
+} // beast
+
+#include <beast/core/impl/buffer_sequence_cache.ipp>
+
+#endif
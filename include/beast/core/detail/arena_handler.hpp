@@ -0,0 +1,86 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_DETAIL_ARENA_HANDLER_HPP
+#define BEAST_DETAIL_ARENA_HANDLER_HPP
+
+#include <boost/asio/detail/handler_cont_helpers.hpp>
+#include <boost/asio/detail/handler_invoke_helpers.hpp>
+#include <cstddef>
+#include <utility>
+
+namespace beast {
+namespace detail {
+
+/*  Handler that allocates its intermediate storage from an arena.
+
+    Calls to the wrapped handler are forwarded, as are the
+    continuation and invocation hooks, so the wrapped handler
+    provides the same io_service execution guarantees as the
+    original handler.
+*/
+template<class Arena, class Handler>
+class arena_handler
+{
+    Arena& a_;
+    Handler h_;
+
+public:
+    using result_type = void;
+
+    template<class DeducedHandler>
+    arena_handler(Arena& a, DeducedHandler&& h)
+        : a_(a)
+        , h_(std::forward<DeducedHandler>(h))
+    {
+    }
+
+    template<class... Args>
+    void
+    operator()(Args&&... args)
+    {
+        h_(std::forward<Args>(args)...);
+    }
+
+    friend
+    void*
+    asio_handler_allocate(
+        std::size_t size, arena_handler* h)
+    {
+        return h->a_.allocate(size);
+    }
+
+    friend
+    void
+    asio_handler_deallocate(
+        void* p, std::size_t size, arena_handler* h)
+    {
+        h->a_.deallocate(p, size);
+    }
+
+    friend
+    bool
+    asio_handler_is_continuation(arena_handler* h)
+    {
+        return boost_asio_handler_cont_helpers::
+            is_continuation(h->h_);
+    }
+
+    template<class F>
+    friend
+    void
+    asio_handler_invoke(F&& f, arena_handler* h)
+    {
+        boost_asio_handler_invoke_helpers::
+            invoke(f, h->h_);
+    }
+};
+
+} // detail
+} // beast
+
+#endif
@@ -0,0 +1,183 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_DETAIL_BLOCK_POOL_HPP
+#define BEAST_DETAIL_BLOCK_POOL_HPP
+
+#include <cstddef>
+#include <new>
+
+namespace beast {
+namespace detail {
+
+/*  Per-thread free lists of memory blocks.
+
+    Requests are rounded up to a power of two size class. Freed
+    blocks go onto the free list of the calling thread for their
+    size class, and later requests of the same class on that
+    thread take them from there. Each list retains at most
+    max_retain bytes; beyond that, and for requests larger than
+    the largest class, blocks come from and go to operator new
+    and operator delete.
+
+    A block may be freed on a different thread than the one which
+    allocated it. It is then retained by the freeing thread.
+*/
+class block_pool
+{
+    struct node
+    {
+        node* next;
+    };
+
+    struct list
+    {
+        node* head = nullptr;
+        std::size_t count = 0;
+    };
+
+    // Size classes are the powers of two
+    // from 2^min_shift through 2^max_shift
+    static std::size_t constexpr min_shift = 6;
+    static std::size_t constexpr max_shift = 16;
+    static std::size_t constexpr nclass =
+        max_shift - min_shift + 1;
+
+    // Bytes retained in each list of each thread
+    static std::size_t constexpr max_retain = 256 * 1024;
+
+    list lists_[nclass];
+    std::size_t nalloc_ = 0;
+
+    block_pool() = default;
+
+    ~block_pool()
+    {
+        for(auto& l : lists_)
+        {
+            while(l.head)
+            {
+                auto const next = l.head->next;
+                ::operator delete(l.head);
+                l.head = next;
+            }
+        }
+        destroyed() = true;
+    }
+
+    // Set once the calling thread's pool is destroyed,
+    // so blocks freed during thread exit go to the heap.
+    static
+    bool&
+    destroyed()
+    {
+        static thread_local bool b = false;
+        return b;
+    }
+
+    static
+    block_pool*
+    local()
+    {
+        if(destroyed())
+            return nullptr;
+        static thread_local block_pool pool;
+        return &pool;
+    }
+
+    // Returns the size class for n bytes
+    static
+    std::size_t
+    index(std::size_t n)
+    {
+        std::size_t i = 0;
+        while((std::size_t{1} << (i + min_shift)) < n)
+            ++i;
+        return i;
+    }
+
+public:
+    // The largest size which is pooled
+    static std::size_t constexpr max_size =
+        std::size_t{1} << max_shift;
+
+    static
+    void*
+    allocate(std::size_t n)
+    {
+        if(n > max_size)
+            return ::operator new(n);
+        auto const i = index(n);
+        auto const pool = local();
+        if(pool)
+        {
+            auto& l = pool->lists_[i];
+            if(l.head)
+            {
+                auto const p = l.head;
+                l.head = p->next;
+                --l.count;
+                return p;
+            }
+            ++pool->nalloc_;
+        }
+        return ::operator new(
+            std::size_t{1} << (i + min_shift));
+    }
+
+    static
+    void
+    deallocate(void* p, std::size_t n) noexcept
+    {
+        if(n <= max_size)
+        {
+            auto const i = index(n);
+            auto const pool = local();
+            if(pool)
+            {
+                auto& l = pool->lists_[i];
+                if(l.count < (max_retain >> (i + min_shift)))
+                {
+                    l.head = ::new(p) node{l.head};
+                    ++l.count;
+                    return;
+                }
+            }
+        }
+        ::operator delete(p);
+    }
+
+    // Returns the number of pooled size blocks
+    // the calling thread obtained from operator new
+    static
+    std::size_t
+    heap_allocations()
+    {
+        auto const pool = local();
+        return pool ? pool->nalloc_ : 0;
+    }
+
+    // Returns the number of bytes retained by the calling thread
+    static
+    std::size_t
+    retained()
+    {
+        auto const pool = local();
+        if(! pool)
+            return 0;
+        std::size_t n = 0;
+        for(std::size_t i = 0; i < nclass; ++i)
+            n += pool->lists_[i].count <<
+                (i + min_shift);
+        return n;
+    }
+};
+
+} // detail
+} // beast
+
+#endif
@@ -0,0 +1,218 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_DETAIL_FIND_DELIMITER_HPP
+#define BEAST_DETAIL_FIND_DELIMITER_HPP
+
+#include <boost/asio/buffer.hpp>
+#include <boost/assert.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#ifndef BEAST_NO_SIMD
+# if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define BEAST_DETAIL_FIND_SSE2 1
+#  include <emmintrin.h>
+#  if defined(_MSC_VER)
+#   include <intrin.h>
+#  endif
+# endif
+#endif
+
+namespace beast {
+namespace detail {
+
+/*  Fast searching for a delimiter in a range of octets.
+
+    These routines return a pointer to the first occurrence of
+    the delimiter lying entirely within [first, last), or nullptr
+    if there is none.
+
+    A single octet delimiter is found with memchr. For longer
+    delimiters on x86, 16 starting positions are examined at a
+    time using SSE2: a position is a candidate only if it holds
+    the first octet of the delimiter and the position one less
+    than the delimiter's length later holds the last octet. For
+    delimiters such as "\r\n\r\n", this rejects the ends of the
+    lines in between without looking at them one by one. Define
+    BEAST_NO_SIMD to always use the portable implementation.
+*/
+
+inline
+char const*
+find_delimiter_generic(char const* first, char const* last,
+    char const* d, std::size_t k)
+{
+    // An empty delimiter matches at the start
+    if(k == 0)
+        return first;
+    if(static_cast<std::size_t>(last - first) < k)
+        return nullptr;
+    // One past the last position where a match may begin
+    auto const end = last - (k - 1);
+    while(first != end)
+    {
+        auto const p = static_cast<char const*>(
+            std::memchr(first, d[0], end - first));
+        if(! p)
+            return nullptr;
+        if(std::memcmp(p + 1, d + 1, k - 1) == 0)
+            return p;
+        first = p + 1;
+    }
+    return nullptr;
+}
+
+#if BEAST_DETAIL_FIND_SSE2
+
+inline
+unsigned
+find_delimiter_ctz(std::uint32_t v)
+{
+#if defined(_MSC_VER)
+    unsigned long n;
+    _BitScanForward(&n, v);
+    return static_cast<unsigned>(n);
+#else
+    return static_cast<unsigned>(__builtin_ctz(v));
+#endif
+}
+
+inline
+char const*
+find_delimiter_sse2(char const* first, char const* last,
+    char const* d, std::size_t k)
+{
+    if(k < 2)
+        return find_delimiter_generic(first, last, d, k);
+    auto const f = _mm_set1_epi8(d[0]);
+    auto const l = _mm_set1_epi8(d[k - 1]);
+    while(static_cast<std::size_t>(last - first) >= 16 + k - 1)
+    {
+        auto const a = _mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(first));
+        auto const b = _mm_loadu_si128(
+            reinterpret_cast<__m128i const*>(first + k - 1));
+        auto m = static_cast<std::uint32_t>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(a, f),
+                _mm_cmpeq_epi8(b, l))));
+        while(m != 0)
+        {
+            auto const p = first + find_delimiter_ctz(m);
+            if(std::memcmp(p + 1, d + 1, k - 2) == 0)
+                return p;
+            m &= m - 1;
+        }
+        first += 16;
+    }
+    return find_delimiter_generic(first, last, d, k);
+}
+
+#endif
+
+inline
+char const*
+find_delimiter(char const* first, char const* last,
+    char const* d, std::size_t k)
+{
+#if BEAST_DETAIL_FIND_SSE2
+    return find_delimiter_sse2(first, last, d, k);
+#else
+    return find_delimiter_generic(first, last, d, k);
+#endif
+}
+
+// Returns `true` if the delimiter begins at position
+// `pos` of the buffer at `it`, and continues into the
+// following buffers as needed.
+//
+template<class Iterator>
+bool
+match_delimiter(Iterator it, Iterator const& end,
+    std::size_t pos, boost::string_ref const& delim)
+{
+    using boost::asio::buffer_cast;
+    using boost::asio::buffer_size;
+    std::size_t i = 0;
+    for(; it != end; ++it, pos = 0)
+    {
+        boost::asio::const_buffer const b = *it;
+        auto const p = buffer_cast<char const*>(b);
+        auto const n = buffer_size(b);
+        for(; pos < n; ++pos)
+        {
+            if(p[pos] != delim[i])
+                return false;
+            if(++i == delim.size())
+                return true;
+        }
+    }
+    return false;
+}
+
+/*  Search a buffer sequence for a delimiter.
+
+    The search begins at offset `pos` in the sequence. Returns
+    the number of bytes up to and including the end of the first
+    occurrence of the delimiter, or zero if the sequence does not
+    contain it. In that case `pos` is set to the offset where the
+    next search should begin, so that the bytes already examined
+    are not examined again after more bytes are appended to the
+    sequence. Only the bytes which may begin a match continuing
+    into the appended bytes are examined again.
+
+    The delimiter may span the boundaries between the buffers
+    of the sequence.
+*/
+template<class ConstBufferSequence>
+std::size_t
+find_delimiter(ConstBufferSequence const& buffers,
+    std::size_t& pos, boost::string_ref const& delim)
+{
+    using boost::asio::buffer_cast;
+    using boost::asio::buffer_size;
+    auto const k = delim.size();
+    BOOST_ASSERT(k > 0);
+    // offset of the current buffer in the sequence
+    std::size_t base = 0;
+    auto const end = buffers.end();
+    for(auto it = buffers.begin(); it != end; ++it)
+    {
+        boost::asio::const_buffer const b = *it;
+        auto const p = buffer_cast<char const*>(b);
+        auto const n = buffer_size(b);
+        if(base + n > pos)
+        {
+            auto const start = pos > base ? pos - base : 0;
+            // Matches lying entirely within this buffer
+            auto const m = find_delimiter(
+                p + start, p + n, delim.data(), k);
+            if(m)
+                return base + (m - p) + k;
+            // Matches beginning in this buffer which
+            // continue into the following buffers
+            auto i = n >= k ? n - (k - 1) : 0;
+            if(i < start)
+                i = start;
+            for(; i < n; ++i)
+                if(match_delimiter(it, end, i, delim))
+                    return base + i + k;
+        }
+        base += n;
+    }
+    if(base >= k && base - (k - 1) > pos)
+        pos = base - (k - 1);
+    return 0;
+}
+
+} // detail
+} // beast
+
+#endif
@@ -0,0 +1,110 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_DETAIL_MIRRORED_MEMORY_HPP
+#define BEAST_DETAIL_MIRRORED_MEMORY_HPP
+
+#include <cstddef>
+
+#ifndef BEAST_NO_MIRRORED_MEMORY
+# if defined(__linux__)
+#  include <sys/syscall.h>
+#  if defined(SYS_memfd_create)
+#   define BEAST_DETAIL_MIRRORED_MEMORY 1
+#   include <sys/mman.h>
+#   include <sys/types.h>
+#   include <unistd.h>
+#  endif
+# endif
+#endif
+
+namespace beast {
+namespace detail {
+
+// Returns the granularity of a mirrored mapping
+inline
+std::size_t
+mirror_granularity()
+{
+#if BEAST_DETAIL_MIRRORED_MEMORY
+    static std::size_t const n =
+        static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    return n;
+#else
+    return 4096;
+#endif
+}
+
+/*  Map the same `size` bytes of memory twice, back to back.
+
+    The byte at offset `i` and the byte at offset `i + size` are
+    the same byte, so any range of up to `size` bytes starting
+    inside the first view is contiguous. `size` must be a multiple
+    of mirror_granularity().
+
+    Returns nullptr if the platform does not support it, or if
+    the mapping could not be established.
+*/
+inline
+void*
+map_mirrored(std::size_t size)
+{
+#if BEAST_DETAIL_MIRRORED_MEMORY
+    auto const fd = static_cast<int>(
+        ::syscall(SYS_memfd_create, "beast.mirror", 0));
+    if(fd < 0)
+        return nullptr;
+    if(::ftruncate(fd, static_cast<off_t>(size)) != 0)
+    {
+        ::close(fd);
+        return nullptr;
+    }
+    // Reserve the address space for both views,
+    // then map the memory file over each half.
+    auto const p = ::mmap(nullptr, 2 * size,
+        PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if(p == MAP_FAILED)
+    {
+        ::close(fd);
+        return nullptr;
+    }
+    auto const base = static_cast<char*>(p);
+    if(::mmap(base, size, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+        ::mmap(base + size, size, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+    {
+        ::munmap(base, 2 * size);
+        ::close(fd);
+        return nullptr;
+    }
+    // The mappings remain valid after the descriptor is closed
+    ::close(fd);
+    return base;
+#else
+    (void)size;
+    return nullptr;
+#endif
+}
+
+// Release memory returned by map_mirrored
+inline
+void
+unmap_mirrored(void* p, std::size_t size)
+{
+#if BEAST_DETAIL_MIRRORED_MEMORY
+    ::munmap(p, 2 * size);
+#else
+    (void)p;
+    (void)size;
+#endif
+}
+
+} // detail
+} // beast
+
+#endif
@@ -0,0 +1,49 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_CORE_DETAIL_READ_SIZE_HPP
+#define BEAST_CORE_DETAIL_READ_SIZE_HPP
+
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+
+namespace beast {
+namespace detail {
+
+/*  Returns the number of bytes to prepare for a read.
+
+    This implements read_size_helper for a stream buffer
+    with a single allocation which grows to at least
+    `min_alloc` bytes, doubling its capacity each time.
+*/
+template<class Streambuf>
+std::size_t
+read_size(Streambuf const& streambuf,
+    std::size_t max_size, std::size_t min_alloc)
+{
+    BOOST_ASSERT(max_size >= 1);
+    auto const limit =
+        streambuf.max_size() - streambuf.size();
+    // Let prepare report the overflow
+    if(limit == 0)
+        return 1;
+    // If there is free space, fill that up first
+    auto const avail =
+        streambuf.capacity() - streambuf.size();
+    if(avail > 0)
+        return (std::min)({avail, max_size, limit});
+    // Otherwise ask for as much as the next growth will provide
+    return (std::min)({max_size, limit,
+        (std::max)(streambuf.capacity(), min_alloc)});
+}
+
+} // detail
+} // beast
+
+#endif
@@ -0,0 +1,209 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_DETAIL_WRITE_CACHED_HPP
+#define BEAST_DETAIL_WRITE_CACHED_HPP
+
+#include <beast/core/buffer_sequence_cache.hpp>
+#include <beast/core/error.hpp>
+#include <beast/core/handler_alloc.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/handler_alloc_hook.hpp>
+#include <boost/asio/handler_continuation_hook.hpp>
+#include <boost/asio/handler_invoke_hook.hpp>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace beast {
+namespace detail {
+
+/*  Write all of a buffer sequence, like boost::asio::write.
+
+    The sequence is flattened once into a buffer_sequence_cache,
+    so each call to write_some after a partial write sees an array
+    instead of walking the original sequence from its beginning.
+*/
+template<class SyncWriteStream, class ConstBufferSequence>
+std::size_t
+write_cached(SyncWriteStream& stream,
+    ConstBufferSequence const& buffers, error_code& ec)
+{
+    buffer_sequence_cache<ConstBufferSequence> cb(buffers);
+    std::size_t total = 0;
+    ec = {};
+    while(! cb.empty())
+    {
+        auto const n = stream.write_some(cb, ec);
+        if(ec)
+            break;
+        cb.consume(n);
+        total += n;
+    }
+    return total;
+}
+
+/*  A trivially copyable view of a range of buffers.
+
+    Asio copies and moves the buffer sequence given to async_write_some
+    several times for each call, so the stream is given this instead of
+    the cache itself, whose copies walk the wrapped sequence again.
+    The buffer type is a template parameter so that, as with the
+    sequences asio passes, `buffer_size` is found by argument
+    dependent lookup.
+*/
+template<class Buffer>
+class buffer_range
+{
+    Buffer const* begin_;
+    Buffer const* end_;
+
+public:
+    using value_type = Buffer;
+    using const_iterator = value_type const*;
+
+    buffer_range(const_iterator begin, const_iterator end)
+        : begin_(begin)
+        , end_(end)
+    {
+    }
+
+    const_iterator
+    begin() const
+    {
+        return begin_;
+    }
+
+    const_iterator
+    end() const
+    {
+        return end_;
+    }
+};
+
+/*  The cache is kept in state allocated through the handler,
+    so the sequence is flattened once and never moved while
+    the operation is in progress.
+*/
+template<class Stream, class ConstBufferSequence, class Handler>
+class write_cached_op
+{
+    using alloc_type =
+        handler_alloc<char, Handler>;
+
+    struct data
+    {
+        Stream& s;
+        buffer_sequence_cache<ConstBufferSequence> cb;
+        Handler h;
+        std::size_t total = 0;
+        bool cont;
+
+        template<class DeducedHandler>
+        data(DeducedHandler&& h_, Stream& s_,
+                ConstBufferSequence const& buffers)
+            : s(s_)
+            , cb(buffers)
+            , h(std::forward<DeducedHandler>(h_))
+            , cont(boost_asio_handler_cont_helpers::
+                is_continuation(h))
+        {
+        }
+    };
+
+    std::shared_ptr<data> d_;
+
+    void
+    write_some()
+    {
+        auto& d = *d_;
+        d.s.async_write_some(buffer_range<
+            boost::asio::const_buffer>{d.cb.begin(),
+                d.cb.end()}, std::move(*this));
+    }
+
+public:
+    write_cached_op(write_cached_op&&) = default;
+    write_cached_op(write_cached_op const&) = default;
+
+    template<class DeducedHandler>
+    write_cached_op(DeducedHandler&& h, Stream& s,
+            ConstBufferSequence const& buffers)
+        : d_(std::allocate_shared<data>(alloc_type{h},
+            std::forward<DeducedHandler>(h), s, buffers))
+    {
+        // Like boost::asio::async_write, always perform at
+        // least one write so the handler is not invoked
+        // from within the initiating function.
+        write_some();
+    }
+
+    void
+    operator()(error_code const& ec,
+        std::size_t bytes_transferred)
+    {
+        auto& d = *d_;
+        d.cont = true;
+        d.cb.consume(bytes_transferred);
+        d.total += bytes_transferred;
+        if(! ec && bytes_transferred > 0 && ! d.cb.empty())
+            return write_some();
+        d.h(ec, d.total);
+    }
+
+    friend
+    void* asio_handler_allocate(
+        std::size_t size, write_cached_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            allocate(size, op->d_->h);
+    }
+
+    friend
+    void asio_handler_deallocate(
+        void* p, std::size_t size, write_cached_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            deallocate(p, size, op->d_->h);
+    }
+
+    friend
+    bool asio_handler_is_continuation(write_cached_op* op)
+    {
+        return op->d_->cont;
+    }
+
+    template<class Function>
+    friend
+    void asio_handler_invoke(Function&& f, write_cached_op* op)
+    {
+        return boost_asio_handler_invoke_helpers::
+            invoke(f, op->d_->h);
+    }
+};
+
+/*  Write all of a buffer sequence, like boost::asio::async_write.
+
+    The handler is invoked with the signature
+    void(error_code, std::size_t), and must not be
+    a completion token: this is for composed operations.
+*/
+template<class AsyncWriteStream,
+    class ConstBufferSequence, class WriteHandler>
+void
+async_write_cached(AsyncWriteStream& stream,
+    ConstBufferSequence const& buffers, WriteHandler&& handler)
+{
+    write_cached_op<AsyncWriteStream, ConstBufferSequence,
+        typename std::decay<WriteHandler>::type>{
+            std::forward<WriteHandler>(handler), stream, buffers};
+}
+
+} // detail
+} // beast
+
+#endif
@@ -11,6 +11,7 @@
 #include <beast/core/async_completion.hpp>
 #include <beast/core/buffer_concepts.hpp>
 #include <beast/core/error.hpp>
+#include <beast/core/flat_streambuf.hpp>
 #include <beast/core/stream_concepts.hpp>
 #include <beast/core/streambuf.hpp>
 #include <beast/core/detail/get_lowest_layer.hpp>
@@ -30,7 +31,7 @@ namespace beast {
 
     The use-case for this class is different than that of the
     `boost::asio::buffered_readstream`. It is designed to facilitate
-    the use of `boost::asio::read_until`, and to allow buffers
+    the use of @ref read_until, and to allow buffers
     acquired during detection of handshakes to be made transparently
     available to callers. A hypothetical implementation of the
     buffered version of `boost::asio::ssl::stream::async_handshake`
@@ -39,7 +40,7 @@ namespace beast {
     Uses:
 
     @li Transparently leave untouched input acquired in calls
-      to `boost::asio::read_until` behind for subsequent callers.
+      to @ref read_until behind for subsequent callers.
 
     @li "Preload" a stream with handshake input data acquired
       from other sources.
@@ -60,8 +61,8 @@ namespace beast {
         // part up to the end of the delimiter.
         //
         std::size_t bytes_transferred =
-            boost::asio::read_until(
-                stream.next_layer(), stream.buffer(), "\r\n\r\n");
+            read_until(stream.next_layer(),
+                stream.buffer(), "\r\n\r\n");
 
         // Use prepare_buffers() to limit the input
         // sequence to only the data up to and including
@@ -84,9 +85,11 @@ namespace beast {
 
     @tparam Stream The type of stream to wrap.
 
-    @tparam DynamicBuffer The type of stream buffer to use.
+    @tparam DynamicBuffer The type of stream buffer to use. The
+    default, @ref flat_streambuf, keeps the buffered input in one
+    contiguous region.
 */
-template<class Stream, class DynamicBuffer>
+template<class Stream, class DynamicBuffer = flat_streambuf>
 class dynabuf_readstream
 {
     static_assert(is_DynamicBuffer<DynamicBuffer>::value,
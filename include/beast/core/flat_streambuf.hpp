@@ -0,0 +1,229 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_FLAT_STREAMBUF_HPP
+#define BEAST_FLAT_STREAMBUF_HPP
+
+#include <beast/core/detail/empty_base_optimization.hpp>
+#include <boost/asio/buffer.hpp>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+namespace beast {
+
+/** A @b `DynamicBuffer` that uses a single contiguous buffer.
+
+    The input sequence is always a single buffer, so algorithms which
+    inspect it, such as a parser, never see data split across buffer
+    boundaries. When the output sequence does not fit at the end of
+    the storage, the input sequence is first moved to the beginning
+    with a single `memmove`. When that is not enough, the storage grows
+    geometrically, up to an optional maximum size.
+
+    Buffers returned by @ref data and @ref prepare are invalidated by
+    any subsequent call to @ref prepare or @ref consume.
+
+    @note Meets the requirements of @b DynamicBuffer.
+
+    @tparam Allocator The allocator to use for managing memory.
+*/
+template<class Allocator>
+class basic_flat_streambuf
+#if ! GENERATING_DOCS
+    : private detail::empty_base_optimization<
+        typename std::allocator_traits<Allocator>::
+            template rebind_alloc<std::uint8_t>>
+#endif
+{
+public:
+#if GENERATING_DOCS
+    /// The type of allocator used.
+    using allocator_type = Allocator;
+#else
+    using allocator_type = typename
+        std::allocator_traits<Allocator>::
+            template rebind_alloc<std::uint8_t>;
+#endif
+
+private:
+    using alloc_traits =
+        std::allocator_traits<allocator_type>;
+
+    // The smallest allocation
+    static std::size_t constexpr min_alloc = 512;
+
+    std::uint8_t* begin_ = nullptr;
+    std::uint8_t* in_ = nullptr;
+    std::uint8_t* out_ = nullptr;
+    std::uint8_t* last_ = nullptr;
+    std::uint8_t* end_ = nullptr;
+    std::size_t max_;
+
+public:
+    /// The type used to represent the input sequence as a list of buffers.
+    using const_buffers_type = boost::asio::const_buffers_1;
+
+    /// The type used to represent the output sequence as a list of buffers.
+    using mutable_buffers_type = boost::asio::mutable_buffers_1;
+
+    /// Destructor.
+    ~basic_flat_streambuf();
+
+    /** Move constructor.
+
+        The new object will have the input sequence of
+        the other stream buffer, and an empty output sequence.
+
+        @note After the move, the moved-from object will have
+        an empty input and output sequence, with no internal
+        buffers allocated.
+    */
+    basic_flat_streambuf(basic_flat_streambuf&&);
+
+    /** Move assignment.
+
+        This object will have the input sequence of
+        the other stream buffer, and an empty output sequence.
+
+        @note After the move, the moved-from object will have
+        an empty input and output sequence, with no internal
+        buffers allocated.
+    */
+    basic_flat_streambuf&
+    operator=(basic_flat_streambuf&&);
+
+    /** Copy constructor.
+
+        This object will have a copy of the other stream
+        buffer's input sequence, and an empty output sequence.
+    */
+    basic_flat_streambuf(basic_flat_streambuf const&);
+
+    /** Copy assignment.
+
+        This object will have a copy of the other stream
+        buffer's input sequence, and an empty output sequence.
+    */
+    basic_flat_streambuf&
+    operator=(basic_flat_streambuf const&);
+
+    /** Construct a stream buffer.
+
+        No memory is allocated until the first call to @ref prepare.
+
+        @param limit The largest permitted sum of the sizes of the
+        input and output sequences. Calls to @ref prepare which
+        would exceed this limit throw `std::length_error`.
+
+        @param alloc The allocator to use. If this parameter is
+        unspecified, a default constructed allocator will be used.
+    */
+    explicit
+    basic_flat_streambuf(std::size_t limit =
+        (std::numeric_limits<std::size_t>::max)(),
+            Allocator const& alloc = allocator_type{});
+
+    /// Returns a copy of the associated allocator.
+    allocator_type
+    get_allocator() const
+    {
+        return this->member();
+    }
+
+    /// Returns the size of the input sequence.
+    std::size_t
+    size() const
+    {
+        return out_ - in_;
+    }
+
+    /// Returns the permitted maximum sum of the sizes of the input and output sequence.
+    std::size_t
+    max_size() const
+    {
+        return max_;
+    }
+
+    /// Returns the maximum sum of the sizes of the input sequence and output sequence the buffer can hold without requiring reallocation.
+    std::size_t
+    capacity() const
+    {
+        return end_ - begin_;
+    }
+
+    /// Get a list of buffers that represents the input sequence.
+    const_buffers_type
+    data() const
+    {
+        return {in_, size()};
+    }
+
+    /** Get a list of buffers that represents the output sequence, with the given size.
+
+        @throws std::length_error if `size() + n` exceeds `max_size()`.
+    */
+    mutable_buffers_type
+    prepare(std::size_t n);
+
+    /// Move bytes from the output sequence to the input sequence.
+    void
+    commit(std::size_t n)
+    {
+        out_ += (std::min<std::size_t>)(n, last_ - out_);
+    }
+
+    /// Remove bytes from the input sequence.
+    void
+    consume(std::size_t n);
+
+    // Helper for boost::asio::read_until
+    template<class OtherAllocator>
+    friend
+    std::size_t
+    read_size_helper(basic_flat_streambuf<
+        OtherAllocator> const& streambuf, std::size_t max_size);
+
+private:
+    void
+    move_from(basic_flat_streambuf& other);
+
+    void
+    copy_from(basic_flat_streambuf const& other);
+
+    void
+    release();
+};
+
+/** A @b `DynamicBuffer` that uses a single contiguous buffer.
+
+    This is the default read buffer used by @ref dynabuf_readstream
+    and by `websocket::stream`.
+
+    @see basic_flat_streambuf
+*/
+using flat_streambuf =
+    basic_flat_streambuf<std::allocator<char>>;
+
+/** Format output to a @ref basic_flat_streambuf.
+
+    @param streambuf The @ref basic_flat_streambuf to write to.
+
+    @param t The object to write.
+
+    @return A reference to the @ref basic_flat_streambuf.
+*/
+template<class Allocator, class T>
+basic_flat_streambuf<Allocator>&
+operator<<(basic_flat_streambuf<Allocator>& streambuf, T const& t);
+
+} // beast
+
+#include <beast/core/impl/flat_streambuf.ipp>
+
+#endif
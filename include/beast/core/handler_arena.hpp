@@ -0,0 +1,165 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HANDLER_ARENA_HPP
+#define BEAST_HANDLER_ARENA_HPP
+
+#include <beast/core/detail/arena_handler.hpp>
+#include <cstddef>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace beast {
+
+/** Reusable memory for the intermediate storage of handlers.
+
+    Every asynchronous operation allocates storage for its state, and
+    for each intermediate operation it starts, through the allocation
+    hooks of its completion handler. Unless the handler customizes
+    `asio_handler_allocate`, each of these is a call to the global
+    `operator new`, once per read and once per write.
+
+    A handler arena holds a small number of slots of memory. Memory
+    obtained from the arena is returned to its slot when deallocated,
+    and the slot is reused by later allocations of the same size or
+    smaller. A connection which repeatedly performs the same kinds of
+    operations, such as reading and writing messages on a keep-alive
+    connection, quickly reaches a state where every allocation is
+    satisfied from a slot, and no calls to the global allocator are
+    made.
+
+    To use the arena, wrap the completion handlers of the operations
+    on a connection with @ref bind_arena. The composed operations in
+    this library allocate their state using @ref handler_alloc, which
+    calls the hooks of the wrapped handler, so they obtain their memory
+    from the arena without further changes. An HTTP write also
+    serializes the message header into a buffer of its own; pass the
+    same @ref http::header_buffer to each call to @ref http::async_write
+    to reuse that storage as well.
+
+    Typically one arena is used per connection, with the same lifetime
+    as the connection's socket. The arena must outlive every handler
+    bound to it.
+
+    @par Thread Safety
+    @e Distinct @e objects: Safe.@n
+    @e Shared @e objects: Safe.
+*/
+class handler_arena
+{
+public:
+    /// The largest number of slots in the arena.
+    static std::size_t constexpr max_slots = 8;
+
+private:
+    struct slot
+    {
+        void* p = nullptr;
+        std::size_t size = 0;
+        bool used = false;
+    };
+
+    std::mutex m_;
+    slot v_[max_slots];
+    std::size_t n_ = 0;
+    std::size_t heap_ = 0;
+
+public:
+    /// Default constructor.
+    handler_arena() = default;
+
+    /// Destructor.
+    ~handler_arena();
+
+    /// Copy constructor (deleted).
+    handler_arena(handler_arena const&) = delete;
+
+    /// Copy assignment (deleted).
+    handler_arena& operator=(handler_arena const&) = delete;
+
+    /** Allocate memory.
+
+        A free slot large enough to hold `size` bytes is reused if
+        one exists. Otherwise, the memory of a slot is obtained from
+        the global allocator. When every slot is in use, the memory
+        is obtained from the global allocator, and is not retained
+        when deallocated.
+
+        @throws std::bad_alloc if the storage cannot be obtained.
+    */
+    void*
+    allocate(std::size_t size);
+
+    /// Deallocate memory obtained from `allocate`.
+    void
+    deallocate(void* p, std::size_t size);
+
+    /** Returns the number of allocations made from the global allocator.
+
+        This count does not change once each kind of operation
+        performed with the arena has been performed once.
+    */
+    std::size_t
+    heap_allocations()
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        return heap_;
+    }
+};
+
+/** Bind a completion handler to a handler arena.
+
+    This function returns a new handler which, when invoked, calls
+    the original handler with the same arguments. Memory allocated
+    through the `asio_handler_allocate` hook of the returned handler,
+    such as the state of a composed operation and of the intermediate
+    operations it starts, is obtained from the arena. The returned
+    handler provides the same `io_service` execution guarantees as the
+    original handler.
+
+    Example:
+    @code
+    template<class Stream, class DynamicBuffer>
+    void
+    do_read(Stream& stream, DynamicBuffer& db,
+        http::response<http::string_body>& res,
+            handler_arena& arena)
+    {
+        http::async_read(stream, db, res, bind_arena(arena,
+            [&](error_code const& ec)
+            {
+                // ...
+            }));
+    }
+    @endcode
+
+    @param arena The arena to use. It must remain valid until
+    every copy of the returned handler is destroyed.
+
+    @param handler The handler to wrap. It is moved or copied
+    into the returned handler.
+*/
+template<class Handler>
+#if GENERATING_DOCS
+implementation_defined
+#else
+detail::arena_handler<handler_arena,
+    typename std::decay<Handler>::type>
+#endif
+bind_arena(handler_arena& arena, Handler&& handler)
+{
+    return detail::arena_handler<handler_arena,
+        typename std::decay<Handler>::type>(
+            arena, std::forward<Handler>(handler));
+}
+
+} // beast
+
+#include <beast/core/impl/handler_arena.ipp>
+
+#endif
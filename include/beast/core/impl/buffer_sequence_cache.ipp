@@ -0,0 +1,124 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_BUFFER_SEQUENCE_CACHE_IPP
+#define BEAST_IMPL_BUFFER_SEQUENCE_CACHE_IPP
+
+#include <iterator>
+#include <utility>
+
+namespace beast {
+
+// The buffers in v_ may point into the storage of bs_, for
+// example when it holds a chunk header. So a copied or moved
+// adapter loads its own sequence again, instead of copying v_.
+
+template<class ConstBufferSequence, std::size_t N>
+buffer_sequence_cache<ConstBufferSequence, N>::
+buffer_sequence_cache(buffer_sequence_cache&& other)
+    : bs_(std::move(other.bs_))
+{
+    reset(other.consumed_);
+}
+
+template<class ConstBufferSequence, std::size_t N>
+buffer_sequence_cache<ConstBufferSequence, N>::
+buffer_sequence_cache(buffer_sequence_cache const& other)
+    : bs_(other.bs_)
+{
+    reset(other.consumed_);
+}
+
+template<class ConstBufferSequence, std::size_t N>
+auto
+buffer_sequence_cache<ConstBufferSequence, N>::
+operator=(buffer_sequence_cache&& other) ->
+    buffer_sequence_cache&
+{
+    if(this == &other)
+        return *this;
+    bs_ = std::move(other.bs_);
+    reset(other.consumed_);
+    return *this;
+}
+
+template<class ConstBufferSequence, std::size_t N>
+auto
+buffer_sequence_cache<ConstBufferSequence, N>::
+operator=(buffer_sequence_cache const& other) ->
+    buffer_sequence_cache&
+{
+    if(this == &other)
+        return *this;
+    bs_ = other.bs_;
+    reset(other.consumed_);
+    return *this;
+}
+
+template<class ConstBufferSequence, std::size_t N>
+buffer_sequence_cache<ConstBufferSequence, N>::
+buffer_sequence_cache(ConstBufferSequence const& buffers)
+    : bs_(buffers)
+{
+    fill();
+}
+
+template<class ConstBufferSequence, std::size_t N>
+void
+buffer_sequence_cache<ConstBufferSequence, N>::
+consume(std::size_t n)
+{
+    using boost::asio::buffer_size;
+    while(n > 0 && first_ != last_)
+    {
+        auto const len = buffer_size(v_[first_]);
+        if(n < len)
+        {
+            v_[first_] = v_[first_] + n;
+            consumed_ += n;
+            break;
+        }
+        n -= len;
+        consumed_ += len;
+        if(++first_ == last_ && more_)
+            fill();
+    }
+}
+
+template<class ConstBufferSequence, std::size_t N>
+void
+buffer_sequence_cache<ConstBufferSequence, N>::
+reset(std::size_t consumed)
+{
+    next_ = 0;
+    consumed_ = 0;
+    fill();
+    consume(consumed);
+}
+
+template<class ConstBufferSequence, std::size_t N>
+void
+buffer_sequence_cache<ConstBufferSequence, N>::
+fill()
+{
+    using boost::asio::buffer_size;
+    auto it = std::next(bs_.begin(), next_);
+    auto const end = bs_.end();
+    first_ = 0;
+    last_ = 0;
+    for(; it != end && last_ < N; ++it, ++next_)
+    {
+        boost::asio::const_buffer const b = *it;
+        if(buffer_size(b) > 0)
+            v_[last_++] = b;
+    }
+    more_ = it != end;
+}
+
+} // beast
+
+#endif
@@ -0,0 +1,250 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_FLAT_STREAMBUF_IPP
+#define BEAST_IMPL_FLAT_STREAMBUF_IPP
+
+#include <beast/core/detail/read_size.hpp>
+#include <beast/core/detail/write_dynabuf.hpp>
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+namespace beast {
+
+/*  Layout of the storage:
+
+    begin_      in_         out_        last_       end_
+    |<--------->|<--------->|<--------->|<--------->|
+     consumed      input       output      free
+
+    The input sequence is [in_, out_), and the output sequence
+    returned by the last call to prepare is [out_, last_).
+*/
+
+template<class Allocator>
+std::size_t constexpr
+basic_flat_streambuf<Allocator>::min_alloc;
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+~basic_flat_streambuf()
+{
+    release();
+}
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+basic_flat_streambuf(basic_flat_streambuf&& other)
+    : detail::empty_base_optimization<allocator_type>(
+        std::move(other.member()))
+    , max_(other.max_)
+{
+    move_from(other);
+}
+
+template<class Allocator>
+auto
+basic_flat_streambuf<Allocator>::
+operator=(basic_flat_streambuf&& other) ->
+    basic_flat_streambuf&
+{
+    if(this == &other)
+        return *this;
+    max_ = other.max_;
+    if(alloc_traits::propagate_on_container_move_assignment::value)
+    {
+        release();
+        this->member() = std::move(other.member());
+        move_from(other);
+    }
+    else if(this->member() == other.member())
+    {
+        release();
+        move_from(other);
+    }
+    else
+    {
+        copy_from(other);
+        other.release();
+    }
+    return *this;
+}
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+basic_flat_streambuf(basic_flat_streambuf const& other)
+    : detail::empty_base_optimization<allocator_type>(
+        alloc_traits::select_on_container_copy_construction(
+            other.member()))
+    , max_(other.max_)
+{
+    copy_from(other);
+}
+
+template<class Allocator>
+auto
+basic_flat_streambuf<Allocator>::
+operator=(basic_flat_streambuf const& other) ->
+    basic_flat_streambuf&
+{
+    if(this == &other)
+        return *this;
+    if(alloc_traits::propagate_on_container_copy_assignment::value &&
+        this->member() != other.member())
+    {
+        release();
+        this->member() = other.member();
+    }
+    max_ = other.max_;
+    copy_from(other);
+    return *this;
+}
+
+template<class Allocator>
+basic_flat_streambuf<Allocator>::
+basic_flat_streambuf(std::size_t limit,
+        Allocator const& alloc)
+    : detail::empty_base_optimization<allocator_type>(alloc)
+    , max_(limit)
+{
+}
+
+template<class Allocator>
+auto
+basic_flat_streambuf<Allocator>::
+prepare(std::size_t n) ->
+    mutable_buffers_type
+{
+    if(n <= static_cast<std::size_t>(end_ - out_))
+    {
+        // fits after the input
+        last_ = out_ + n;
+        return {out_, n};
+    }
+    auto const len = size();
+    if(n > max_ - len)
+        throw std::length_error{
+            "flat_streambuf overflow"};
+    if(n <= capacity() - len)
+    {
+        // fits after moving the input to the front
+        if(len > 0)
+            std::memmove(begin_, in_, len);
+        in_ = begin_;
+        out_ = in_ + len;
+        last_ = out_ + n;
+        return {out_, n};
+    }
+    // grow geometrically
+    auto alloc_size = capacity() <= max_ / 2 ?
+        2 * capacity() : max_;
+    alloc_size = (std::max)(alloc_size, len + n);
+    alloc_size = (std::max)(alloc_size, (std::min)(max_, min_alloc));
+    auto const p = alloc_traits::allocate(this->member(), alloc_size);
+    if(len > 0)
+        std::memcpy(p, in_, len);
+    release();
+    begin_ = p;
+    in_ = p;
+    out_ = in_ + len;
+    last_ = out_ + n;
+    end_ = begin_ + alloc_size;
+    return {out_, n};
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+consume(std::size_t n)
+{
+    if(n >= size())
+    {
+        // Start over at the front, which avoids
+        // moving anything on the next prepare.
+        in_ = begin_;
+        out_ = begin_;
+        last_ = begin_;
+        return;
+    }
+    in_ += n;
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+move_from(basic_flat_streambuf& other)
+{
+    begin_ = other.begin_;
+    in_ = other.in_;
+    out_ = other.out_;
+    last_ = other.out_;
+    end_ = other.end_;
+    other.begin_ = nullptr;
+    other.in_ = nullptr;
+    other.out_ = nullptr;
+    other.last_ = nullptr;
+    other.end_ = nullptr;
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+copy_from(basic_flat_streambuf const& other)
+{
+    auto const n = other.size();
+    if(capacity() < n)
+    {
+        release();
+        begin_ = alloc_traits::allocate(this->member(), n);
+        end_ = begin_ + n;
+    }
+    if(n > 0)
+        std::memcpy(begin_, other.in_, n);
+    in_ = begin_;
+    out_ = begin_ + n;
+    last_ = out_;
+}
+
+template<class Allocator>
+void
+basic_flat_streambuf<Allocator>::
+release()
+{
+    if(begin_)
+        alloc_traits::deallocate(
+            this->member(), begin_, capacity());
+    begin_ = nullptr;
+    in_ = nullptr;
+    out_ = nullptr;
+    last_ = nullptr;
+    end_ = nullptr;
+}
+
+template<class Allocator>
+std::size_t
+read_size_helper(basic_flat_streambuf<
+    Allocator> const& streambuf, std::size_t max_size)
+{
+    return detail::read_size(streambuf, max_size,
+        basic_flat_streambuf<Allocator>::min_alloc);
+}
+
+template<class Allocator, class T>
+basic_flat_streambuf<Allocator>&
+operator<<(basic_flat_streambuf<Allocator>& streambuf, T const& t)
+{
+    detail::write_dynabuf(streambuf, t);
+    return streambuf;
+}
+
+} // beast
+
+#endif
@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_HANDLER_ARENA_IPP
+#define BEAST_IMPL_HANDLER_ARENA_IPP
+
+#include <boost/assert.hpp>
+#include <new>
+
+namespace beast {
+
+inline
+handler_arena::
+~handler_arena()
+{
+    for(std::size_t i = 0; i < n_; ++i)
+    {
+        BOOST_ASSERT(! v_[i].used);
+        ::operator delete(v_[i].p);
+    }
+}
+
+inline
+void*
+handler_arena::
+allocate(std::size_t size)
+{
+    // Round up so that slightly different
+    // sizes can share the same slot.
+    std::size_t const align = 64;
+    if(size > (std::size_t(-1) & ~(align - 1)))
+        throw std::bad_alloc{};
+    size = (size + align - 1) & ~(align - 1);
+    std::lock_guard<std::mutex> lock(m_);
+    // Prefer the smallest free slot which fits,
+    // otherwise grow the largest free slot.
+    slot* fit = nullptr;
+    slot* grow = nullptr;
+    for(std::size_t i = 0; i < n_; ++i)
+    {
+        auto& s = v_[i];
+        if(s.used)
+            continue;
+        if(s.size >= size)
+        {
+            if(! fit || s.size < fit->size)
+                fit = &s;
+        }
+        else if(! grow || s.size > grow->size)
+        {
+            grow = &s;
+        }
+    }
+    if(! fit)
+    {
+        if(grow)
+        {
+            fit = grow;
+            ::operator delete(fit->p);
+            fit->p = nullptr;
+            fit->size = 0;
+        }
+        else if(n_ < max_slots)
+        {
+            fit = &v_[n_++];
+        }
+        else
+        {
+            ++heap_;
+            return ::operator new(size);
+        }
+        ++heap_;
+        fit->p = ::operator new(size);
+        fit->size = size;
+    }
+    fit->used = true;
+    return fit->p;
+}
+
+inline
+void
+handler_arena::
+deallocate(void* p, std::size_t)
+{
+    std::lock_guard<std::mutex> lock(m_);
+    for(std::size_t i = 0; i < n_; ++i)
+    {
+        auto& s = v_[i];
+        if(s.p == p)
+        {
+            BOOST_ASSERT(s.used);
+            s.used = false;
+            return;
+        }
+    }
+    ::operator delete(p);
+}
+
+} // beast
+
+#endif
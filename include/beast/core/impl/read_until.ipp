@@ -0,0 +1,238 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_READ_UNTIL_IPP
+#define BEAST_IMPL_READ_UNTIL_IPP
+
+#include <beast/core/bind_handler.hpp>
+#include <beast/core/buffer_concepts.hpp>
+#include <beast/core/handler_alloc.hpp>
+#include <beast/core/handler_concepts.hpp>
+#include <beast/core/stream_concepts.hpp>
+#include <beast/core/detail/find_delimiter.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/handler_alloc_hook.hpp>
+#include <boost/asio/handler_continuation_hook.hpp>
+#include <boost/asio/handler_invoke_hook.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace beast {
+
+namespace detail {
+
+template<class Stream, class DynamicBuffer, class Handler>
+class read_until_op
+{
+    using alloc_type =
+        handler_alloc<char, Handler>;
+
+    struct data
+    {
+        Stream& s;
+        DynamicBuffer& db;
+        std::string delim;
+        Handler h;
+        std::size_t pos = 0;
+        bool cont;
+        int state = 0;
+
+        template<class DeducedHandler>
+        data(DeducedHandler&& h_, Stream& s_,
+                DynamicBuffer& db_, boost::string_ref const& delim_)
+            : s(s_)
+            , db(db_)
+            , delim(delim_.data(), delim_.size())
+            , h(std::forward<DeducedHandler>(h_))
+            , cont(boost_asio_handler_cont_helpers::
+                is_continuation(h))
+        {
+        }
+    };
+
+    std::shared_ptr<data> d_;
+
+public:
+    read_until_op(read_until_op&&) = default;
+    read_until_op(read_until_op const&) = default;
+
+    template<class DeducedHandler, class... Args>
+    read_until_op(DeducedHandler&& h, Stream& s, Args&&... args)
+        : d_(std::allocate_shared<data>(alloc_type{h},
+            std::forward<DeducedHandler>(h), s,
+                std::forward<Args>(args)...))
+    {
+        (*this)(error_code{}, 0, false);
+    }
+
+    void
+    operator()(error_code ec,
+        std::size_t bytes_transferred, bool again = true);
+
+    friend
+    void* asio_handler_allocate(
+        std::size_t size, read_until_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            allocate(size, op->d_->h);
+    }
+
+    friend
+    void asio_handler_deallocate(
+        void* p, std::size_t size, read_until_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            deallocate(p, size, op->d_->h);
+    }
+
+    friend
+    bool asio_handler_is_continuation(read_until_op* op)
+    {
+        return op->d_->cont;
+    }
+
+    template<class Function>
+    friend
+    void asio_handler_invoke(Function&& f, read_until_op* op)
+    {
+        return boost_asio_handler_invoke_helpers::
+            invoke(f, op->d_->h);
+    }
+};
+
+template<class Stream, class DynamicBuffer, class Handler>
+void
+read_until_op<Stream, DynamicBuffer, Handler>::
+operator()(error_code ec, std::size_t bytes_transferred, bool again)
+{
+    auto& d = *d_;
+    d.cont = d.cont || again;
+    switch(d.state)
+    {
+    case 0:
+        break;
+
+    // completed without reading
+    case 1:
+        d.h(ec, bytes_transferred);
+        return;
+
+    // got data
+    case 2:
+        // Data received along with an error
+        // remains in the buffer for the caller.
+        d.db.commit(bytes_transferred);
+        if(ec)
+        {
+            d.h(ec, 0);
+            return;
+        }
+        break;
+    }
+    std::size_t n = 0;
+    if(d.delim.empty() || (n = find_delimiter(
+        d.db.data(), d.pos, d.delim)) > 0)
+    {
+        ec = {};
+    }
+    else if(d.db.size() >= d.db.max_size())
+    {
+        ec = boost::asio::error::not_found;
+    }
+    else
+    {
+        d.state = 2;
+        d.s.async_read_some(d.db.prepare(
+            read_size_helper(d.db, 65536)),
+                std::move(*this));
+        return;
+    }
+    if(d.state == 0)
+    {
+        d.state = 1;
+        d.s.get_io_service().post(
+            bind_handler(std::move(*this), ec, n));
+        return;
+    }
+    d.h(ec, n);
+}
+
+} // detail
+
+//------------------------------------------------------------------------------
+
+template<class SyncReadStream, class DynamicBuffer>
+std::size_t
+read_until(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    boost::string_ref const& delim)
+{
+    static_assert(is_SyncReadStream<SyncReadStream>::value,
+        "SyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    error_code ec;
+    auto const n = read_until(stream, dynabuf, delim, ec);
+    if(ec)
+        throw system_error{ec};
+    return n;
+}
+
+template<class SyncReadStream, class DynamicBuffer>
+std::size_t
+read_until(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    boost::string_ref const& delim, error_code& ec)
+{
+    static_assert(is_SyncReadStream<SyncReadStream>::value,
+        "SyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    ec = {};
+    if(delim.empty())
+        return 0;
+    std::size_t pos = 0;
+    for(;;)
+    {
+        auto const n = detail::find_delimiter(
+            dynabuf.data(), pos, delim);
+        if(n > 0)
+            return n;
+        if(dynabuf.size() >= dynabuf.max_size())
+        {
+            ec = boost::asio::error::not_found;
+            return 0;
+        }
+        dynabuf.commit(stream.read_some(
+            dynabuf.prepare(read_size_helper(
+                dynabuf, 65536)), ec));
+        if(ec)
+            return 0;
+    }
+}
+
+template<class AsyncReadStream,
+    class DynamicBuffer, class ReadHandler>
+typename async_completion<ReadHandler,
+    void(error_code, std::size_t)>::result_type
+async_read_until(AsyncReadStream& stream, DynamicBuffer& dynabuf,
+    boost::string_ref const& delim, ReadHandler&& handler)
+{
+    static_assert(is_AsyncReadStream<AsyncReadStream>::value,
+        "AsyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    beast::async_completion<ReadHandler,
+        void(error_code, std::size_t)> completion(handler);
+    detail::read_until_op<AsyncReadStream, DynamicBuffer,
+        decltype(completion.handler)>{
+            completion.handler, stream, dynabuf, delim};
+    return completion.result.get();
+}
+
+} // beast
+
+#endif
@@ -0,0 +1,273 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_IMPL_RING_STREAMBUF_IPP
+#define BEAST_IMPL_RING_STREAMBUF_IPP
+
+#include <beast/core/detail/mirrored_memory.hpp>
+#include <beast/core/detail/read_size.hpp>
+#include <beast/core/detail/write_dynabuf.hpp>
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+
+namespace beast {
+
+/*  Layout of the storage:
+
+    The input sequence starts at in_pos_ and is in_size_ bytes
+    long, and the output sequence follows it, wrapping around
+    the end of the storage:
+
+    base_                                               base_ + cap_
+    |<-- output (tail) -->|<-- free -->|<-- input -->|<-- output -->|
+                                       in_pos_
+
+    When the storage is mirrored, base_[i + cap_] is the same
+    byte as base_[i], so neither sequence ever needs to be split.
+*/
+
+inline
+ring_streambuf::
+~ring_streambuf()
+{
+    release();
+}
+
+inline
+ring_streambuf::
+ring_streambuf(ring_streambuf&& other)
+    : max_(other.max_)
+{
+    move_from(other);
+}
+
+inline
+auto
+ring_streambuf::
+operator=(ring_streambuf&& other) ->
+    ring_streambuf&
+{
+    if(this == &other)
+        return *this;
+    release();
+    max_ = other.max_;
+    move_from(other);
+    return *this;
+}
+
+inline
+ring_streambuf::
+ring_streambuf(ring_streambuf const& other)
+    : max_(other.max_)
+{
+    copy_from(other);
+}
+
+inline
+auto
+ring_streambuf::
+operator=(ring_streambuf const& other) ->
+    ring_streambuf&
+{
+    if(this == &other)
+        return *this;
+    max_ = other.max_;
+    copy_from(other);
+    return *this;
+}
+
+inline
+ring_streambuf::
+ring_streambuf(std::size_t limit)
+    : max_(limit)
+{
+}
+
+inline
+auto
+ring_streambuf::
+data() const ->
+    const_buffers_type
+{
+    using boost::asio::const_buffer;
+    if(mirrored_ || in_pos_ + in_size_ <= cap_)
+        return {const_buffer{base_ + in_pos_, in_size_},
+            const_buffer{}};
+    auto const n = cap_ - in_pos_;
+    return {const_buffer{base_ + in_pos_, n},
+        const_buffer{base_, in_size_ - n}};
+}
+
+inline
+auto
+ring_streambuf::
+prepare(std::size_t n) ->
+    mutable_buffers_type
+{
+    using boost::asio::mutable_buffer;
+    // The capacity may exceed the limit, when the
+    // storage is rounded up for the mirrored mapping.
+    if(n > max_ - in_size_)
+        throw std::length_error{
+            "ring_streambuf overflow"};
+    if(n > cap_ - in_size_)
+        reallocate(n);
+    out_size_ = n;
+    auto pos = in_pos_ + in_size_;
+    if(pos >= cap_)
+        pos -= cap_;
+    if(mirrored_ || pos + n <= cap_)
+        return {mutable_buffer{base_ + pos, n},
+            mutable_buffer{}};
+    auto const n0 = cap_ - pos;
+    return {mutable_buffer{base_ + pos, n0},
+        mutable_buffer{base_, n - n0}};
+}
+
+inline
+void
+ring_streambuf::
+commit(std::size_t n)
+{
+    in_size_ += (std::min)(n, out_size_);
+    out_size_ = 0;
+}
+
+inline
+void
+ring_streambuf::
+consume(std::size_t n)
+{
+    if(n >= in_size_)
+    {
+        // Start over at the front, so a plain
+        // ring wraps around as late as possible.
+        in_pos_ = 0;
+        in_size_ = 0;
+        out_size_ = 0;
+        return;
+    }
+    in_pos_ += n;
+    if(in_pos_ >= cap_)
+        in_pos_ -= cap_;
+    in_size_ -= n;
+}
+
+inline
+void
+ring_streambuf::
+move_from(ring_streambuf& other)
+{
+    base_ = other.base_;
+    cap_ = other.cap_;
+    in_pos_ = other.in_pos_;
+    in_size_ = other.in_size_;
+    out_size_ = 0;
+    mirrored_ = other.mirrored_;
+    other.base_ = nullptr;
+    other.cap_ = 0;
+    other.in_pos_ = 0;
+    other.in_size_ = 0;
+    other.out_size_ = 0;
+    other.mirrored_ = false;
+}
+
+inline
+void
+ring_streambuf::
+copy_from(ring_streambuf const& other)
+{
+    using boost::asio::buffer_copy;
+    using boost::asio::mutable_buffers_1;
+    in_pos_ = 0;
+    in_size_ = 0;
+    out_size_ = 0;
+    auto const n = other.size();
+    if(cap_ < n)
+        reallocate(n);
+    in_size_ = buffer_copy(
+        mutable_buffers_1{base_, n}, other.data());
+}
+
+// Replace the storage with a larger one which can
+// hold the input sequence followed by n more bytes.
+inline
+void
+ring_streambuf::
+reallocate(std::size_t n)
+{
+    using boost::asio::buffer_copy;
+    using boost::asio::mutable_buffers_1;
+    std::size_t const least = min_alloc;
+    auto alloc_size = cap_ <= max_ / 2 ?
+        2 * cap_ : max_;
+    alloc_size = (std::max)({alloc_size, in_size_ + n,
+        (std::min)(max_, least)});
+    char* p = nullptr;
+    bool mirrored = false;
+    auto const g = detail::mirror_granularity();
+    if(alloc_size <= (std::numeric_limits<
+        std::size_t>::max)() / 2 - g)
+    {
+        auto const size = (alloc_size + g - 1) / g * g;
+        p = static_cast<char*>(detail::map_mirrored(size));
+        if(p)
+        {
+            alloc_size = size;
+            mirrored = true;
+        }
+    }
+    if(! p)
+        p = new char[alloc_size];
+    auto const len = buffer_copy(
+        mutable_buffers_1{p, in_size_}, data());
+    release();
+    base_ = p;
+    cap_ = alloc_size;
+    in_size_ = len;
+    mirrored_ = mirrored;
+}
+
+inline
+void
+ring_streambuf::
+release()
+{
+    if(mirrored_)
+        detail::unmap_mirrored(base_, cap_);
+    else
+        delete[] base_;
+    base_ = nullptr;
+    cap_ = 0;
+    in_pos_ = 0;
+    in_size_ = 0;
+    out_size_ = 0;
+    mirrored_ = false;
+}
+
+inline
+std::size_t
+read_size_helper(ring_streambuf const&
+    streambuf, std::size_t max_size)
+{
+    return detail::read_size(streambuf,
+        max_size, ring_streambuf::min_alloc);
+}
+
+template<class T>
+ring_streambuf&
+operator<<(ring_streambuf& streambuf, T const& t)
+{
+    detail::write_dynabuf(streambuf, t);
+    return streambuf;
+}
+
+} // beast
+
+#endif
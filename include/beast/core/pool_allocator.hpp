@@ -0,0 +1,112 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_POOL_ALLOCATOR_HPP
+#define BEAST_POOL_ALLOCATOR_HPP
+
+#include <beast/core/detail/block_pool.hpp>
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <type_traits>
+
+namespace beast {
+
+/** An allocator which recycles memory through per-thread free lists.
+
+    Allocations of up to 64KB are rounded up to a power of two size
+    class. Memory returned to the allocator is kept on a free list
+    belonging to the calling thread, and reused by later allocations
+    of the same size class on that thread, without calling the global
+    `operator new` or `operator delete`. Each thread retains at most
+    256KB per size class; memory beyond that, and allocations larger
+    than 64KB, go directly to the global operators.
+
+    This suits containers which repeatedly allocate and free blocks of
+    similar sizes, such as the elements of a @ref basic_streambuf on a
+    server with many short-lived connections. See @ref pooled_streambuf.
+
+    All instances are interchangeable: memory allocated by any instance,
+    on any thread, may be deallocated by any other instance, on any
+    thread.
+
+    @note Meets the requirements of @b Allocator.
+
+    @tparam T The type of object to allocate.
+*/
+template<class T>
+class pool_allocator
+{
+public:
+    /// The type of object allocated.
+    using value_type = T;
+
+#if ! GENERATING_DOCS
+    using propagate_on_container_move_assignment = std::true_type;
+
+    template<class U>
+    struct rebind
+    {
+        using other = pool_allocator<U>;
+    };
+#endif
+
+    /// Default constructor.
+    pool_allocator() = default;
+
+    /// Copy constructor.
+    pool_allocator(pool_allocator const&) = default;
+
+    /// Copy constructor from an allocator of another type.
+    template<class U>
+    pool_allocator(pool_allocator<U> const&) noexcept
+    {
+    }
+
+    /** Allocate storage for `n` objects.
+
+        @throws std::bad_alloc if the storage cannot be obtained.
+    */
+    value_type*
+    allocate(std::size_t n)
+    {
+        if(n > (std::numeric_limits<std::size_t>::max)() /
+                sizeof(value_type))
+            throw std::bad_alloc{};
+        return static_cast<value_type*>(
+            detail::block_pool::allocate(n * sizeof(value_type)));
+    }
+
+    /// Deallocate storage obtained from `allocate(n)`.
+    void
+    deallocate(value_type* p, std::size_t n) noexcept
+    {
+        detail::block_pool::deallocate(p, n * sizeof(value_type));
+    }
+
+    /// Returns `true`, all instances are interchangeable.
+    template<class U>
+    friend
+    bool
+    operator==(pool_allocator const&, pool_allocator<U> const&)
+    {
+        return true;
+    }
+
+    /// Returns `false`, all instances are interchangeable.
+    template<class U>
+    friend
+    bool
+    operator!=(pool_allocator const&, pool_allocator<U> const&)
+    {
+        return false;
+    }
+};
+
+} // beast
+
+#endif
@@ -0,0 +1,159 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_READ_UNTIL_HPP
+#define BEAST_READ_UNTIL_HPP
+
+#include <beast/core/async_completion.hpp>
+#include <beast/core/error.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <cstddef>
+
+namespace beast {
+
+/** Read data into a dynamic buffer until it contains a delimiter.
+
+    This function synchronously reads from a stream into a
+    @b DynamicBuffer until the buffer's input sequence contains
+    the specified delimiter. The call will block until one of the
+    following conditions is met:
+
+    @li The input sequence contains the delimiter.
+
+    @li An error occurs.
+
+    This function is implemented in terms of one or more calls
+    to the stream's `read_some` function. If the input sequence
+    already contains the delimiter, the function returns without
+    reading. The implementation may read additional octets that
+    lie past the end of the delimiter. These are left in the
+    dynamic buffer, to be used by subsequent calls.
+
+    Unlike `boost::asio::read_until`, the bytes already searched
+    are not searched again after each read, and the search may
+    examine several octets at a time, so the cost of the search is
+    proportional to the number of bytes received even when they
+    arrive in many small pieces. The delimiter may span the
+    boundaries between the buffers of a sequence with more than
+    one element, such as that of @ref streambuf.
+
+    @param stream The stream from which the data is to be read.
+    The type must support the @b SyncReadStream concept.
+
+    @param dynabuf A @b DynamicBuffer to hold the data read.
+
+    @param delim The delimiter to search for.
+
+    @return The number of bytes in the dynamic buffer's input
+    sequence up to and including the delimiter.
+
+    @throws system_error Thrown on failure. If the size of the
+    dynamic buffer reaches its maximum before the delimiter is
+    found, the error is `boost::asio::error::not_found`.
+*/
+template<class SyncReadStream, class DynamicBuffer>
+std::size_t
+read_until(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    boost::string_ref const& delim);
+
+/** Read data into a dynamic buffer until it contains a delimiter.
+
+    This function synchronously reads from a stream into a
+    @b DynamicBuffer until the buffer's input sequence contains
+    the specified delimiter. The call will block until one of the
+    following conditions is met:
+
+    @li The input sequence contains the delimiter.
+
+    @li An error occurs.
+
+    This function is implemented in terms of one or more calls
+    to the stream's `read_some` function. If the input sequence
+    already contains the delimiter, the function returns without
+    reading. The implementation may read additional octets that
+    lie past the end of the delimiter. These are left in the
+    dynamic buffer, to be used by subsequent calls.
+
+    @param stream The stream from which the data is to be read.
+    The type must support the @b SyncReadStream concept.
+
+    @param dynabuf A @b DynamicBuffer to hold the data read.
+
+    @param delim The delimiter to search for.
+
+    @param ec Set to the error, if any occurred. If the size of
+    the dynamic buffer reaches its maximum before the delimiter
+    is found, the error is `boost::asio::error::not_found`.
+
+    @return The number of bytes in the dynamic buffer's input
+    sequence up to and including the delimiter, or zero if an
+    error occurred.
+*/
+template<class SyncReadStream, class DynamicBuffer>
+std::size_t
+read_until(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    boost::string_ref const& delim, error_code& ec);
+
+/** Start an asynchronous operation to read data into a dynamic buffer until it contains a delimiter.
+
+    This function is used to asynchronously read from a stream into
+    a @b DynamicBuffer until the buffer's input sequence contains
+    the specified delimiter. The function call always returns
+    immediately. The asynchronous operation will continue until one
+    of the following conditions is true:
+
+    @li The input sequence contains the delimiter.
+
+    @li An error occurs.
+
+    This operation is implemented in terms of zero or more calls to
+    the stream's `async_read_some` function, and is known as a
+    <em>composed operation</em>. The program must ensure that the
+    stream performs no other operations until this operation
+    completes. The implementation may read additional octets that
+    lie past the end of the delimiter. These are left in the
+    dynamic buffer, to be used by subsequent calls.
+
+    @param stream The stream from which the data is to be read.
+    The type must support the @b AsyncReadStream concept.
+
+    @param dynabuf A @b DynamicBuffer to hold the data read. This
+    object must remain valid until the completion handler is
+    invoked.
+
+    @param delim The delimiter to search for. A copy of the
+    delimiter is made.
+
+    @param handler The handler to be called when the request
+    completes. Copies will be made of the handler as required.
+    The equivalent function signature of the handler must be:
+    @code void handler(
+        error_code const& error,        // result of operation
+        std::size_t bytes_transferred   // bytes up to and including
+                                        // the delimiter, or zero
+    ); @endcode
+    Regardless of whether the asynchronous operation completes
+    immediately or not, the handler will not be invoked from within
+    this function. Invocation of the handler will be performed in a
+    manner equivalent to using `boost::asio::io_service::post`.
+*/
+template<class AsyncReadStream,
+    class DynamicBuffer, class ReadHandler>
+#if GENERATING_DOCS
+void_or_deduced
+#else
+typename async_completion<ReadHandler,
+    void(error_code, std::size_t)>::result_type
+#endif
+async_read_until(AsyncReadStream& stream, DynamicBuffer& dynabuf,
+    boost::string_ref const& delim, ReadHandler&& handler);
+
+} // beast
+
+#include <beast/core/impl/read_until.ipp>
+
+#endif
@@ -0,0 +1,242 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_RING_STREAMBUF_HPP
+#define BEAST_RING_STREAMBUF_HPP
+
+#include <boost/asio/buffer.hpp>
+#include <cstddef>
+#include <limits>
+
+namespace beast {
+
+/** A @b `DynamicBuffer` that uses a circular buffer.
+
+    Consumed bytes are reused in place, so a long-lived connection
+    which reads and consumes continuously neither allocates nor moves
+    the bytes it has not consumed yet. The storage grows geometrically
+    when the input and output sequences do not fit, up to an optional
+    maximum size.
+
+    Where the platform allows it, the storage is mapped twice into
+    consecutive virtual addresses, so the input sequence and the
+    output sequence are each always a single buffer even when they
+    wrap around the end of the storage. This is done with `memfd_create`
+    and `mmap` on Linux. On other platforms, when the mapping cannot
+    be established, or when `BEAST_NO_MIRRORED_MEMORY` is defined, a
+    plain circular buffer is used instead, and the sequences consist
+    of two buffers when they wrap around. @ref mirrored reports which
+    one is in use.
+
+    Buffers returned by @ref data and @ref prepare are invalidated by
+    any subsequent call to @ref prepare or @ref consume.
+
+    @note Meets the requirements of @b DynamicBuffer.
+*/
+class ring_streambuf
+{
+    template<class Buffer>
+    class buffers_pair
+    {
+        Buffer b_[2];
+        std::size_t n_ = 0;
+
+    public:
+        using value_type = Buffer;
+        using const_iterator = Buffer const*;
+
+        buffers_pair() = default;
+        buffers_pair(buffers_pair const&) = default;
+        buffers_pair& operator=(buffers_pair const&) = default;
+
+        buffers_pair(Buffer const& b0, Buffer const& b1)
+            : b_{b0, b1}
+            , n_(boost::asio::buffer_size(b1) > 0 ? 2 : 1)
+        {
+        }
+
+        const_iterator
+        begin() const
+        {
+            return b_;
+        }
+
+        const_iterator
+        end() const
+        {
+            return b_ + n_;
+        }
+    };
+
+    // The smallest allocation
+    static std::size_t constexpr min_alloc = 4096;
+
+    char* base_ = nullptr;      // the storage
+    std::size_t cap_ = 0;       // size of the storage
+    std::size_t in_pos_ = 0;    // offset of the input sequence
+    std::size_t in_size_ = 0;   // size of the input sequence
+    std::size_t out_size_ = 0;  // size of the output sequence
+    std::size_t max_;           // maximum size
+    bool mirrored_ = false;     // true if base_ is mapped twice
+
+public:
+#if GENERATING_DOCS
+    /// The type used to represent the input sequence as a list of buffers.
+    using const_buffers_type = implementation_defined;
+
+    /// The type used to represent the output sequence as a list of buffers.
+    using mutable_buffers_type = implementation_defined;
+
+#else
+    using const_buffers_type =
+        buffers_pair<boost::asio::const_buffer>;
+
+    using mutable_buffers_type =
+        buffers_pair<boost::asio::mutable_buffer>;
+
+#endif
+    /// Destructor.
+    ~ring_streambuf();
+
+    /** Move constructor.
+
+        The new object will have the input sequence of
+        the other stream buffer, and an empty output sequence.
+
+        @note After the move, the moved-from object will have
+        an empty input and output sequence, with no internal
+        buffers allocated.
+    */
+    ring_streambuf(ring_streambuf&&);
+
+    /** Move assignment.
+
+        This object will have the input sequence of
+        the other stream buffer, and an empty output sequence.
+
+        @note After the move, the moved-from object will have
+        an empty input and output sequence, with no internal
+        buffers allocated.
+    */
+    ring_streambuf&
+    operator=(ring_streambuf&&);
+
+    /** Copy constructor.
+
+        This object will have a copy of the other stream
+        buffer's input sequence, and an empty output sequence.
+    */
+    ring_streambuf(ring_streambuf const&);
+
+    /** Copy assignment.
+
+        This object will have a copy of the other stream
+        buffer's input sequence, and an empty output sequence.
+    */
+    ring_streambuf&
+    operator=(ring_streambuf const&);
+
+    /** Construct a stream buffer.
+
+        No memory is allocated until the first call to @ref prepare.
+
+        @param limit The largest permitted sum of the sizes of the
+        input and output sequences. Calls to @ref prepare which
+        would exceed this limit throw `std::length_error`.
+    */
+    explicit
+    ring_streambuf(std::size_t limit =
+        (std::numeric_limits<std::size_t>::max)());
+
+    /// Returns the size of the input sequence.
+    std::size_t
+    size() const
+    {
+        return in_size_;
+    }
+
+    /// Returns the permitted maximum sum of the sizes of the input and output sequence.
+    std::size_t
+    max_size() const
+    {
+        return max_;
+    }
+
+    /// Returns the maximum sum of the sizes of the input sequence and output sequence the buffer can hold without requiring reallocation.
+    std::size_t
+    capacity() const
+    {
+        return cap_;
+    }
+
+    /** Returns `true` if the storage is mapped twice.
+
+        When this returns `true`, @ref data and @ref prepare
+        always return a single buffer.
+    */
+    bool
+    mirrored() const
+    {
+        return mirrored_;
+    }
+
+    /// Get a list of buffers that represents the input sequence.
+    const_buffers_type
+    data() const;
+
+    /** Get a list of buffers that represents the output sequence, with the given size.
+
+        @throws std::length_error if `size() + n` exceeds `max_size()`.
+    */
+    mutable_buffers_type
+    prepare(std::size_t n);
+
+    /// Move bytes from the output sequence to the input sequence.
+    void
+    commit(std::size_t n);
+
+    /// Remove bytes from the input sequence.
+    void
+    consume(std::size_t n);
+
+    // Helper for boost::asio::read_until
+    friend
+    std::size_t
+    read_size_helper(ring_streambuf const& streambuf,
+        std::size_t max_size);
+
+private:
+    void
+    move_from(ring_streambuf& other);
+
+    void
+    copy_from(ring_streambuf const& other);
+
+    void
+    reallocate(std::size_t n);
+
+    void
+    release();
+};
+
+/** Format output to a @ref ring_streambuf.
+
+    @param streambuf The @ref ring_streambuf to write to.
+
+    @param t The object to write.
+
+    @return A reference to the @ref ring_streambuf.
+*/
+template<class T>
+ring_streambuf&
+operator<<(ring_streambuf& streambuf, T const& t);
+
+} // beast
+
+#include <beast/core/impl/ring_streambuf.ipp>
+
+#endif
@@ -9,6 +9,7 @@
 #define BEAST_STREAMBUF_HPP
 
 #include <beast/core/basic_streambuf.hpp>
+#include <beast/core/pool_allocator.hpp>
 
 namespace beast {
 
@@ -23,6 +24,17 @@ namespace beast {
 */
 using streambuf = basic_streambuf<std::allocator<char>>;
 
+/** A @b `DynamicBuffer` that uses multiple buffers from a pool.
+
+    This is a @ref basic_streambuf whose character arrays are recycled
+    through the per-thread free lists of @ref pool_allocator, instead
+    of being obtained from and returned to the global heap each time
+    the buffer grows and is consumed.
+
+    @note Meets the requirements of @b `DynamicBuffer`.
+*/
+using pooled_streambuf = basic_streambuf<pool_allocator<char>>;
+
 } // beast
 
 #endif
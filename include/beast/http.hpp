@@ -8,12 +8,23 @@
 #ifndef BEAST_HTTP_HPP
 #define BEAST_HTTP_HPP
 
+#include <beast/http/allow_inline.hpp>
 #include <beast/http/basic_headers.hpp>
 #include <beast/http/basic_parser_v1.hpp>
 #include <beast/http/body_type.hpp>
+#include <beast/http/cached_response.hpp>
+#include <beast/http/date.hpp>
 #include <beast/http/empty_body.hpp>
+#include <beast/http/field.hpp>
+#include <beast/http/file_body.hpp>
+#include <beast/http/flat_headers.hpp>
+#include <beast/http/header_block.hpp>
+#include <beast/http/header_block_parser_v1.hpp>
+#include <beast/http/header_buffer.hpp>
 #include <beast/http/headers.hpp>
+#include <beast/http/mapped_file.hpp>
 #include <beast/http/message.hpp>
+#include <beast/http/mmap_body.hpp>
 #include <beast/http/parse.hpp>
 #include <beast/http/parse_error.hpp>
 #include <beast/http/parser_v1.hpp>
@@ -21,6 +32,7 @@
 #include <beast/http/reason.hpp>
 #include <beast/http/resume_context.hpp>
 #include <beast/http/rfc7230.hpp>
+#include <beast/http/serializer.hpp>
 #include <beast/http/streambuf_body.hpp>
 #include <beast/http/string_body.hpp>
 #include <beast/http/write.hpp>
@@ -0,0 +1,72 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_ALLOW_INLINE_HPP
+#define BEAST_HTTP_ALLOW_INLINE_HPP
+
+#include <beast/http/detail/inline_handler.hpp>
+#include <type_traits>
+#include <utility>
+
+namespace beast {
+namespace http {
+
+/** Allow a read to invoke its handler from within the initiating function.
+
+    The handler of @ref async_read, @ref async_read_batch or
+    @ref async_parse is never invoked from within the initiating
+    function, even when the stream buffer already holds a complete
+    message. It is posted to the io_service, which costs a round trip
+    through the io_service's queue for every pipelined message.
+
+    This function returns a new handler which, when invoked, calls the
+    original handler with the same arguments. When the stream buffer
+    already holds a complete message, a read started with the returned
+    handler invokes it in a manner equivalent to using
+    `boost::asio::io_service::dispatch`. Called from a thread running
+    the io_service, this invokes the handler from within the initiating
+    function. At most eight such handlers are nested on one thread;
+    beyond that, the handler is posted instead.
+
+    The caller must be prepared for the handler to run before the
+    initiating function returns. For example, it must not hold a lock
+    which the handler acquires. The returned handler must be the one
+    passed to the read: wrapping it again, such as with a strand,
+    hides the permission.
+
+    Example:
+    @code
+    void
+    on_read(error_code const& ec)
+    {
+        // ...
+        http::async_read(sock_, sb_, req_, http::allow_inline(
+            std::bind(&connection::on_read, shared_from_this(),
+                std::placeholders::_1)));
+    }
+    @endcode
+
+    @param handler The handler to wrap. It is moved or copied
+    into the returned handler.
+*/
+template<class Handler>
+#if GENERATING_DOCS
+implementation_defined
+#else
+detail::inline_handler<typename std::decay<Handler>::type>
+#endif
+allow_inline(Handler&& handler)
+{
+    return detail::inline_handler<
+        typename std::decay<Handler>::type>(
+            std::forward<Handler>(handler));
+}
+
+} // http
+} // beast
+
+#endif
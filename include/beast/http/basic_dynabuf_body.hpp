@@ -9,8 +9,11 @@
 #define BEAST_HTTP_BASIC_DYNABUF_BODY_HPP
 
 #include <beast/http/body_type.hpp>
+#include <beast/core/error.hpp>
 #include <beast/core/detail/type_traits.hpp>
 #include <boost/asio/buffer.hpp>
+#include <new>
+#include <stdexcept>
 
 namespace beast {
 namespace http {
@@ -56,6 +59,32 @@ private:
             sb_.commit(buffer_copy(
                 sb_.prepare(size), buffer(data, size)));
         }
+
+        typename DynamicBuffer::mutable_buffers_type
+        prepare(std::size_t n, error_code& ec)
+        {
+            try
+            {
+                return sb_.prepare(n);
+            }
+            catch(std::length_error const&)
+            {
+                ec = errc::make_error_code(
+                    errc::value_too_large);
+            }
+            catch(std::bad_alloc const&)
+            {
+                ec = errc::make_error_code(
+                    errc::not_enough_memory);
+            }
+            return sb_.prepare(0);
+        }
+
+        void
+        commit(std::size_t n, error_code&)
+        {
+            sb_.commit(n);
+        }
     };
 
     class writer
@@ -72,6 +72,12 @@ class basic_headers :
     void
     copy_assign(basic_headers const&, std::true_type);
 
+    std::size_t
+    count(key const& k) const;
+
+    const_iterator
+    find(key const& k) const;
+
     template<class FieldSequence>
     void
     copy_from(FieldSequence const& fs)
@@ -195,13 +201,24 @@ public:
     bool
     exists(boost::string_ref const& name) const
     {
-        return set_.find(name, less{}) != set_.end();
+        return find(name) != end();
+    }
+
+    /// Returns `true` if the specified field exists.
+    bool
+    exists(field f) const
+    {
+        return find(f) != end();
     }
 
     /// Returns the number of values for the specified field.
     std::size_t
     count(boost::string_ref const& name) const;
 
+    /// Returns the number of values for the specified field.
+    std::size_t
+    count(field f) const;
+
     /** Returns an iterator to the case-insensitive matching field name.
 
         If more than one field with the specified name exists, the
@@ -210,6 +227,18 @@ public:
     iterator
     find(boost::string_ref const& name) const;
 
+    /** Returns an iterator to the matching well-known field.
+
+        Well-known fields are located without comparing strings.
+        If more than one field with the specified name exists, the
+        first field defined by insertion order is returned.
+
+        @return An iterator to the field, or `end()` if the field
+        does not exist or `f` is @ref field::unknown.
+    */
+    iterator
+    find(field f) const;
+
     /** Returns the value for a case-insensitive matching header, or `""`.
 
         If more than one field with the specified name exists, the
@@ -218,6 +247,15 @@ public:
     boost::string_ref
     operator[](boost::string_ref const& name) const;
 
+    /** Returns the value for a well-known field, or `""`.
+
+        Well-known fields are located without comparing strings.
+        If more than one field with the specified name exists, the
+        first field defined by insertion order is returned.
+    */
+    boost::string_ref
+    operator[](field f) const;
+
     /// Clear the contents of the basic_headers.
     void
     clear() noexcept;
@@ -266,6 +304,20 @@ public:
         insert(name, boost::lexical_cast<std::string>(value));
     }
 
+    /** Insert a well-known field value.
+
+        The field is inserted using its canonical name. If a field
+        with the same name already exists, the existing field is
+        untouched and a new field value pair is inserted into the
+        container.
+
+        @param f The field. This may not be @ref field::unknown.
+
+        @param value A string holding the value of the field.
+    */
+    void
+    insert(field f, boost::string_ref value);
+
     /** Replace a field value.
 
         First removes any values with matching field names, then
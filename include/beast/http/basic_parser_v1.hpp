@@ -8,6 +8,7 @@
 #ifndef BEAST_HTTP_BASIC_PARSER_v1_HPP
 #define BEAST_HTTP_BASIC_PARSER_v1_HPP
 
+#include <beast/http/field.hpp>
 #include <beast/http/message.hpp>
 #include <beast/http/parse_error.hpp>
 #include <beast/http/rfc7230.hpp>
@@ -18,6 +19,7 @@
 #include <climits>
 #include <cstdint>
 #include <type_traits>
+#include <vector>
 
 namespace beast {
 namespace http {
@@ -179,6 +181,9 @@ static std::uint64_t constexpr no_content_length =
 
         // Called for each piece of the current header value.
         //
+        // The function field_id() returns the well-known
+        // name of the current field, if any.
+        //
         void on_value(boost::string_ref const&, error_code&)
 
         // Called when all the headers have been parsed successfully.
@@ -235,15 +240,6 @@ private:
     enum field_state : std::uint8_t
     {
         h_general = 0,
-        h_C,
-        h_CO,
-        h_CON,
-
-        h_matching_connection,
-        h_matching_proxy_connection,
-        h_matching_content_length,
-        h_matching_transfer_encoding,
-        h_matching_upgrade,
 
         h_connection,
         h_content_length0,
@@ -281,10 +277,12 @@ private:
     unsigned flags_       : 8;
     unsigned fs_          : 8;
     unsigned pos_         : 8; // position in field state
+    unsigned fid_         : 8; // field being matched, or matched
     unsigned http_major_  : 16;
     unsigned http_minor_  : 16;
     unsigned status_code_ : 16;
     bool upgrade_         : 1; // true if parser exited for upgrade
+    bool direct_          : 1; // true if caller reads the body
 
 public:
     /// Default constructor
@@ -335,6 +333,13 @@ public:
         b_left_ = b_max_;
     }
 
+    /// Returns the body maximum size, or zero if there is no limit
+    std::size_t
+    body_limit() const
+    {
+        return b_max_;
+    }
+
     /// Returns internal flags associated with the parser.
     unsigned
     flags() const
@@ -399,6 +404,24 @@ public:
         return upgrade_;
     }
 
+    /** Returns the well-known name of the current field.
+
+        The parser identifies well-known field names as they are
+        received, with no additional pass over the name. This allows
+        derived classes to dispatch on the field without comparing
+        strings.
+
+        @note This function is only valid to call from `on_value`.
+
+        @return The field, or @ref field::unknown if the name
+        is not one of the well-known names.
+    */
+    field
+    field_id() const
+    {
+        return static_cast<field>(fid_);
+    }
+
     /** Returns the numeric HTTP Status-Code of a response.
 
         @return The Status-Code.
@@ -477,6 +500,125 @@ public:
     void
     write_eof(error_code& ec);
 
+    /** Resume a paused parser, leaving the body to the caller.
+
+        This function may be called when the parser has paused
+        before the body (see @ref body_what::pause). Instead of
+        presenting the body to the derived class, the parser will
+        track only the framing of the body: the Content-Length,
+        or the size of each chunk. Body octets are never copied
+        or passed to `on_body`. The caller reads them directly
+        into a buffer or file of its choosing, and informs the
+        parser using @ref consume_body.
+
+        Since the size of the body, or of each chunk, is known
+        before the octets arrive, the body size limit is applied
+        to the announced size. A caller may safely allocate
+        storage for @ref body_remain octets.
+
+        Octets which are not part of the body, such as chunk
+        headers and trailers, must still be presented to the
+        parser using `write`. Calls to `write` stop at the first
+        octet of body.
+
+        Example:
+        @code
+        // The headers are already parsed, and p is paused
+        p.resume_direct(ec);
+        while(! ec && ! p.complete())
+        {
+            if(auto const n = p.body_remain())
+            {
+                std::size_t m;
+                if(dynabuf.size() > 0)
+                {
+                    // Body octets received with the headers
+                    m = std::min<std::uint64_t>(n, dynabuf.size());
+                    for(auto const& b : prepare_buffers(m, dynabuf.data()))
+                        out.write(buffer_cast<char const*>(b), buffer_size(b));
+                    dynabuf.consume(m);
+                }
+                else
+                {
+                    // Read straight into the caller's buffer
+                    m = stream.read_some(boost::asio::buffer(
+                        buf, std::min<std::uint64_t>(n, sizeof(buf))));
+                    out.write(buf, m);
+                }
+                p.consume_body(m, ec);
+            }
+            else
+            {
+                // Chunk headers and trailers go through the parser
+                if(dynabuf.size() == 0)
+                    dynabuf.commit(stream.read_some(
+                        dynabuf.prepare(1024)));
+                dynabuf.consume(p.write(dynabuf.data(), ec));
+            }
+        }
+        @endcode
+
+        @param ec Set to the error, if any occurred. If the message
+        has no body, `on_complete` is called before this function
+        returns and the error may originate there.
+    */
+    void
+    resume_direct(error_code& ec);
+
+    /** Returns the number of body octets the caller may read directly.
+
+        This function is only meaningful after a call to
+        @ref resume_direct. A return value of zero means the
+        parser expects octets which are not part of the body,
+        or that the message is complete.
+
+        @return The number of octets remaining in the body or
+        current chunk, or @ref no_content_length if the body
+        ends when the connection is closed.
+    */
+    std::uint64_t
+    body_remain() const;
+
+    /** Inform the parser that body octets were read directly.
+
+        This function is used after a call to @ref resume_direct.
+        When the last octet of the body is consumed, the parser
+        calls `on_complete`.
+
+        @param n The number of octets read. This may not exceed
+        the value returned by @ref body_remain.
+
+        @param ec Set to the error, if any occurred.
+    */
+    void
+    consume_body(std::size_t n, error_code& ec);
+
+    /** Write body octets to the parser, returning the payload in place.
+
+        This function is used after a call to @ref resume_direct.
+        The buffer is parsed up to the end of the message or the
+        end of the buffer, whichever comes first. Each run of body
+        octets in the buffer, with the chunk encoding removed, is
+        appended to `payload` as a buffer referring to the input.
+        No octets are copied.
+
+        The buffers appended to `payload` remain valid for as long
+        as the memory referenced by `buffer`.
+
+        @param buffer The input to parse.
+
+        @param payload The container to append body buffers to.
+
+        @param ec Set to the error, if any occurred.
+
+        @return The number of octets consumed from `buffer`.
+    */
+    template<class Allocator>
+    std::size_t
+    write_body(boost::asio::const_buffer const& buffer,
+        std::vector<boost::asio::const_buffer, Allocator>& payload,
+            error_code& ec);
+
 protected:
     /** Reset the parsing state.
 
@@ -528,6 +670,12 @@ private:
         reset();
     }
 
+    state
+    body_state() const;
+
+    void
+    finish(error_code& ec);
+
     bool
     needs_eof(std::true_type) const;
 
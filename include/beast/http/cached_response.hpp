@@ -0,0 +1,249 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_CACHED_RESPONSE_HPP
+#define BEAST_HTTP_CACHED_RESPONSE_HPP
+
+#include <beast/http/date.hpp>
+#include <beast/http/message.hpp>
+#include <beast/core/async_completion.hpp>
+#include <beast/core/error.hpp>
+#include <boost/asio/buffer.hpp>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace beast {
+namespace http {
+
+/** A HTTP/1 response serialized once, for sending many times.
+
+    This object holds the complete serialized representation of a
+    response, including the body and any chunk encoding, in an
+    immutable reference counted buffer. Copies share the buffer,
+    and sending the response performs no serialization work.
+
+    If the response has a Date field whose value is an IMF-fixdate,
+    the format produced by @ref set_date, the value is replaced with
+    the current date each time the response is sent, using the same
+    shared cache as @ref set_date. Only a value of exactly
+    @ref date_size octets is replaced, so that the size of the message
+    does not change. A Date field in any other format is sent as it
+    was serialized; @ref has_date reports which case applies. The
+    stored bytes are never modified, so one cached response may be
+    sent on any number of connections from any number of threads
+    at once.
+
+    Example:
+    @code
+    response<string_body> res;
+    res.version = 11;
+    res.status = 404;
+    res.reason = "Not Found";
+    res.body = "The resource was not found.";
+    set_date(res);
+    prepare(res);
+    cached_response const not_found{res};
+    ...
+    async_write(sock, not_found, handler);
+    @endcode
+*/
+class cached_response
+{
+    struct block
+    {
+        std::string s;
+        std::size_t date;
+        bool close = false;
+    };
+
+    std::shared_ptr<block const> p_;
+
+public:
+    /// The number of octets in a formatted date
+    static std::size_t constexpr date_size = detail::date_size;
+
+    /// The type of buffer sequence returned by @ref buffers
+    using const_buffers_type =
+        std::array<boost::asio::const_buffer, 3>;
+
+    /// Copy constructor.
+    cached_response(cached_response const&) = default;
+
+    /// Copy assignment.
+    cached_response& operator=(cached_response const&) = default;
+
+    /** Construct a cached response.
+
+        The message is serialized using the same rules as @ref write.
+        The message should be prepared first, for example with
+        @ref prepare. The message is not referenced after construction.
+
+        @param msg The message to serialize.
+
+        @throws system_error Thrown if the body writer fails.
+    */
+    template<class Body, class Headers>
+    explicit
+    cached_response(message<false, Body, Headers> const& msg);
+
+    /// Returns the size of the serialized message in octets.
+    std::size_t
+    size() const
+    {
+        return p_->s.size();
+    }
+
+    /** Returns `true` if the Date field is updated when sending.
+
+        This returns `false` if the response has no Date field, or
+        if its value is not @ref date_size octets long.
+    */
+    bool
+    has_date() const
+    {
+        return p_->date != std::string::npos;
+    }
+
+    /** Returns `true` if the connection may be kept open.
+
+        When this returns `false`, the functions which send the
+        response report `boost::asio::error::eof` after sending it,
+        to indicate that the connection should be closed.
+    */
+    bool
+    keep_alive() const
+    {
+        return ! p_->close;
+    }
+
+    /// Returns the message as it was serialized at construction.
+    boost::asio::const_buffers_1
+    data() const
+    {
+        return {p_->s.data(), p_->s.size()};
+    }
+
+    /** Returns the buffers to send.
+
+        If the response has a Date field, the current date is
+        copied into `date`, and the returned buffers refer to it
+        in place of the stored field value. Otherwise `date` is
+        unused and the buffers represent @ref data.
+
+        @param date A pointer to storage for at least @ref date_size
+        characters, which must remain valid while the buffers are used.
+    */
+    const_buffers_type
+    buffers(char* date) const;
+};
+
+/** Write a cached response to a stream.
+
+    This function is used to write a @ref cached_response to a
+    stream. The call will block until one of the following
+    conditions is true:
+
+    @li The entire response is written.
+
+    @li An error occurs.
+
+    This operation is implemented in terms of one or more calls
+    to the stream's `write_some` function.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the @b `SyncWriteStream` concept.
+
+    @param cr The cached response to write.
+
+    @throws system_error Thrown on failure. If the response
+    indicates that the connection should be closed, the error
+    `boost::asio::error::eof` is reported after the response is sent.
+*/
+template<class SyncWriteStream>
+void
+write(SyncWriteStream& stream, cached_response const& cr);
+
+/** Write a cached response to a stream.
+
+    This function is used to write a @ref cached_response to a
+    stream. The call will block until one of the following
+    conditions is true:
+
+    @li The entire response is written.
+
+    @li An error occurs.
+
+    This operation is implemented in terms of one or more calls
+    to the stream's `write_some` function. No memory is allocated.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the @b `SyncWriteStream` concept.
+
+    @param cr The cached response to write.
+
+    @param ec Set to the error, if any occurred. If the response
+    indicates that the connection should be closed, the error
+    `boost::asio::error::eof` is set after the response is sent.
+*/
+template<class SyncWriteStream>
+void
+write(SyncWriteStream& stream,
+    cached_response const& cr, error_code& ec);
+
+/** Start an asynchronous operation to write a cached response.
+
+    This function is used to asynchronously write a @ref cached_response
+    to a stream. The function call always returns immediately. The
+    asynchronous operation will continue until one of the following
+    conditions is true:
+
+    @li The entire response is written.
+
+    @li An error occurs.
+
+    This operation is implemented in terms of one or more calls to
+    the stream's `async_write_some` function. The operation state,
+    which holds the current date, is allocated through the handler's
+    allocation hooks; no other memory is allocated.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the @b `AsyncWriteStream` concept.
+
+    @param cr The cached response to write. The operation holds a
+    copy, which shares the serialized buffer.
+
+    @param handler The handler to be called when the operation
+    completes. Copies will be made of the handler as required.
+    The equivalent function signature of the handler must be:
+    @code void handler(
+        error_code const& error // result of operation
+    ); @endcode
+    Regardless of whether the asynchronous operation completes
+    immediately or not, the handler will not be invoked from within
+    this function. Invocation of the handler will be performed in a
+    manner equivalent to using `boost::asio::io_service::post`. If
+    the response indicates that the connection should be closed, the
+    error `boost::asio::error::eof` is reported after it is sent.
+*/
+template<class AsyncWriteStream, class WriteHandler>
+#if GENERATING_DOCS
+void_or_deduced
+#else
+typename async_completion<
+    WriteHandler, void(error_code)>::result_type
+#endif
+async_write(AsyncWriteStream& stream,
+    cached_response const& cr, WriteHandler&& handler);
+
+} // http
+} // beast
+
+#include <beast/http/impl/cached_response.ipp>
+
+#endif
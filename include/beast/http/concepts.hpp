@@ -26,6 +26,9 @@ struct write_function
     template<class ConstBufferSequence>
     void
     operator()(ConstBufferSequence const&);
+
+    void
+    flush();
 };
 
 template<class T, class = beast::detail::void_t<>>
@@ -50,6 +53,20 @@ struct has_content_length<T, beast::detail::void_t<decltype(
         "Writer::content_length requirements not met");
 };
 
+template<class T, class = beast::detail::void_t<>>
+struct has_min_chunk_size : std::false_type {};
+
+template<class T>
+struct has_min_chunk_size<T, beast::detail::void_t<decltype(
+    std::declval<T>().min_chunk_size()
+        )> > : std::true_type
+{
+    static_assert(std::is_convertible<
+        decltype(std::declval<T>().min_chunk_size()),
+            std::size_t>::value,
+        "Writer::min_chunk_size requirements not met");
+};
+
 #if 0
 template<class T, class M, class = beast::detail::void_t<>>
 struct is_Writer : std::false_type {};
@@ -122,6 +139,19 @@ public:
 
 #endif
 
+template<class T, class = beast::detail::void_t<>>
+struct is_direct_reader : std::false_type {};
+
+template<class T>
+struct is_direct_reader<T, beast::detail::void_t<decltype(
+    std::declval<T>().prepare(
+        std::declval<std::size_t>(),
+        std::declval<error_code&>()),
+    std::declval<T>().commit(
+        std::declval<std::size_t>(),
+        std::declval<error_code&>())
+            )> > : std::true_type {};
+
 template<class T>
 class is_Parser
 {
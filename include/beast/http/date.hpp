@@ -0,0 +1,200 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_DATE_HPP
+#define BEAST_HTTP_DATE_HPP
+
+#include <beast/http/message.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+
+namespace beast {
+namespace http {
+
+namespace detail {
+
+// The length of an IMF-fixdate
+std::size_t constexpr date_size = 29;
+
+// Format a time as an IMF-fixdate, rfc7231 section 7.1.1.1:
+//
+//  "Sun, 06 Nov 1994 08:49:37 GMT"
+//
+inline
+void
+format_date(std::int64_t t, char* dest)
+{
+    static char const* const days = "SunMonTueWedThuFriSat";
+    static char const* const months =
+        "JanFebMarAprMayJunJulAugSepOctNovDec";
+    auto z = t / 86400;
+    auto secs = t % 86400;
+    if(secs < 0)
+    {
+        secs += 86400;
+        --z;
+    }
+    // 1970-01-01 was a Thursday
+    auto const wday = static_cast<int>(((z + 4) % 7 + 7) % 7);
+    // civil_from_days, http://howardhinnant.github.io/date_algorithms.html
+    z += 719468;
+    auto const era = (z >= 0 ? z : z - 146096) / 146097;
+    auto const doe = z - era * 146097;
+    auto const yoe = (doe - doe/1460 + doe/36524 - doe/146096) / 365;
+    auto const doy = doe - (365*yoe + yoe/4 - yoe/100);
+    auto const mp = (5*doy + 2)/153;
+    auto const day = static_cast<int>(doy - (153*mp + 2)/5 + 1);
+    auto const month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    auto const year = static_cast<int>(yoe + era * 400 + (month <= 2));
+    auto const hour = static_cast<int>(secs / 3600);
+    auto const minute = static_cast<int>(secs / 60 % 60);
+    auto const second = static_cast<int>(secs % 60);
+    auto const two =
+        [&](int v)
+        {
+            *dest++ = static_cast<char>('0' + v / 10);
+            *dest++ = static_cast<char>('0' + v % 10);
+        };
+    std::memcpy(dest, days + 3 * wday, 3);
+    dest += 3;
+    *dest++ = ',';
+    *dest++ = ' ';
+    two(day);
+    *dest++ = ' ';
+    std::memcpy(dest, months + 3 * (month - 1), 3);
+    dest += 3;
+    *dest++ = ' ';
+    two(year / 100 % 100);
+    two(year % 100);
+    *dest++ = ' ';
+    two(hour);
+    *dest++ = ':';
+    two(minute);
+    *dest++ = ':';
+    two(second);
+    std::memcpy(dest, " GMT", 4);
+}
+
+/*  The current date, shared by all threads.
+
+    The date is formatted at most once per second. Readers copy
+    the formatted string without locking; a sequence number which
+    is odd while the string is being replaced tells them to retry.
+    The characters are stored in atomic words so that a reader
+    racing with the writer is well defined.
+*/
+class date_cache
+{
+    std::atomic<std::uint64_t> words_[4];
+    std::atomic<std::uint32_t> seq_;
+    std::atomic<std::int64_t> time_;
+
+    date_cache()
+        : seq_(0)
+        , time_(0)
+    {
+        for(auto& w : words_)
+            w.store(0, std::memory_order_relaxed);
+        update(static_cast<std::int64_t>(std::time(nullptr)));
+    }
+
+    void
+    update(std::int64_t now)
+    {
+        auto seq = seq_.load(std::memory_order_relaxed);
+        // If another thread is updating, use its result
+        if((seq & 1) || ! seq_.compare_exchange_strong(
+                seq, seq + 1, std::memory_order_acquire))
+            return;
+        // Another thread may have stored a later time
+        // since the caller checked, never go backwards
+        if(time_.load(std::memory_order_relaxed) >= now)
+        {
+            seq_.store(seq + 2, std::memory_order_release);
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        std::uint64_t w[4] = {};
+        format_date(now, reinterpret_cast<char*>(w));
+        for(int i = 0; i < 4; ++i)
+            words_[i].store(w[i], std::memory_order_relaxed);
+        time_.store(now, std::memory_order_relaxed);
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+public:
+    static
+    date_cache&
+    get()
+    {
+        static date_cache c;
+        return c;
+    }
+
+    // Copy the current date to `dest`, which
+    // must have room for `date_size` characters.
+    void
+    copy(char* dest)
+    {
+        auto const now =
+            static_cast<std::int64_t>(std::time(nullptr));
+        if(time_.load(std::memory_order_relaxed) < now)
+            update(now);
+        for(;;)
+        {
+            auto const seq =
+                seq_.load(std::memory_order_acquire);
+            if(seq & 1)
+                continue;
+            std::uint64_t w[4];
+            for(int i = 0; i < 4; ++i)
+                w[i] = words_[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if(seq_.load(std::memory_order_relaxed) == seq)
+            {
+                std::memcpy(dest, w, date_size);
+                return;
+            }
+        }
+    }
+};
+
+} // detail
+
+/** Set the Date field of a message to the current time.
+
+    The field is set to the current time as an HTTP-date, in the
+    preferred IMF-fixdate format described in rfc7231 section
+    7.1.1.1, for example:
+    @code
+    Date: Sun, 06 Nov 1994 08:49:37 GMT
+    @endcode
+    Any existing Date field is replaced.
+
+    Formatting the date is relatively expensive, so the formatted
+    string is cached and shared by all threads. It is regenerated at
+    most once per second, and other calls only copy it.
+
+    @param msg The message to modify.
+*/
+template<bool isRequest, class Body, class Headers>
+void
+set_date(message<isRequest, Body, Headers>& msg)
+{
+    char buf[detail::date_size];
+    detail::date_cache::get().copy(buf);
+    msg.headers.replace("Date",
+        boost::string_ref{buf, sizeof(buf)});
+}
+
+} // http
+} // beast
+
+#endif
@@ -8,6 +8,7 @@
 #ifndef BEAST_HTTP_DETAIL_BASIC_HEADERS_HPP
 #define BEAST_HTTP_DETAIL_BASIC_HEADERS_HPP
 
+#include <beast/http/field.hpp>
 #include <beast/core/detail/ci_char_traits.hpp>
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/set.hpp>
@@ -62,35 +63,72 @@ protected:
                 boost::intrusive::normal_link>>
     {
         value_type data;
+        field id;
 
         element(boost::string_ref const& name,
                 boost::string_ref const& value)
             : data(name, value)
+            , id(string_to_field(name))
         {
         }
     };
 
+    // Used to look up elements by name or by field
+    struct key
+    {
+        field id;
+        boost::string_ref name;
+
+        explicit
+        key(boost::string_ref const& name_)
+            : id(string_to_field(name_))
+            , name(name_)
+        {
+        }
+
+        explicit
+        key(field id_)
+            : id(id_)
+        {
+        }
+    };
+
+    // Well-known fields are ordered by id, which requires
+    // no string comparisons. Other fields come first, and
+    // are ordered by case-insensitive name.
+    //
     struct less : private beast::detail::ci_less
     {
-        template<class String>
         bool
-        operator()(String const& lhs, element const& rhs) const
+        compare(field lid, boost::string_ref const& lhs,
+            field rid, boost::string_ref const& rhs) const
+        {
+            if(lid != rid)
+                return lid < rid;
+            if(lid != field::unknown)
+                return false;
+            return ci_less::operator()(lhs, rhs);
+        }
+
+        bool
+        operator()(key const& lhs, element const& rhs) const
         {
-            return ci_less::operator()(lhs, rhs.data.first);
+            return compare(lhs.id, lhs.name,
+                rhs.id, rhs.data.first);
         }
 
-        template<class String>
         bool
-        operator()(element const& lhs, String const& rhs) const
+        operator()(element const& lhs, key const& rhs) const
         {
-            return ci_less::operator()(lhs.data.first, rhs);
+            return compare(lhs.id, lhs.data.first,
+                rhs.id, rhs.name);
         }
 
         bool
         operator()(element const& lhs, element const& rhs) const
         {
-            return ci_less::operator()(
-                lhs.data.first, rhs.data.first);
+            return compare(lhs.id, lhs.data.first,
+                rhs.id, rhs.data.first);
         }
     };
 
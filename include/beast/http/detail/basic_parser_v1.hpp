@@ -10,6 +10,28 @@
 
 #include <cstdint>
 
+/*  Parser dispatch configuration.
+
+    When BEAST_HTTP_COMPUTED_GOTO is defined to 1 and the compiler
+    is GCC or Clang, the parser state machine dispatches on the
+    current state through a table of label addresses ("computed
+    goto") instead of a switch statement, removing the range check
+    on every transition. The switch statement is the default, as
+    it is portable and performs the same on typical workloads.
+*/
+#if BEAST_HTTP_COMPUTED_GOTO && ! defined(__GNUC__) && ! defined(__clang__)
+# undef BEAST_HTTP_COMPUTED_GOTO
+#endif
+
+// Branch prediction hints for the parser
+#if defined(__GNUC__) || defined(__clang__)
+# define BEAST_HTTP_LIKELY(x) __builtin_expect(!!(x), 1)
+# define BEAST_HTTP_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+# define BEAST_HTTP_LIKELY(x) (x)
+# define BEAST_HTTP_UNLIKELY(x) (x)
+#endif
+
 namespace beast {
 namespace http {
 namespace detail {
@@ -22,10 +44,6 @@ struct parser_str_t
     static char constexpr keep_alive[11] = "keep-alive";
 
     static char constexpr upgrade[8] = "upgrade";
-    static char constexpr connection[11] = "connection";
-    static char constexpr content_length[15] = "content-length";
-    static char constexpr proxy_connection[17] = "proxy-connection";
-    static char constexpr transfer_encoding[18] = "transfer-encoding";
 };
 
 template<class _>
@@ -44,22 +62,6 @@ template<class _>
 char constexpr
 parser_str_t<_>::upgrade[8];
 
-template<class _>
-char constexpr
-parser_str_t<_>::connection[11];
-
-template<class _>
-char constexpr
-parser_str_t<_>::content_length[15];
-
-template<class _>
-char constexpr
-parser_str_t<_>::proxy_connection[17];
-
-template<class _>
-char constexpr
-parser_str_t<_>::transfer_encoding[18];
-
 using parser_str = parser_str_t<>;
 
 class parser_base
@@ -0,0 +1,86 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_DETAIL_CHUNK_SIZE_HPP
+#define BEAST_HTTP_DETAIL_CHUNK_SIZE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace beast {
+namespace http {
+namespace detail {
+
+/*  Fast decoding of chunk sizes.
+
+    The eight octets at the start of the range are examined at
+    once ("SIMD within a register"). If the range begins with one
+    to seven hexadecimal digits, the number of digits is returned
+    and `v` is set to their value. Otherwise zero is returned, and
+    the caller should decode the octets one at a time. This covers
+    every chunk size below 0x10000000 without a loop.
+*/
+inline
+std::size_t
+parse_chunk_size(char const* p, char const* end, std::uint64_t& v)
+{
+    std::uint64_t constexpr ones = 0x0101010101010101ULL;
+    std::uint64_t constexpr highs = 0x8080808080808080ULL;
+    if(end - p < 8)
+        return 0;
+    // Load as little-endian regardless of the host
+    auto const u = reinterpret_cast<unsigned char const*>(p);
+    std::uint64_t const x =
+        static_cast<std::uint64_t>(u[0])        |
+        static_cast<std::uint64_t>(u[1]) <<  8  |
+        static_cast<std::uint64_t>(u[2]) << 16  |
+        static_cast<std::uint64_t>(u[3]) << 24  |
+        static_cast<std::uint64_t>(u[4]) << 32  |
+        static_cast<std::uint64_t>(u[5]) << 40  |
+        static_cast<std::uint64_t>(u[6]) << 48  |
+        static_cast<std::uint64_t>(u[7]) << 56;
+    // Sets the high bit of each octet c where m < c < n,
+    // for octets below 0x80.
+    auto const between =
+        [&](std::uint64_t y, unsigned m, unsigned n)
+        {
+            auto const t = y & (ones * 127);
+            return (ones * (127 + n) - t) & ~y &
+                (t + ones * (127 - m)) & highs;
+        };
+    auto const hex = (
+        between(x, '0' - 1, '9' + 1) |
+        between(x | (ones * 0x20), 'a' - 1, 'f' + 1)) & ~x;
+    // Count the leading (lowest) octets which are hex digits
+    auto const stop = ~hex & highs;
+    std::size_t n = 0;
+    while(n < 8 && ! (stop & (0x80ULL << (8 * n))))
+        ++n;
+    if(n == 0 || n == 8)
+        return 0;
+    // Convert each octet to its nibble: '0'-'9' have bit 6
+    // clear, and 'a'-'f', 'A'-'F' have bit 6 set.
+    auto d = (x & (ones * 0x0f)) + ((x >> 6) & ones) * 9;
+    // Discard the octets after the digits, then reverse
+    // their order so the last digit is in the lowest octet.
+    d &= (1ULL << (8 * n)) - 1;
+    std::uint64_t r = 0;
+    for(std::size_t i = 0; i < n; ++i)
+        r |= ((d >> (8 * i)) & 0xff) << (8 * (n - 1 - i));
+    // Pack pairs of nibbles, then pairs of octets, and so on
+    r = (r | (r >> 4)) & 0x00ff00ff00ff00ffULL;
+    r = (r | (r >> 8)) & 0x0000ffff0000ffffULL;
+    r = (r | (r >> 16)) & 0x00000000ffffffffULL;
+    v = r;
+    return n;
+}
+
+} // detail
+} // http
+} // beast
+
+#endif
@@ -0,0 +1,203 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_DETAIL_FIELD_HPP
+#define BEAST_HTTP_DETAIL_FIELD_HPP
+
+#include <beast/core/detail/ci_char_traits.hpp>
+#include <cstddef>
+
+namespace beast {
+namespace http {
+namespace detail {
+
+// Canonical field names, in order of the field enumeration.
+// The lower case forms are sorted, which field_match relies on.
+//
+template<class = void>
+struct field_str_t
+{
+    static std::size_t constexpr size = 89;
+    static char const* const names[size];
+    static unsigned char const sizes[size];
+    static unsigned char const prefix[size];
+};
+
+template<class _>
+std::size_t constexpr
+field_str_t<_>::size;
+
+template<class _>
+char const* const
+field_str_t<_>::names[size] = {
+    "Accept",
+    "Accept-Charset",
+    "Accept-Datetime",
+    "Accept-Encoding",
+    "Accept-Language",
+    "Accept-Patch",
+    "Accept-Ranges",
+    "Access-Control-Allow-Credentials",
+    "Access-Control-Allow-Headers",
+    "Access-Control-Allow-Methods",
+    "Access-Control-Allow-Origin",
+    "Access-Control-Expose-Headers",
+    "Access-Control-Max-Age",
+    "Access-Control-Request-Headers",
+    "Access-Control-Request-Method",
+    "Age",
+    "Allow",
+    "Alt-Svc",
+    "Authorization",
+    "Cache-Control",
+    "Connection",
+    "Content-Disposition",
+    "Content-Encoding",
+    "Content-Language",
+    "Content-Length",
+    "Content-Location",
+    "Content-MD5",
+    "Content-Range",
+    "Content-Security-Policy",
+    "Content-Type",
+    "Cookie",
+    "Date",
+    "DNT",
+    "ETag",
+    "Expect",
+    "Expires",
+    "Forwarded",
+    "From",
+    "Host",
+    "If-Match",
+    "If-Modified-Since",
+    "If-None-Match",
+    "If-Range",
+    "If-Unmodified-Since",
+    "Keep-Alive",
+    "Last-Modified",
+    "Link",
+    "Location",
+    "Max-Forwards",
+    "Origin",
+    "Pragma",
+    "Prefer",
+    "Preference-Applied",
+    "Proxy-Authenticate",
+    "Proxy-Authorization",
+    "Proxy-Connection",
+    "Public-Key-Pins",
+    "Range",
+    "Referer",
+    "Refresh",
+    "Retry-After",
+    "Sec-WebSocket-Accept",
+    "Sec-WebSocket-Extensions",
+    "Sec-WebSocket-Key",
+    "Sec-WebSocket-Protocol",
+    "Sec-WebSocket-Version",
+    "Server",
+    "Set-Cookie",
+    "Strict-Transport-Security",
+    "TE",
+    "Timing-Allow-Origin",
+    "Trailer",
+    "Transfer-Encoding",
+    "Upgrade",
+    "Upgrade-Insecure-Requests",
+    "User-Agent",
+    "Vary",
+    "Via",
+    "Warning",
+    "WWW-Authenticate",
+    "X-Content-Type-Options",
+    "X-Forwarded-For",
+    "X-Forwarded-Host",
+    "X-Forwarded-Proto",
+    "X-Frame-Options",
+    "X-Powered-By",
+    "X-Real-IP",
+    "X-Requested-With",
+    "X-XSS-Protection",
+};
+
+template<class _>
+unsigned char const
+field_str_t<_>::sizes[size] = {
+    6, 14, 15, 15, 15, 12, 13, 32, 28, 28, 27, 29, 22, 30, 29, 3, 5,
+    7, 13, 13, 10, 19, 16, 16, 14, 16, 11, 13, 23, 12, 6, 4, 3, 4,
+    6, 7, 9, 4, 4, 8, 17, 13, 8, 19, 10, 13, 4, 8, 12, 6, 6, 6, 18,
+    18, 19, 16, 15, 5, 7, 7, 11, 20, 24, 17, 22, 21, 6, 10, 25, 2,
+    19, 7, 17, 7, 25, 10, 4, 3, 7, 16, 22, 15, 16, 17, 15, 12, 9,
+    16, 16
+};
+
+// The length of the prefix each name shares with the one before
+template<class _>
+unsigned char const
+field_str_t<_>::prefix[size] = {
+    0, 6, 7, 7, 7, 7, 7, 4, 21, 21, 21, 15, 15, 15, 23, 1, 1, 2, 1,
+    0, 1, 3, 8, 8, 9, 9, 8, 8, 8, 8, 2, 0, 1, 0, 1, 3, 0, 1, 0, 0,
+    4, 3, 3, 3, 0, 0, 1, 1, 0, 0, 0, 2, 6, 2, 10, 6, 1, 0, 1, 3, 2,
+    0, 14, 14, 14, 14, 2, 2, 1, 0, 1, 1, 3, 0, 7, 1, 0, 1, 0, 1, 0,
+    2, 12, 12, 3, 2, 2, 4, 2
+};
+
+using field_str = field_str_t<>;
+
+/*  Incrementally match a field name against the well-known names.
+
+    `i` is one plus the index of a name whose first `pos` characters
+    match the name received so far, and `c` is the next character in
+    lower case. Returns one plus the index of a name whose first
+    `pos + 1` characters match, or zero if there is no such name.
+    Pass zero for `i` when `pos` is zero to begin matching.
+*/
+inline
+unsigned
+field_match(unsigned i, std::size_t pos, char c)
+{
+    using beast::detail::tolower;
+    auto constexpr N = field_str::size;
+    if(i == 0)
+    {
+        if(pos != 0)
+            return 0;
+        i = 1;
+    }
+    // Names sharing a prefix are adjacent, and ordered
+    // by the character which follows the prefix.
+    for(--i;;)
+    {
+        auto const s = field_str::names[i];
+        if(field_str::sizes[i] > pos)
+        {
+            auto const ch = tolower(s[pos]);
+            if(ch == c)
+                return i + 1;
+            if(ch > c)
+                return 0;
+        }
+        if(++i == N || field_str::prefix[i] < pos)
+            return 0;
+    }
+}
+
+/// Returns `true` if a match from field_match is a complete name.
+inline
+bool
+field_matched(unsigned i, std::size_t pos)
+{
+    return i != 0 &&
+        field_str::sizes[i - 1] == pos;
+}
+
+} // detail
+} // http
+} // beast
+
+#endif
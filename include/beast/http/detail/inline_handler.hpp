@@ -0,0 +1,124 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_DETAIL_INLINE_HANDLER_HPP
+#define BEAST_HTTP_DETAIL_INLINE_HANDLER_HPP
+
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/asio/detail/handler_cont_helpers.hpp>
+#include <boost/asio/detail/handler_invoke_helpers.hpp>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace beast {
+namespace http {
+namespace detail {
+
+/*  Hook which reports whether a read may invoke the handler
+    from within its initiating function.
+
+    Handlers do not allow this unless wrapped by allow_inline.
+    Composed operations which start a read forward the hook
+    to their own handler, like the asio hooks.
+*/
+inline
+bool
+allow_inline_hook(...)
+{
+    return false;
+}
+
+template<class Handler>
+bool
+inline_allowed(Handler& h)
+{
+    return allow_inline_hook(std::addressof(h));
+}
+
+/*  Handler which allows a read to invoke it inline.
+
+    Calls to the wrapped handler are forwarded, as are the
+    allocation, continuation and invocation hooks, so the
+    wrapped handler provides the same io_service execution
+    guarantees as the original handler.
+*/
+template<class Handler>
+class inline_handler
+{
+    Handler h_;
+
+public:
+    using result_type = void;
+
+    explicit
+    inline_handler(Handler const& h)
+        : h_(h)
+    {
+    }
+
+    explicit
+    inline_handler(Handler&& h)
+        : h_(std::move(h))
+    {
+    }
+
+    template<class... Args>
+    void
+    operator()(Args&&... args)
+    {
+        h_(std::forward<Args>(args)...);
+    }
+
+    friend
+    bool
+    allow_inline_hook(inline_handler*)
+    {
+        return true;
+    }
+
+    friend
+    void*
+    asio_handler_allocate(
+        std::size_t size, inline_handler* h)
+    {
+        return boost_asio_handler_alloc_helpers::
+            allocate(size, h->h_);
+    }
+
+    friend
+    void
+    asio_handler_deallocate(
+        void* p, std::size_t size, inline_handler* h)
+    {
+        boost_asio_handler_alloc_helpers::
+            deallocate(p, size, h->h_);
+    }
+
+    friend
+    bool
+    asio_handler_is_continuation(inline_handler* h)
+    {
+        return boost_asio_handler_cont_helpers::
+            is_continuation(h->h_);
+    }
+
+    template<class F>
+    friend
+    void
+    asio_handler_invoke(F&& f, inline_handler* h)
+    {
+        boost_asio_handler_invoke_helpers::
+            invoke(f, h->h_);
+    }
+};
+
+} // detail
+} // http
+} // beast
+
+#endif
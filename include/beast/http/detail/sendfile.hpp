@@ -0,0 +1,122 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_DETAIL_SENDFILE_HPP
+#define BEAST_HTTP_DETAIL_SENDFILE_HPP
+
+#include <beast/core/error.hpp>
+#include <boost/asio/basic_stream_socket.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#ifndef BEAST_NO_SENDFILE
+# if defined(__linux__)
+#  define BEAST_HTTP_DETAIL_SENDFILE 1
+#  include <sys/sendfile.h>
+#  include <cerrno>
+# endif
+#endif
+
+namespace beast {
+namespace http {
+namespace detail {
+
+template<class T>
+struct is_stream_socket : std::false_type
+{
+};
+
+template<class Protocol, class Service>
+struct is_stream_socket<
+    boost::asio::basic_stream_socket<Protocol, Service>>
+    : std::true_type
+{
+};
+
+// Determine if a Writer exposes the file it sends
+template<class T>
+class is_file_writer
+{
+    template<class U, class R = std::is_same<int,
+        decltype(std::declval<U const&>().native_handle())>,
+    class R2 = std::is_convertible<decltype(
+        std::declval<U const&>().content_length()),
+            std::uint64_t>>
+    static R check(int);
+    template<class>
+    static std::false_type check(...);
+    using type = decltype(check<T>(0));
+public:
+    static bool constexpr value = type::value;
+};
+
+/*  Determine if a body can be sent with sendfile.
+
+    This holds when the stream is a plain stream socket, so
+    the file contents can go from the kernel to the socket
+    without passing through user space. Layered streams such
+    as SSL must see the octets, so they use the Writer.
+*/
+template<class Stream, class Writer>
+struct use_sendfile : std::integral_constant<bool,
+#if BEAST_HTTP_DETAIL_SENDFILE
+    is_stream_socket<Stream>::value &&
+        is_file_writer<Writer>::value
+#else
+    false
+#endif
+    >
+{
+};
+
+#if BEAST_HTTP_DETAIL_SENDFILE
+
+// Send up to `n` octets of the file `fd` starting
+// at `offset` to the socket `sock`, advancing `offset`.
+//
+inline
+void
+send_file(int sock, int fd,
+    std::uint64_t& offset, std::uint64_t n, error_code& ec)
+{
+    // Linux transfers at most this many octets per call
+    std::uint64_t constexpr limit = 0x7ffff000;
+    off_t off = static_cast<off_t>(offset);
+    for(;;)
+    {
+        auto const result = ::sendfile(sock, fd, &off,
+            static_cast<std::size_t>(std::min(n, limit)));
+        if(result < 0)
+        {
+            if(errno == EINTR)
+                continue;
+            ec = error_code{errno,
+                boost::system::system_category()};
+            return;
+        }
+        if(result == 0 && n > 0)
+        {
+            // The file is shorter than its content length
+            ec = errc::make_error_code(errc::io_error);
+            return;
+        }
+        break;
+    }
+    ec = {};
+    offset = static_cast<std::uint64_t>(off);
+}
+
+#endif
+
+} // detail
+} // http
+} // beast
+
+#endif
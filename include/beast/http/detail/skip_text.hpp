@@ -0,0 +1,190 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_DETAIL_SKIP_TEXT_HPP
+#define BEAST_HTTP_DETAIL_SKIP_TEXT_HPP
+
+#include <beast/http/detail/rfc7230.hpp>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef BEAST_NO_SIMD
+# if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#  define BEAST_HTTP_DETAIL_SSE2 1
+#  include <emmintrin.h>
+#  if defined(_MSC_VER)
+#   include <intrin.h>
+#  endif
+# endif
+# if BEAST_HTTP_DETAIL_SSE2 && (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#  define BEAST_HTTP_DETAIL_AVX2 1
+#  include <immintrin.h>
+# endif
+#endif
+
+namespace beast {
+namespace http {
+namespace detail {
+
+/*  Fast scanning of runs of TEXT octets.
+
+    These routines return a pointer to the first octet in the
+    range [first, last) which ends a run of TEXT (see is_text),
+    or `last` if the entire range is TEXT. The URI variant also
+    stops on SP, which delimits the request-target.
+
+    On x86 the range is examined 16 octets at a time using SSE2,
+    or 32 octets at a time using AVX2 when the processor supports
+    it, which is detected once at runtime. Define BEAST_NO_SIMD to
+    always use the portable implementation.
+*/
+
+template<bool StopOnSpace>
+inline
+char const*
+skip_text_generic(char const* first, char const* last)
+{
+    for(; first != last; ++first)
+    {
+        auto const c = *first;
+        if(! is_text(c))
+            break;
+        if(StopOnSpace && c == ' ')
+            break;
+    }
+    return first;
+}
+
+#if BEAST_HTTP_DETAIL_SSE2
+
+inline
+unsigned
+ctz(std::uint32_t v)
+{
+#if defined(_MSC_VER)
+    unsigned long n;
+    _BitScanForward(&n, v);
+    return static_cast<unsigned>(n);
+#else
+    return static_cast<unsigned>(__builtin_ctz(v));
+#endif
+}
+
+// Returns a mask with one bit set for each octet
+// in the block which does not continue the run.
+//
+template<bool StopOnSpace>
+inline
+std::uint32_t
+skip_text_mask(__m128i v)
+{
+    // TEXT is HTAB, or an octet >= SP other than DEL
+    auto const lo = _mm_set1_epi8(StopOnSpace ? 0x21 : 0x20);
+    auto ok = _mm_cmpeq_epi8(_mm_max_epu8(v, lo), v);
+    ok = _mm_or_si128(ok, _mm_cmpeq_epi8(v, _mm_set1_epi8(0x09)));
+    ok = _mm_andnot_si128(
+        _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7f)), ok);
+    return static_cast<std::uint32_t>(
+        ~_mm_movemask_epi8(ok)) & 0xffff;
+}
+
+template<bool StopOnSpace>
+inline
+char const*
+skip_text_sse2(char const* first, char const* last)
+{
+    while(last - first >= 16)
+    {
+        auto const m = skip_text_mask<StopOnSpace>(
+            _mm_loadu_si128(
+                reinterpret_cast<__m128i const*>(first)));
+        if(m != 0)
+            return first + ctz(m);
+        first += 16;
+    }
+    return skip_text_generic<StopOnSpace>(first, last);
+}
+
+#endif
+
+#if BEAST_HTTP_DETAIL_AVX2
+
+template<bool StopOnSpace>
+__attribute__((target("avx2")))
+inline
+char const*
+skip_text_avx2(char const* first, char const* last)
+{
+    auto const lo = _mm256_set1_epi8(StopOnSpace ? 0x21 : 0x20);
+    auto const ht = _mm256_set1_epi8(0x09);
+    auto const del = _mm256_set1_epi8(0x7f);
+    while(last - first >= 32)
+    {
+        auto const v = _mm256_loadu_si256(
+            reinterpret_cast<__m256i const*>(first));
+        auto ok = _mm256_cmpeq_epi8(_mm256_max_epu8(v, lo), v);
+        ok = _mm256_or_si256(ok, _mm256_cmpeq_epi8(v, ht));
+        ok = _mm256_andnot_si256(_mm256_cmpeq_epi8(v, del), ok);
+        auto const m = ~static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(ok));
+        if(m != 0)
+            return first + ctz(m);
+        first += 32;
+    }
+    return skip_text_sse2<StopOnSpace>(first, last);
+}
+
+template<class = void>
+bool
+has_avx2()
+{
+    static bool const b = __builtin_cpu_supports("avx2") != 0;
+    return b;
+}
+
+#endif
+
+template<bool StopOnSpace>
+inline
+char const*
+skip_text_impl(char const* first, char const* last)
+{
+#if BEAST_HTTP_DETAIL_AVX2
+    // Short runs are not worth the dispatch
+    if(last - first >= 64 && has_avx2())
+        return skip_text_avx2<StopOnSpace>(first, last);
+#endif
+#if BEAST_HTTP_DETAIL_SSE2
+    return skip_text_sse2<StopOnSpace>(first, last);
+#else
+    return skip_text_generic<StopOnSpace>(first, last);
+#endif
+}
+
+/// Skip a run of TEXT, used for header values and the reason-phrase.
+inline
+char const*
+skip_text(char const* first, char const* last)
+{
+    return skip_text_impl<false>(first, last);
+}
+
+/// Skip a run of TEXT other than SP, used for the request-target.
+inline
+char const*
+skip_uri(char const* first, char const* last)
+{
+    return skip_text_impl<true>(first, last);
+}
+
+} // detail
+} // http
+} // beast
+
+#endif
@@ -0,0 +1,77 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_DETAIL_STATUS_LINE_HPP
+#define BEAST_HTTP_DETAIL_STATUS_LINE_HPP
+
+#include <beast/http/reason.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <string>
+
+namespace beast {
+namespace http {
+namespace detail {
+
+// Pre-formatted status lines for HTTP/1.0 and HTTP/1.1,
+// for each status code which has a known reason phrase.
+//
+class status_lines
+{
+    std::string lines_[2][500];
+
+    status_lines()
+    {
+        for(int version = 0; version < 2; ++version)
+        {
+            for(int status = 100; status < 600; ++status)
+            {
+                auto const reason = reason_string(status);
+                if(reason[0] == '<')
+                    continue;
+                lines_[version][status - 100] =
+                    (version == 0 ? "HTTP/1.0 " : "HTTP/1.1 ") +
+                        std::to_string(status) + ' ' +
+                            reason + "\r\n";
+            }
+        }
+    }
+
+public:
+    static
+    status_lines const&
+    get()
+    {
+        static status_lines const s;
+        return s;
+    }
+
+    // Returns the complete status line, or an empty
+    // string if the line is not in the table.
+    boost::string_ref
+    find(int version, int status,
+        boost::string_ref const& reason) const
+    {
+        if((version != 10 && version != 11) ||
+                status < 100 || status >= 600)
+            return {};
+        auto const& line =
+            lines_[version - 10][status - 100];
+        // "HTTP/1.1 200 " and "\r\n" surround the reason
+        if(line.empty() ||
+                line.size() - 15 != reason.size() ||
+                reason.compare(boost::string_ref{
+                    line.data() + 13, reason.size()}) != 0)
+            return {};
+        return line;
+    }
+};
+
+} // detail
+} // http
+} // beast
+
+#endif
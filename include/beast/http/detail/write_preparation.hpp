@@ -0,0 +1,229 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_DETAIL_WRITE_PREPARATION_HPP
+#define BEAST_HTTP_DETAIL_WRITE_PREPARATION_HPP
+
+#include <beast/http/header_buffer.hpp>
+#include <beast/http/message.hpp>
+#include <beast/http/rfc7230.hpp>
+#include <beast/http/detail/status_line.hpp>
+#include <beast/core/error.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace beast {
+namespace http {
+namespace detail {
+
+// Calls f with each piece of the request line
+//
+template<class Body, class Headers, class F>
+void
+for_each_firstline(
+    message<true, Body, Headers> const& msg, F&& f)
+{
+    f(msg.method);
+    f(" ");
+    f(msg.url);
+    switch(msg.version)
+    {
+    case 10:
+        f(" HTTP/1.0\r\n");
+        break;
+    case 11:
+        f(" HTTP/1.1\r\n");
+        break;
+    default:
+        f(" HTTP/" +
+            std::to_string(msg.version/10) + '.' +
+            std::to_string(msg.version%10) + "\r\n");
+        break;
+    }
+}
+
+// Calls f with each piece of the status line
+//
+template<class Body, class Headers, class F>
+void
+for_each_firstline(
+    message<false, Body, Headers> const& msg, F&& f)
+{
+    auto const line = status_lines::get().find(
+        msg.version, msg.status, msg.reason);
+    if(! line.empty())
+    {
+        f(line);
+        return;
+    }
+    switch(msg.version)
+    {
+    case 10:
+        f("HTTP/1.0 ");
+        break;
+    case 11:
+        f("HTTP/1.1 ");
+        break;
+    default:
+        f("HTTP/" +
+            std::to_string(msg.version/10) + '.' +
+            std::to_string(msg.version%10) + ' ');
+        break;
+    }
+    if(msg.status >= 100 && msg.status <= 999)
+    {
+        char const buf[4] = {
+            static_cast<char>('0' + msg.status / 100),
+            static_cast<char>('0' + msg.status / 10 % 10),
+            static_cast<char>('0' + msg.status % 10),
+            ' '};
+        f(boost::string_ref{buf, sizeof(buf)});
+    }
+    else
+    {
+        f(std::to_string(msg.status) + ' ');
+    }
+    f(msg.reason);
+    f("\r\n");
+}
+
+// Calls f with each piece of the serialized
+// start line and fields, in order.
+//
+template<bool isRequest, class Body, class Headers, class F>
+void
+for_each_header(
+    message<isRequest, Body, Headers> const& msg, F&& f)
+{
+    //static_assert(is_FieldSequence<FieldSequence>::value,
+    //    "FieldSequence requirements not met");
+    for_each_firstline(msg, f);
+    for(auto const& field : msg.headers)
+    {
+        f(field.name());
+        f(": ");
+        f(field.value());
+        f("\r\n");
+    }
+    f("\r\n");
+}
+
+// Returns the size of the serialized start line and fields
+//
+template<bool isRequest, class Body, class Headers>
+std::size_t
+header_size(message<isRequest, Body, Headers> const& msg)
+{
+    std::size_t n = 0;
+    for_each_header(msg,
+        [&](boost::string_ref const& s)
+        {
+            n += s.size();
+        });
+    return n;
+}
+
+// Serialize the start line and fields into one contiguous
+// buffer. The first pass measures, the second copies.
+//
+template<class Allocator,
+    bool isRequest, class Body, class Headers>
+void
+write_header(basic_header_buffer<Allocator>& hb,
+    message<isRequest, Body, Headers> const& msg)
+{
+    auto p = hb.prepare(header_size(msg));
+    for_each_header(msg,
+        [&](boost::string_ref const& s)
+        {
+            std::memcpy(p, s.data(), s.size());
+            p += s.size();
+        });
+}
+
+template<bool isRequest, class Body, class Headers,
+    class Allocator = std::allocator<char>>
+struct write_preparation
+{
+    using writer_type = typename Body::writer;
+
+    message<isRequest, Body, Headers> const& msg;
+    writer_type w;
+    basic_header_buffer<Allocator> own;
+    basic_header_buffer<Allocator>& hb;
+    bool chunked;
+    bool close;
+    bool initialized = false;
+    // Set when the caller serialized the start line and
+    // fields itself, so init leaves the header buffer empty.
+    bool header_written = false;
+
+    // Not copyable or movable, since hb may refer to own
+    write_preparation(write_preparation&&) = delete;
+    write_preparation(write_preparation const&) = delete;
+    write_preparation& operator=(write_preparation&&) = delete;
+    write_preparation& operator=(write_preparation const&) = delete;
+
+    explicit
+    write_preparation(
+            message<isRequest, Body, Headers> const& msg_)
+        : write_preparation(msg_, own)
+    {
+    }
+
+    write_preparation(
+            message<isRequest, Body, Headers> const& msg_,
+                basic_header_buffer<Allocator>& hb_)
+        : msg(msg_)
+        , w(msg)
+        , hb(hb_)
+    {
+        update();
+    }
+
+    // Called when the headers may have changed
+    void
+    update()
+    {
+        chunked = token_list{
+            msg.headers["Transfer-Encoding"]}.exists("chunked");
+        close = token_list{
+            msg.headers["Connection"]}.exists("close") ||
+                (msg.version < 11 && ! msg.headers.exists(
+                    "Content-Length"));
+    }
+
+    // The writer is initialized at most once
+    void
+    init_writer(error_code& ec)
+    {
+        if(initialized)
+            return;
+        w.init(ec);
+        if(ec)
+            return;
+        initialized = true;
+    }
+
+    void
+    init(error_code& ec)
+    {
+        init_writer(ec);
+        if(ec)
+            return;
+        if(! header_written)
+            write_header(hb, msg);
+    }
+};
+
+} // detail
+} // http
+} // beast
+
+#endif
@@ -0,0 +1,145 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_FIELD_HPP
+#define BEAST_HTTP_FIELD_HPP
+
+#include <boost/utility/string_ref.hpp>
+#include <cstdint>
+
+namespace beast {
+namespace http {
+
+/** Well-known HTTP header field names.
+
+    Each value identifies a commonly used field name, drawn from
+    the IANA Message Header Field Registry and popular non-standard
+    extensions. Field names are case-insensitive, so a value
+    identifies every spelling of its name.
+
+    The parser recognizes these names as they are received, and
+    containers such as @ref basic_headers use them to locate
+    fields without comparing strings.
+*/
+enum class field : std::uint8_t
+{
+    /// The field name is not one of the well-known names
+    unknown = 0,
+
+    accept,
+    accept_charset,
+    accept_datetime,
+    accept_encoding,
+    accept_language,
+    accept_patch,
+    accept_ranges,
+    access_control_allow_credentials,
+    access_control_allow_headers,
+    access_control_allow_methods,
+    access_control_allow_origin,
+    access_control_expose_headers,
+    access_control_max_age,
+    access_control_request_headers,
+    access_control_request_method,
+    age,
+    allow,
+    alt_svc,
+    authorization,
+    cache_control,
+    connection,
+    content_disposition,
+    content_encoding,
+    content_language,
+    content_length,
+    content_location,
+    content_md5,
+    content_range,
+    content_security_policy,
+    content_type,
+    cookie,
+    date,
+    dnt,
+    etag,
+    expect,
+    expires,
+    forwarded,
+    from,
+    host,
+    if_match,
+    if_modified_since,
+    if_none_match,
+    if_range,
+    if_unmodified_since,
+    keep_alive,
+    last_modified,
+    link,
+    location,
+    max_forwards,
+    origin,
+    pragma,
+    prefer,
+    preference_applied,
+    proxy_authenticate,
+    proxy_authorization,
+    proxy_connection,
+    public_key_pins,
+    range,
+    referer,
+    refresh,
+    retry_after,
+    sec_websocket_accept,
+    sec_websocket_extensions,
+    sec_websocket_key,
+    sec_websocket_protocol,
+    sec_websocket_version,
+    server,
+    set_cookie,
+    strict_transport_security,
+    te,
+    timing_allow_origin,
+    trailer,
+    transfer_encoding,
+    upgrade,
+    upgrade_insecure_requests,
+    user_agent,
+    vary,
+    via,
+    warning,
+    www_authenticate,
+    x_content_type_options,
+    x_forwarded_for,
+    x_forwarded_host,
+    x_forwarded_proto,
+    x_frame_options,
+    x_powered_by,
+    x_real_ip,
+    x_requested_with,
+    x_xss_protection,
+};
+
+/** Returns the canonical text of a well-known field name.
+
+    @return The name, or an empty string if `f` is @ref field::unknown.
+*/
+boost::string_ref
+to_string(field f);
+
+/** Returns the well-known field matching a field name.
+
+    The comparison is case-insensitive.
+
+    @return The matching field, or @ref field::unknown if there is none.
+*/
+field
+string_to_field(boost::string_ref const& s);
+
+} // http
+} // beast
+
+#include <beast/http/impl/field.ipp>
+
+#endif
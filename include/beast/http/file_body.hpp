@@ -0,0 +1,160 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_FILE_BODY_HPP
+#define BEAST_HTTP_FILE_BODY_HPP
+
+#include <beast/http/body_type.hpp>
+#include <beast/http/detail/sendfile.hpp>
+#include <beast/core/error.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/logic/tribool.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <new>
+#include <string>
+
+namespace beast {
+namespace http {
+
+/** A Body which sends the contents of a file.
+
+    The body of the message is the path of the file to send. The
+    file is opened when the message is written, and the size of
+    the file is reported as the content length.
+
+    When the message is written to a plain TCP socket on Linux,
+    the file is transferred using `sendfile`, so its contents are
+    never copied into user space. For other streams, such as SSL,
+    the file is read in large blocks.
+
+    This body has no reader, it can only be used for sending.
+
+    Meets the requirements of @b `Body`.
+*/
+struct file_body
+{
+    /// The type of the `message::body` member
+    using value_type = std::string;
+
+    /// The number of octets read from the file at a time
+    static std::size_t constexpr block_size = 65536;
+
+#if GENERATING_DOCS
+private:
+#endif
+
+    class writer
+    {
+        std::string const& path_;
+        FILE* file_ = nullptr;
+        std::uint64_t size_ = 0;
+        std::uint64_t offset_ = 0;
+        std::unique_ptr<char[]> buf_;
+
+    public:
+        writer(writer const&) = delete;
+        writer& operator=(writer const&) = delete;
+
+        template<bool isRequest, class Headers>
+        explicit
+        writer(message<isRequest,
+                file_body, Headers> const& m) noexcept
+            : path_(m.body)
+        {
+        }
+
+        ~writer()
+        {
+            if(file_)
+                fclose(file_);
+        }
+
+        void
+        init(error_code& ec) noexcept
+        {
+            file_ = fopen(path_.c_str(), "rb");
+            if(! file_)
+            {
+                ec = errc::make_error_code(
+                    static_cast<errc::errc_t>(errno));
+                return;
+            }
+            // Reads go straight to our own buffer
+            setvbuf(file_, nullptr, _IONBF, 0);
+#ifdef _MSC_VER
+            if(_fseeki64(file_, 0, SEEK_END) == 0)
+            {
+                size_ = _ftelli64(file_);
+                if(_fseeki64(file_, 0, SEEK_SET) == 0)
+                    return;
+            }
+#else
+            if(fseeko(file_, 0, SEEK_END) == 0)
+            {
+                size_ = ftello(file_);
+                if(fseeko(file_, 0, SEEK_SET) == 0)
+                    return;
+            }
+#endif
+            ec = errc::make_error_code(
+                static_cast<errc::errc_t>(errno));
+        }
+
+        std::uint64_t
+        content_length() const noexcept
+        {
+            return size_;
+        }
+
+#if BEAST_HTTP_DETAIL_SENDFILE
+        int
+        native_handle() const noexcept
+        {
+            return fileno(file_);
+        }
+#endif
+
+        template<class WriteFunction>
+        boost::tribool
+        write(resume_context&&, error_code& ec,
+            WriteFunction&& wf) noexcept
+        {
+            std::uint64_t const block = block_size;
+            auto const n = static_cast<std::size_t>(
+                std::min(size_ - offset_, block));
+            if(! buf_)
+            {
+                buf_.reset(new(std::nothrow) char[
+                    static_cast<std::size_t>(
+                        std::min(size_, block))]);
+                if(! buf_)
+                {
+                    ec = errc::make_error_code(
+                        errc::not_enough_memory);
+                    return true;
+                }
+            }
+            if(fread(buf_.get(), 1, n, file_) != n)
+            {
+                ec = errc::make_error_code(errc::io_error);
+                return true;
+            }
+            offset_ += n;
+            wf(boost::asio::buffer(buf_.get(), n));
+            return offset_ >= size_;
+        }
+    };
+};
+
+} // http
+} // beast
+
+#endif
@@ -0,0 +1,402 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_FLAT_HEADERS_HPP
+#define BEAST_HTTP_FLAT_HEADERS_HPP
+
+#include <beast/http/field.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace beast {
+namespace http {
+
+/** A contiguous container for storing HTTP headers.
+
+    This container stores the same field value pairs as
+    @ref basic_headers and offers the same interface, but keeps
+    every name and value in a single character buffer, with a
+    small array indexing the fields in order of insertion. A
+    complete set of headers costs two allocations regardless of
+    the number of fields, and iteration and lookup touch only
+    contiguous memory.
+
+    Lookups perform a linear search of the index. Names which
+    are well-known fields (see @ref field) are compared by their
+    identifier, other names are compared case-insensitively. For
+    typical messages with fewer than a few dozen fields this is
+    faster than searching a tree of separately allocated nodes.
+
+    Field names are stored as-is, but comparisons are
+    case-insensitive. When the container is iterated, the fields
+    are presented in the order of insertion. For fields with the
+    same name, the container behaves as a std::multiset; there
+    will be a separate value for each occurrence of the field name.
+
+    Erased fields leave unused space in the buffer, which is
+    reclaimed once it exceeds the space in use.
+
+    @note Meets the requirements of @b `FieldSequence`.
+*/
+template<class Allocator>
+class basic_flat_headers
+{
+    struct entry
+    {
+        std::uint32_t offset;
+        std::uint32_t name_size;
+        std::uint32_t value_size;
+        field id;
+    };
+
+    using entry_alloc_type = typename
+        std::allocator_traits<Allocator>::
+            template rebind_alloc<entry>;
+
+    std::vector<char, Allocator> buf_;
+    std::vector<entry, entry_alloc_type> index_;
+    std::size_t unused_ = 0;
+
+public:
+    /// The type of allocator used.
+    using allocator_type = Allocator;
+
+    /** The value type of the field sequence.
+
+        Meets the requirements of @b Field.
+    */
+    struct value_type
+    {
+        /// The field name
+        boost::string_ref first;
+
+        /// The field value
+        boost::string_ref second;
+
+        /// Returns the field name
+        boost::string_ref
+        name() const
+        {
+            return first;
+        }
+
+        /// Returns the field value
+        boost::string_ref
+        value() const
+        {
+            return second;
+        }
+    };
+
+    /// A const iterator to the field sequence
+#if GENERATING_DOCS
+    using const_iterator = implementation_defined;
+#else
+    class const_iterator;
+#endif
+
+    /// A const iterator to the field sequence
+    using iterator = const_iterator;
+
+    /// Default constructor.
+    basic_flat_headers() = default;
+
+    /** Construct the headers.
+
+        @param alloc The allocator to use.
+    */
+    explicit
+    basic_flat_headers(Allocator const& alloc)
+        : buf_(alloc)
+        , index_(entry_alloc_type(alloc))
+    {
+    }
+
+    /** Move constructor.
+
+        The moved-from object becomes an empty field sequence.
+
+        @param other The object to move from.
+    */
+    basic_flat_headers(basic_flat_headers&& other);
+
+    /** Move assignment.
+
+        The moved-from object becomes an empty field sequence.
+
+        @param other The object to move from.
+    */
+    basic_flat_headers& operator=(basic_flat_headers&& other);
+
+    /// Copy constructor.
+    basic_flat_headers(basic_flat_headers const&) = default;
+
+    /// Copy assignment.
+    basic_flat_headers& operator=(basic_flat_headers const&) = default;
+
+    /// Construct from a field sequence.
+    template<class FwdIt>
+    basic_flat_headers(FwdIt first, FwdIt last);
+
+    /// Returns `true` if the field sequence contains no elements.
+    bool
+    empty() const
+    {
+        return index_.empty();
+    }
+
+    /// Returns the number of elements in the field sequence.
+    std::size_t
+    size() const
+    {
+        return index_.size();
+    }
+
+    /// Returns a const iterator to the beginning of the field sequence.
+    const_iterator
+    begin() const;
+
+    /// Returns a const iterator to the end of the field sequence.
+    const_iterator
+    end() const;
+
+    /// Returns a const iterator to the beginning of the field sequence.
+    const_iterator
+    cbegin() const
+    {
+        return begin();
+    }
+
+    /// Returns a const iterator to the end of the field sequence.
+    const_iterator
+    cend() const
+    {
+        return end();
+    }
+
+    /// Returns `true` if the specified field exists.
+    bool
+    exists(boost::string_ref const& name) const
+    {
+        return find(name) != end();
+    }
+
+    /// Returns `true` if the specified field exists.
+    bool
+    exists(field f) const
+    {
+        return find(f) != end();
+    }
+
+    /// Returns the number of values for the specified field.
+    std::size_t
+    count(boost::string_ref const& name) const;
+
+    /// Returns the number of values for the specified field.
+    std::size_t
+    count(field f) const;
+
+    /** Returns an iterator to the case-insensitive matching field name.
+
+        If more than one field with the specified name exists, the
+        first field defined by insertion order is returned.
+    */
+    iterator
+    find(boost::string_ref const& name) const;
+
+    /** Returns an iterator to the matching well-known field.
+
+        If more than one field with the specified name exists, the
+        first field defined by insertion order is returned.
+
+        @return An iterator to the field, or `end()` if the field
+        does not exist or `f` is @ref field::unknown.
+    */
+    iterator
+    find(field f) const;
+
+    /** Returns the value for a case-insensitive matching header, or `""`.
+
+        If more than one field with the specified name exists, the
+        first field defined by insertion order is returned.
+
+        The returned string refers to storage owned by the container,
+        and is invalidated by any operation which modifies it.
+    */
+    boost::string_ref
+    operator[](boost::string_ref const& name) const;
+
+    /** Returns the value for a well-known field, or `""`.
+
+        If more than one field with the specified name exists, the
+        first field defined by insertion order is returned.
+
+        The returned string refers to storage owned by the container,
+        and is invalidated by any operation which modifies it.
+    */
+    boost::string_ref
+    operator[](field f) const;
+
+    /** Reserve space for fields.
+
+        @param bytes The number of octets of names and values.
+
+        @param fields The number of fields.
+    */
+    void
+    reserve(std::size_t bytes, std::size_t fields)
+    {
+        buf_.reserve(bytes);
+        index_.reserve(fields);
+    }
+
+    /** Clear the contents of the container.
+
+        Allocated storage is retained for reuse.
+    */
+    void
+    clear() noexcept
+    {
+        buf_.clear();
+        index_.clear();
+        unused_ = 0;
+    }
+
+    /** Remove a field.
+
+        If more than one field with the specified name exists, all
+        matching fields will be removed.
+
+        @param name The name of the field(s) to remove.
+
+        @return The number of fields removed.
+    */
+    std::size_t
+    erase(boost::string_ref const& name);
+
+    /** Insert a field value.
+
+        If a field with the same name already exists, the
+        existing field is untouched and a new field value pair
+        is inserted into the container.
+
+        @param name The name of the field.
+
+        @param value A string holding the value of the field.
+
+        @throws std::length_error if the container would
+        exceed 4GB of names and values.
+    */
+    void
+    insert(boost::string_ref const& name, boost::string_ref value);
+
+    /** Insert a field value.
+
+        If a field with the same name already exists, the
+        existing field is untouched and a new field value pair
+        is inserted into the container.
+
+        @param name The name of the field
+
+        @param value The value of the field. The object will be
+        converted to a string using `boost::lexical_cast`.
+    */
+    template<class T>
+    typename std::enable_if<
+        ! std::is_constructible<boost::string_ref, T>::value>::type
+    insert(boost::string_ref name, T const& value)
+    {
+        insert(name, boost::lexical_cast<std::string>(value));
+    }
+
+    /** Insert a well-known field value.
+
+        The field is inserted using its canonical name. If a field
+        with the same name already exists, the existing field is
+        untouched and a new field value pair is inserted into the
+        container.
+
+        @param f The field. This may not be @ref field::unknown.
+
+        @param value A string holding the value of the field.
+    */
+    void
+    insert(field f, boost::string_ref value);
+
+    /** Replace a field value.
+
+        First removes any values with matching field names, then
+        inserts the new field value.
+
+        @param name The name of the field.
+
+        @param value A string holding the value of the field.
+    */
+    void
+    replace(boost::string_ref const& name, boost::string_ref value);
+
+    /** Replace a field value.
+
+        First removes any values with matching field names, then
+        inserts the new field value.
+
+        @param name The name of the field
+
+        @param value The value of the field. The object will be
+        converted to a string using `boost::lexical_cast`.
+    */
+    template<class T>
+    typename std::enable_if<
+        ! std::is_constructible<boost::string_ref, T>::value>::type
+    replace(boost::string_ref const& name, T const& value)
+    {
+        replace(name,
+            boost::lexical_cast<std::string>(value));
+    }
+
+private:
+    value_type
+    get(entry const& e) const
+    {
+        auto const p = buf_.data() + e.offset;
+        return {
+            {p, e.name_size},
+            {p + e.name_size, e.value_size}};
+    }
+
+    bool
+    overlaps(boost::string_ref const& s) const
+    {
+        return ! buf_.empty() &&
+            s.data() >= buf_.data() &&
+            s.data() < buf_.data() + buf_.size();
+    }
+
+    bool
+    match(entry const& e, field id,
+        boost::string_ref const& name) const;
+
+    void
+    compact();
+};
+
+/// A typical HTTP header fields container with contiguous storage
+using flat_headers =
+    basic_flat_headers<std::allocator<char>>;
+
+} // http
+} // beast
+
+#include <beast/http/impl/flat_headers.ipp>
+
+#endif
@@ -0,0 +1,314 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_HEADER_BLOCK_HPP
+#define BEAST_HTTP_HEADER_BLOCK_HPP
+
+#include <boost/asio/buffer.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace beast {
+namespace http {
+
+template<bool, class>
+class header_block_parser_v1;
+
+/** A contiguous, append-only container for storing HTTP headers.
+
+    All fields are kept in a single character buffer, serialized
+    in the HTTP/1 wire format ("name: value\r\n" for each field).
+    A small index of offsets into the buffer locates the name and
+    value of every field, so a complete set of headers costs one
+    buffer and one index array regardless of the number of fields.
+
+    Lookups are case-insensitive and return references into the
+    buffer. Since messages typically have few fields, lookups
+    perform a linear search over the index.
+
+    Fields may be inserted but not removed or replaced. This makes
+    the container best suited to messages which are received and
+    inspected or forwarded, such as those produced by
+    @ref header_block_parser_v1.
+
+    When the container is iterated, the fields are presented in
+    the order of insertion. For fields with the same name, the
+    container behaves as a std::multiset; there will be a separate
+    value for each occurrence of the field name.
+
+    @note Meets the requirements of @b `FieldSequence`.
+*/
+template<class Allocator>
+class basic_header_block
+{
+    template<bool, class>
+    friend class header_block_parser_v1;
+
+    struct entry
+    {
+        std::uint32_t name;
+        std::uint32_t name_size;
+        std::uint32_t value;
+        std::uint32_t value_size;
+    };
+
+    using entry_alloc_type = typename
+        std::allocator_traits<Allocator>::
+            template rebind_alloc<entry>;
+
+    std::vector<char, Allocator> buf_;
+    std::vector<entry, entry_alloc_type> index_;
+
+public:
+    /// The type of allocator used.
+    using allocator_type = Allocator;
+
+    /** The value type of the field sequence.
+
+        Meets the requirements of @b Field.
+    */
+    struct value_type
+    {
+        /// The field name
+        boost::string_ref first;
+
+        /// The field value
+        boost::string_ref second;
+
+        /// Returns the field name
+        boost::string_ref
+        name() const
+        {
+            return first;
+        }
+
+        /// Returns the field value
+        boost::string_ref
+        value() const
+        {
+            return second;
+        }
+    };
+
+    /// A const iterator to the field sequence
+#if GENERATING_DOCS
+    using const_iterator = implementation_defined;
+#else
+    class const_iterator;
+#endif
+
+    /// A const iterator to the field sequence
+    using iterator = const_iterator;
+
+    /// Default constructor.
+    basic_header_block() = default;
+
+    /// Move constructor.
+    basic_header_block(basic_header_block&&) = default;
+
+    /// Copy constructor.
+    basic_header_block(basic_header_block const&) = default;
+
+    /// Move assignment.
+    basic_header_block& operator=(basic_header_block&&) = default;
+
+    /// Copy assignment.
+    basic_header_block& operator=(basic_header_block const&) = default;
+
+    /** Construct the headers.
+
+        @param alloc The allocator to use.
+    */
+    explicit
+    basic_header_block(Allocator const& alloc)
+        : buf_(alloc)
+        , index_(entry_alloc_type(alloc))
+    {
+    }
+
+    /// Returns `true` if the field sequence contains no elements.
+    bool
+    empty() const
+    {
+        return index_.empty();
+    }
+
+    /// Returns the number of elements in the field sequence.
+    std::size_t
+    size() const
+    {
+        return index_.size();
+    }
+
+    /// Returns a const iterator to the beginning of the field sequence.
+    const_iterator
+    begin() const;
+
+    /// Returns a const iterator to the end of the field sequence.
+    const_iterator
+    end() const;
+
+    /// Returns a const iterator to the beginning of the field sequence.
+    const_iterator
+    cbegin() const
+    {
+        return begin();
+    }
+
+    /// Returns a const iterator to the end of the field sequence.
+    const_iterator
+    cend() const
+    {
+        return end();
+    }
+
+    /// Returns `true` if the specified field exists.
+    bool
+    exists(boost::string_ref const& name) const
+    {
+        return find(name) != end();
+    }
+
+    /// Returns the number of values for the specified field.
+    std::size_t
+    count(boost::string_ref const& name) const;
+
+    /** Returns an iterator to the case-insensitive matching field name.
+
+        If more than one field with the specified name exists, the
+        first field defined by insertion order is returned.
+    */
+    iterator
+    find(boost::string_ref const& name) const;
+
+    /** Returns the value for a case-insensitive matching header, or `""`.
+
+        If more than one field with the specified name exists, the
+        first field defined by insertion order is returned.
+
+        The returned string refers to storage owned by the container,
+        and is invalidated by any operation which modifies it.
+    */
+    boost::string_ref
+    operator[](boost::string_ref const& name) const;
+
+    /** Returns the serialized fields.
+
+        The returned buffer holds every field in the HTTP/1 wire
+        format, in order of insertion, each terminated by CRLF.
+        It does not include the CRLF which ends the headers.
+    */
+    boost::asio::const_buffer
+    data() const
+    {
+        return {buf_.data(), buf_.size()};
+    }
+
+    /** Reserve space for fields.
+
+        @param bytes The number of octets of serialized fields.
+
+        @param fields The number of fields.
+    */
+    void
+    reserve(std::size_t bytes, std::size_t fields)
+    {
+        buf_.reserve(bytes);
+        index_.reserve(fields);
+    }
+
+    /** Clear the contents of the container.
+
+        Allocated storage is retained for reuse.
+    */
+    void
+    clear() noexcept
+    {
+        buf_.clear();
+        index_.clear();
+    }
+
+    /** Insert a field value.
+
+        If a field with the same name already exists, the
+        existing field is untouched and a new field value pair
+        is inserted into the container.
+
+        @param name The name of the field.
+
+        @param value A string holding the value of the field.
+    */
+    void
+    insert(boost::string_ref const& name, boost::string_ref value);
+
+    /** Insert a field value.
+
+        If a field with the same name already exists, the
+        existing field is untouched and a new field value pair
+        is inserted into the container.
+
+        @param name The name of the field
+
+        @param value The value of the field. The object will be
+        converted to a string using `boost::lexical_cast`.
+    */
+    template<class T>
+    typename std::enable_if<
+        ! std::is_constructible<boost::string_ref, T>::value>::type
+    insert(boost::string_ref name, T const& value)
+    {
+        insert(name, boost::lexical_cast<std::string>(value));
+    }
+
+private:
+    value_type
+    get(entry const& e) const
+    {
+        auto const p = buf_.data();
+        return {
+            {p + e.name, e.name_size},
+            {p + e.value, e.value_size}};
+    }
+
+    void
+    append(boost::string_ref const& s)
+    {
+        buf_.insert(buf_.end(), s.begin(), s.end());
+    }
+
+    void
+    begin_name();
+
+    void
+    append_name(boost::string_ref const& s);
+
+    void
+    begin_value();
+
+    void
+    append_value(boost::string_ref const& s);
+
+    void
+    end_field();
+};
+
+/// A typical HTTP header block
+using header_block =
+    basic_header_block<std::allocator<char>>;
+
+} // http
+} // beast
+
+#include <beast/http/impl/header_block.ipp>
+
+#endif
@@ -0,0 +1,239 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_HEADER_BLOCK_PARSER_V1_HPP
+#define BEAST_HTTP_HEADER_BLOCK_PARSER_V1_HPP
+
+#include <beast/http/basic_parser_v1.hpp>
+#include <beast/http/header_block.hpp>
+#include <beast/http/headers_parser_v1.hpp>
+#include <beast/http/message.hpp>
+#include <beast/core/error.hpp>
+#include <boost/assert.hpp>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace beast {
+namespace http {
+
+/** A parser for HTTP/1 request and response headers into a header block.
+
+    This class uses the HTTP/1 wire format parser to convert a
+    series of octets into a @ref request_headers or
+    @ref response_headers whose fields are stored in a
+    @ref basic_header_block.
+
+    Field names and values are appended directly to the contiguous
+    storage of the block as they are received, with no intermediate
+    copies and no per-field allocations. This makes the parser well
+    suited to proxies and other programs which mostly inspect or
+    forward headers unchanged.
+
+    Like @ref headers_parser_v1, parsing stops after the headers
+    are complete, leaving the parser positioned at the body.
+
+    @note A new instance of the parser is required for each message.
+*/
+template<bool isRequest, class Allocator = std::allocator<char>>
+class header_block_parser_v1
+    : public basic_parser_v1<isRequest,
+        header_block_parser_v1<isRequest, Allocator>>
+    , private std::conditional<isRequest,
+        detail::request_parser_base,
+            detail::response_parser_base>::type
+{
+public:
+    /// The type of message this parser produces.
+    using headers_type =
+        message_headers<isRequest, basic_header_block<Allocator>>;
+
+private:
+    headers_type h_;
+    bool in_value_ = false;
+
+public:
+    /// Default constructor
+    header_block_parser_v1() = default;
+
+    /// Move constructor
+    header_block_parser_v1(header_block_parser_v1&&) = default;
+
+    /// Copy constructor (disallowed)
+    header_block_parser_v1(header_block_parser_v1 const&) = delete;
+
+    /// Move assignment (disallowed)
+    header_block_parser_v1& operator=(header_block_parser_v1&&) = delete;
+
+    /// Copy assignment (disallowed)
+    header_block_parser_v1& operator=(header_block_parser_v1 const&) = delete;
+
+    /** Construct the parser.
+
+        @param alloc The allocator to use for the header block.
+    */
+    explicit
+    header_block_parser_v1(Allocator const& alloc)
+        : h_(alloc)
+    {
+    }
+
+    /** Returns the parsed headers.
+
+        Only valid if @ref complete would return `true`.
+    */
+    headers_type const&
+    get() const
+    {
+        return h_;
+    }
+
+    /** Returns the parsed headers.
+
+        Only valid if @ref complete would return `true`.
+    */
+    headers_type&
+    get()
+    {
+        return h_;
+    }
+
+    /** Returns ownership of the parsed headers.
+
+        Ownership is transferred to the caller. Only
+        valid if @ref complete would return `true`.
+    */
+    headers_type
+    release()
+    {
+        return std::move(h_);
+    }
+
+private:
+    friend class basic_parser_v1<isRequest, header_block_parser_v1>;
+
+    void
+    end_field()
+    {
+        if(! in_value_)
+            return;
+        in_value_ = false;
+        h_.headers.end_field();
+    }
+
+    bool
+    fits(boost::string_ref const& s) const
+    {
+        // The index stores 32-bit offsets
+        return h_.headers.buf_.size() + s.size() + 4 <=
+            (std::numeric_limits<std::uint32_t>::max)();
+    }
+
+    void on_start(error_code&)
+    {
+        h_.headers.clear();
+        in_value_ = false;
+    }
+
+    void on_method(boost::string_ref const& s, error_code&)
+    {
+        this->method_.append(s.data(), s.size());
+    }
+
+    void on_uri(boost::string_ref const& s, error_code&)
+    {
+        this->uri_.append(s.data(), s.size());
+    }
+
+    void on_reason(boost::string_ref const& s, error_code&)
+    {
+        this->reason_.append(s.data(), s.size());
+    }
+
+    void on_request_or_response(std::true_type)
+    {
+        h_.method = std::move(this->method_);
+        h_.url = std::move(this->uri_);
+    }
+
+    void on_request_or_response(std::false_type)
+    {
+        h_.status = this->status_code();
+        h_.reason = std::move(this->reason_);
+    }
+
+    void on_request(error_code&)
+    {
+        on_request_or_response(
+            std::integral_constant<bool, isRequest>{});
+    }
+
+    void on_response(error_code&)
+    {
+        on_request_or_response(
+            std::integral_constant<bool, isRequest>{});
+    }
+
+    void on_field(boost::string_ref const& s, error_code& ec)
+    {
+        if(! fits(s))
+        {
+            ec = parse_error::headers_too_big;
+            return;
+        }
+        if(in_value_ || h_.headers.empty())
+        {
+            end_field();
+            h_.headers.begin_name();
+        }
+        h_.headers.append_name(s);
+    }
+
+    void on_value(boost::string_ref const& s, error_code& ec)
+    {
+        if(! fits(s))
+        {
+            ec = parse_error::headers_too_big;
+            return;
+        }
+        if(! in_value_)
+        {
+            in_value_ = true;
+            h_.headers.begin_value();
+        }
+        h_.headers.append_value(s);
+    }
+
+    void
+    on_headers(std::uint64_t, error_code&)
+    {
+        end_field();
+        h_.version = 10 * this->http_major() + this->http_minor();
+    }
+
+    body_what
+    on_body_what(std::uint64_t, error_code&)
+    {
+        return body_what::pause;
+    }
+
+    void on_body(boost::string_ref const&, error_code&)
+    {
+    }
+
+    void on_complete(error_code&)
+    {
+    }
+};
+
+} // http
+} // beast
+
+#endif
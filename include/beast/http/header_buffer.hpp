@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_HEADER_BUFFER_HPP
+#define BEAST_HTTP_HEADER_BUFFER_HPP
+
+#include <boost/asio/buffer.hpp>
+#include <memory>
+#include <vector>
+
+namespace beast {
+namespace http {
+
+/** A reusable buffer for serialized message headers.
+
+    When a message is written, its start line and header fields
+    are serialized into a single contiguous buffer. The exact size
+    is computed in a first pass over the fields, so the buffer is
+    allocated at most once per message.
+
+    By default @ref write and @ref async_write use a new buffer for
+    every message. A caller writing many messages, for example the
+    responses on a keep-alive connection, may instead pass the same
+    buffer to each call. Its storage is retained between messages,
+    and once it is large enough no further allocations are made.
+
+    @note The buffer may not be used by more than one write
+    operation at a time.
+*/
+template<class Allocator>
+class basic_header_buffer
+{
+    std::vector<char, Allocator> buf_;
+    std::size_t size_ = 0;
+
+public:
+    /// The type of allocator used.
+    using allocator_type = Allocator;
+
+    /// Default constructor.
+    basic_header_buffer() = default;
+
+    /** Construct the buffer.
+
+        @param alloc The allocator to use.
+    */
+    explicit
+    basic_header_buffer(Allocator const& alloc)
+        : buf_(alloc)
+    {
+    }
+
+    /// Move constructor.
+    basic_header_buffer(basic_header_buffer&& other)
+        : buf_(std::move(other.buf_))
+        , size_(other.size_)
+    {
+        other.size_ = 0;
+    }
+
+    /// Move assignment.
+    basic_header_buffer&
+    operator=(basic_header_buffer&& other)
+    {
+        buf_ = std::move(other.buf_);
+        size_ = other.size_;
+        other.size_ = 0;
+        return *this;
+    }
+
+    /// Copy constructor (disallowed).
+    basic_header_buffer(basic_header_buffer const&) = delete;
+
+    /// Copy assignment (disallowed).
+    basic_header_buffer& operator=(basic_header_buffer const&) = delete;
+
+    /// Returns the size of the serialized headers.
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    /// Returns the number of octets the buffer can hold without allocating.
+    std::size_t
+    capacity() const
+    {
+        return buf_.size();
+    }
+
+    /// Returns a buffer holding the serialized headers.
+    boost::asio::const_buffers_1
+    data() const
+    {
+        return {buf_.data(), size_};
+    }
+
+    /** Reserve storage.
+
+        @param n The number of octets the buffer should be able
+        to hold without allocating.
+    */
+    void
+    reserve(std::size_t n)
+    {
+        if(buf_.size() < n)
+            buf_.resize(n);
+    }
+
+    /** Discard the serialized headers.
+
+        Allocated storage is retained for reuse.
+    */
+    void
+    clear() noexcept
+    {
+        size_ = 0;
+    }
+
+    /** Prepare the buffer to receive serialized headers.
+
+        Any previous contents are discarded. Storage is
+        allocated only if the capacity is less than `n`.
+
+        @param n The size of the serialized headers.
+
+        @return A pointer to `n` writable octets.
+    */
+    char*
+    prepare(std::size_t n)
+    {
+        reserve(n);
+        size_ = n;
+        return buf_.data();
+    }
+};
+
+/// A reusable buffer for serialized message headers
+using header_buffer =
+    basic_header_buffer<std::allocator<char>>;
+
+} // http
+} // beast
+
+#endif
@@ -9,6 +9,7 @@
 #define BEAST_HTTP_IMPL_BASIC_HEADERS_IPP
 
 #include <beast/http/detail/rfc7230.hpp>
+#include <boost/assert.hpp>
 #include <algorithm>
 
 namespace beast {
@@ -164,7 +165,7 @@ basic_headers<Allocator>::
 basic_headers(FwdIt first, FwdIt last)
 {
     for(;first != last; ++first)
-        insert(first->name(), first->value());
+        insert((*first).name(), (*first).value());
 }
 
 template<class Allocator>
@@ -172,11 +173,17 @@ std::size_t
 basic_headers<Allocator>::
 count(boost::string_ref const& name) const
 {
-    auto const it = set_.find(name, less{});
-    if(it == set_.end())
+    return count(key{name});
+}
+
+template<class Allocator>
+std::size_t
+basic_headers<Allocator>::
+count(field f) const
+{
+    if(f == field::unknown)
         return 0;
-    auto const last = set_.upper_bound(name, less{});
-    return static_cast<std::size_t>(std::distance(it, last));
+    return count(key{f});
 }
 
 template<class Allocator>
@@ -185,10 +192,18 @@ basic_headers<Allocator>::
 find(boost::string_ref const& name) const ->
     iterator
 {
-    auto const it = set_.find(name, less{});
-    if(it == set_.end())
+    return find(key{name});
+}
+
+template<class Allocator>
+auto
+basic_headers<Allocator>::
+find(field f) const ->
+    iterator
+{
+    if(f == field::unknown)
         return list_.end();
-    return list_.iterator_to(*it);
+    return find(key{f});
 }
 
 template<class Allocator>
@@ -202,6 +217,17 @@ operator[](boost::string_ref const& name) const
     return it->second;
 }
 
+template<class Allocator>
+boost::string_ref
+basic_headers<Allocator>::
+operator[](field f) const
+{
+    auto const it = find(f);
+    if(it == end())
+        return {};
+    return it->second;
+}
+
 template<class Allocator>
 void
 basic_headers<Allocator>::
@@ -217,10 +243,11 @@ std::size_t
 basic_headers<Allocator>::
 erase(boost::string_ref const& name)
 {
-    auto it = set_.find(name, less{});
+    key const k{name};
+    auto it = set_.find(k, less{});
     if(it == set_.end())
         return 0;
-    auto const last = set_.upper_bound(name, less{});
+    auto const last = set_.upper_bound(k, less{});
     std::size_t n = 1;
     for(;;)
     {
@@ -245,10 +272,43 @@ insert(boost::string_ref const& name,
     value = detail::trim(value);
     auto const p = alloc_traits::allocate(this->member(), 1);
     alloc_traits::construct(this->member(), p, name, value);
-    set_.insert_before(set_.upper_bound(name, less{}), *p);
+    set_.insert_before(set_.upper_bound(*p, less{}), *p);
     list_.push_back(*p);
 }
 
+template<class Allocator>
+void
+basic_headers<Allocator>::
+insert(field f, boost::string_ref value)
+{
+    BOOST_ASSERT(f != field::unknown);
+    insert(to_string(f), value);
+}
+
+template<class Allocator>
+std::size_t
+basic_headers<Allocator>::
+count(key const& k) const
+{
+    auto const it = set_.find(k, less{});
+    if(it == set_.end())
+        return 0;
+    auto const last = set_.upper_bound(k, less{});
+    return static_cast<std::size_t>(std::distance(it, last));
+}
+
+template<class Allocator>
+auto
+basic_headers<Allocator>::
+find(key const& k) const ->
+    iterator
+{
+    auto const it = set_.find(k, less{});
+    if(it == set_.end())
+        return list_.end();
+    return list_.iterator_to(*it);
+}
+
 template<class Allocator>
 void
 basic_headers<Allocator>::
@@ -36,9 +36,14 @@
 #ifndef BEAST_HTTP_IMPL_BASIC_PARSER_V1_IPP
 #define BEAST_HTTP_IMPL_BASIC_PARSER_V1_IPP
 
+#include <beast/http/detail/chunk_size.hpp>
+#include <beast/http/detail/field.hpp>
 #include <beast/http/detail/rfc7230.hpp>
+#include <beast/http/detail/skip_text.hpp>
 #include <beast/core/buffer_concepts.hpp>
 #include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <algorithm>
 
 namespace beast {
 namespace http {
@@ -65,10 +70,12 @@ basic_parser_v1(basic_parser_v1<
     , flags_(other.flags_)
     , fs_(other.fs_)
     , pos_(other.pos_)
+    , fid_(other.fid_)
     , http_major_(other.http_major_)
     , http_minor_(other.http_minor_)
     , status_code_(other.status_code_)
     , upgrade_(other.upgrade_)
+    , direct_(other.direct_)
 {
     BOOST_ASSERT(! other.cb_);
 }
@@ -92,10 +99,12 @@ operator=(basic_parser_v1<
     flags_ = other.flags_;
     fs_ = other.fs_;
     pos_ = other.pos_;
+    fid_ = other.fid_;
     http_major_ = other.http_major_;
     http_minor_ = other.http_minor_;
     status_code_ = other.status_code_;
     upgrade_ = other.upgrade_;
+    direct_ = other.direct_;
     return *this;
 }
 
@@ -138,6 +147,14 @@ write(ConstBufferSequence const& buffers, error_code& ec)
     return used;
 }
 
+#if BEAST_HTTP_COMPUTED_GOTO
+# define BEAST_HTTP_STATE(s) case s: s##_label
+# pragma GCC diagnostic push
+# pragma GCC diagnostic ignored "-Wpedantic"
+#else
+# define BEAST_HTTP_STATE(s) case s
+#endif
+
 template<bool isRequest, class Derived>
 std::size_t
 basic_parser_v1<isRequest, Derived>::
@@ -152,6 +169,77 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
     using boost::asio::buffer_cast;
     using boost::asio::buffer_size;
 
+#if BEAST_HTTP_COMPUTED_GOTO
+    // Indexed by state, in the order of declaration
+    static void* const labels[] = {
+        &&s_dead_label, // unused
+        &&s_dead_label,
+        &&s_req_start_label,
+        &&s_req_method0_label,
+        &&s_req_method_label,
+        &&s_req_url0_label,
+        &&s_req_url_label,
+        &&s_req_http_label,
+        &&s_req_http_H_label,
+        &&s_req_http_HT_label,
+        &&s_req_http_HTT_label,
+        &&s_req_http_HTTP_label,
+        &&s_req_major_label,
+        &&s_req_dot_label,
+        &&s_req_minor_label,
+        &&s_req_cr_label,
+        &&s_req_lf_label,
+        &&s_res_start_label,
+        &&s_res_H_label,
+        &&s_res_HT_label,
+        &&s_res_HTT_label,
+        &&s_res_HTTP_label,
+        &&s_res_major_label,
+        &&s_res_dot_label,
+        &&s_res_minor_label,
+        &&s_res_space_1_label,
+        &&s_res_status0_label,
+        &&s_res_status1_label,
+        &&s_res_status2_label,
+        &&s_res_space_2_label,
+        &&s_res_reason0_label,
+        &&s_res_reason_label,
+        &&s_res_line_lf_label,
+        &&s_res_line_done_label,
+        &&s_header_name0_label,
+        &&s_header_name_label,
+        &&s_header_value0_lf_label,
+        &&s_header_value0_almost_done_label,
+        &&s_header_value0_label,
+        &&s_header_value_label,
+        &&s_header_value_lf_label,
+        &&s_header_value_almost_done_label,
+        &&s_header_value_unfold_label,
+        &&s_headers_almost_done_label,
+        &&s_headers_done_label,
+        &&s_chunk_size0_label,
+        &&s_chunk_size_label,
+        &&s_chunk_ext_name0_label,
+        &&s_chunk_ext_name_label,
+        &&s_chunk_ext_val_label,
+        &&s_chunk_size_lf_label,
+        &&s_chunk_data0_label,
+        &&s_chunk_data_label,
+        &&s_chunk_data_cr_label,
+        &&s_chunk_data_lf_label,
+        &&s_body_pause_label,
+        &&s_body_identity0_label,
+        &&s_body_identity_label,
+        &&s_body_identity_eof0_label,
+        &&s_body_identity_eof_label,
+        &&s_complete_label,
+        &&s_restart_label,
+        &&s_closed_complete_label
+    };
+    static_assert(sizeof(labels) / sizeof(labels[0]) ==
+        s_closed_complete + 1, "missing state label");
+#endif
+
     auto const data = buffer_cast<void const*>(buffer);
     auto const size = buffer_size(buffer);
 
@@ -199,49 +287,52 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
     {
         unsigned char ch = *p;
     redo:
+#if BEAST_HTTP_COMPUTED_GOTO
+        goto *labels[s_];
+#endif
         switch(s_)
         {
-        case s_dead:
-        case s_closed_complete:
+        BEAST_HTTP_STATE(s_dead):
+        BEAST_HTTP_STATE(s_closed_complete):
             return err(parse_error::connection_closed);
             break;
 
-        case s_req_start:
+        BEAST_HTTP_STATE(s_req_start):
             flags_ = 0;
             cb_ = nullptr;
             content_length_ = no_content_length;
             s_ = s_req_method0;
             goto redo;
 
-        case s_req_method0:
-            if(! is_tchar(ch))
+        BEAST_HTTP_STATE(s_req_method0):
+            if(BEAST_HTTP_UNLIKELY(! is_tchar(ch)))
                 return err(parse_error::bad_method);
             call_on_start(ec);
-            if(ec)
+            if(BEAST_HTTP_UNLIKELY(ec))
                 return errc();
             BOOST_ASSERT(! cb_);
             cb(&self::call_on_method);
             s_ = s_req_method;
             break;
 
-        case s_req_method:
+        BEAST_HTTP_STATE(s_req_method):
             if(ch == ' ')
             {
-                if(cb(nullptr))
+                if(BEAST_HTTP_UNLIKELY(cb(nullptr)))
                     return errc();
                 s_ = s_req_url0;
                 break;
             }
-            if(! is_tchar(ch))
+            if(BEAST_HTTP_UNLIKELY(! is_tchar(ch)))
                 return err(parse_error::bad_method);
             break;
 
-        case s_req_url0:
+        BEAST_HTTP_STATE(s_req_url0):
         {
-            if(ch == ' ')
+            if(BEAST_HTTP_UNLIKELY(ch == ' '))
                 return err(parse_error::bad_uri);
             // VFALCO TODO Better checking for valid URL characters
-            if(! is_text(ch))
+            if(BEAST_HTTP_UNLIKELY(! is_text(ch)))
                 return err(parse_error::bad_uri);
             BOOST_ASSERT(! cb_);
             cb(&self::call_on_uri);
@@ -249,216 +340,230 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             break;
         }
 
-        case s_req_url:
+        BEAST_HTTP_STATE(s_req_url):
+        {
+            p = detail::skip_uri(p, end);
+            if(p == end)
+            {
+                --p;
+                break;
+            }
+            ch = *p;
             if(ch == ' ')
             {
-                if(cb(nullptr))
+                if(BEAST_HTTP_UNLIKELY(cb(nullptr)))
                     return errc();
                 s_ = s_req_http;
                 break;
             }
             // VFALCO TODO Better checking for valid URL characters
-            if(! is_text(ch))
-                return err(parse_error::bad_uri);
-            break;
+            return err(parse_error::bad_uri);
+        }
 
-        case s_req_http:
-            if(ch != 'H')
+        BEAST_HTTP_STATE(s_req_http):
+            if(BEAST_HTTP_UNLIKELY(ch != 'H'))
                 return err(parse_error::bad_version);
             s_ = s_req_http_H;
             break;
 
-        case s_req_http_H:
-            if(ch != 'T')
+        BEAST_HTTP_STATE(s_req_http_H):
+            if(BEAST_HTTP_UNLIKELY(ch != 'T'))
                 return err(parse_error::bad_version);
             s_ = s_req_http_HT;
             break;
 
-        case s_req_http_HT:
-            if(ch != 'T')
+        BEAST_HTTP_STATE(s_req_http_HT):
+            if(BEAST_HTTP_UNLIKELY(ch != 'T'))
                 return err(parse_error::bad_version);
             s_ = s_req_http_HTT;
             break;
 
-        case s_req_http_HTT:
-            if(ch != 'P')
+        BEAST_HTTP_STATE(s_req_http_HTT):
+            if(BEAST_HTTP_UNLIKELY(ch != 'P'))
                 return err(parse_error::bad_version);
             s_ = s_req_http_HTTP;
             break;
 
-        case s_req_http_HTTP:
-            if(ch != '/')
+        BEAST_HTTP_STATE(s_req_http_HTTP):
+            if(BEAST_HTTP_UNLIKELY(ch != '/'))
                 return err(parse_error::bad_version);
             s_ = s_req_major;
             break;
 
-        case s_req_major:
-            if(! is_digit(ch))
+        BEAST_HTTP_STATE(s_req_major):
+            if(BEAST_HTTP_UNLIKELY(! is_digit(ch)))
                 return err(parse_error::bad_version);
             http_major_ = ch - '0';
             s_ = s_req_dot;
             break;
 
-        case s_req_dot:
-            if(ch != '.')
+        BEAST_HTTP_STATE(s_req_dot):
+            if(BEAST_HTTP_UNLIKELY(ch != '.'))
                 return err(parse_error::bad_version);
             s_ = s_req_minor;
             break;
 
-        case s_req_minor:
-            if(! is_digit(ch))
+        BEAST_HTTP_STATE(s_req_minor):
+            if(BEAST_HTTP_UNLIKELY(! is_digit(ch)))
                 return err(parse_error::bad_version);
             http_minor_ = ch - '0';
             s_ = s_req_cr;
             break;
 
-        case s_req_cr:
-            if(ch != '\r')
+        BEAST_HTTP_STATE(s_req_cr):
+            if(BEAST_HTTP_UNLIKELY(ch != '\r'))
                 return err(parse_error::bad_version);
             s_ = s_req_lf;
             break;
 
-        case s_req_lf:
-            if(ch != '\n')
+        BEAST_HTTP_STATE(s_req_lf):
+            if(BEAST_HTTP_UNLIKELY(ch != '\n'))
                 return err(parse_error::bad_crlf);
             call_on_request(ec);
-            if(ec)
+            if(BEAST_HTTP_UNLIKELY(ec))
                 return errc();
             s_ = s_header_name0;
             break;
 
         //----------------------------------------------------------------------
 
-        case s_res_start:
+        BEAST_HTTP_STATE(s_res_start):
             flags_ = 0;
             cb_ = nullptr;
             content_length_ = no_content_length;
-            if(ch != 'H')
+            if(BEAST_HTTP_UNLIKELY(ch != 'H'))
                 return err(parse_error::bad_version);
             call_on_start(ec);
-            if(ec)
+            if(BEAST_HTTP_UNLIKELY(ec))
                 return errc();
             s_ = s_res_H;
             break;
 
-        case s_res_H:
-            if(ch != 'T')
+        BEAST_HTTP_STATE(s_res_H):
+            if(BEAST_HTTP_UNLIKELY(ch != 'T'))
                 return err(parse_error::bad_version);
             s_ = s_res_HT;
             break;
 
-        case s_res_HT:
-            if(ch != 'T')
+        BEAST_HTTP_STATE(s_res_HT):
+            if(BEAST_HTTP_UNLIKELY(ch != 'T'))
                 return err(parse_error::bad_version);
             s_ = s_res_HTT;
             break;
 
-        case s_res_HTT:
-            if(ch != 'P')
+        BEAST_HTTP_STATE(s_res_HTT):
+            if(BEAST_HTTP_UNLIKELY(ch != 'P'))
                 return err(parse_error::bad_version);
             s_ = s_res_HTTP;
             break;
 
-        case s_res_HTTP:
-            if(ch != '/')
+        BEAST_HTTP_STATE(s_res_HTTP):
+            if(BEAST_HTTP_UNLIKELY(ch != '/'))
                 return err(parse_error::bad_version);
             s_ = s_res_major;
             break;
 
-        case s_res_major:
-            if(! is_digit(ch))
+        BEAST_HTTP_STATE(s_res_major):
+            if(BEAST_HTTP_UNLIKELY(! is_digit(ch)))
                 return err(parse_error::bad_version);
             http_major_ = ch - '0';
             s_ = s_res_dot;
             break;
 
-        case s_res_dot:
-            if(ch != '.')
+        BEAST_HTTP_STATE(s_res_dot):
+            if(BEAST_HTTP_UNLIKELY(ch != '.'))
                 return err(parse_error::bad_version);
             s_ = s_res_minor;
             break;
 
-        case s_res_minor:
-            if(! is_digit(ch))
+        BEAST_HTTP_STATE(s_res_minor):
+            if(BEAST_HTTP_UNLIKELY(! is_digit(ch)))
                 return err(parse_error::bad_version);
             http_minor_ = ch - '0';
             s_ = s_res_space_1;
             break;
 
-        case s_res_space_1:
-            if(ch != ' ')
+        BEAST_HTTP_STATE(s_res_space_1):
+            if(BEAST_HTTP_UNLIKELY(ch != ' '))
                 return err(parse_error::bad_version);
             s_ = s_res_status0;
             break;
 
-        case s_res_status0:
-            if(! is_digit(ch))
+        BEAST_HTTP_STATE(s_res_status0):
+            if(BEAST_HTTP_UNLIKELY(! is_digit(ch)))
                 return err(parse_error::bad_status);
             status_code_ = ch - '0';
             s_ = s_res_status1;
             break;
 
-        case s_res_status1:
-            if(! is_digit(ch))
+        BEAST_HTTP_STATE(s_res_status1):
+            if(BEAST_HTTP_UNLIKELY(! is_digit(ch)))
                 return err(parse_error::bad_status);
             status_code_ = status_code_ * 10 + ch - '0';
             s_ = s_res_status2;
             break;
 
-        case s_res_status2:
-            if(! is_digit(ch))
+        BEAST_HTTP_STATE(s_res_status2):
+            if(BEAST_HTTP_UNLIKELY(! is_digit(ch)))
                 return err(parse_error::bad_status);
             status_code_ = status_code_ * 10 + ch - '0';
             s_ = s_res_space_2;
             break;
 
-        case s_res_space_2:
-            if(ch != ' ')
+        BEAST_HTTP_STATE(s_res_space_2):
+            if(BEAST_HTTP_UNLIKELY(ch != ' '))
                 return err(parse_error::bad_status);
             s_ = s_res_reason0;
             break;
 
-        case s_res_reason0:
+        BEAST_HTTP_STATE(s_res_reason0):
             if(ch == '\r')
             {
                 s_ = s_res_line_lf;
                 break;
             }
-            if(! is_text(ch))
+            if(BEAST_HTTP_UNLIKELY(! is_text(ch)))
                 return err(parse_error::bad_reason);
             BOOST_ASSERT(! cb_);
             cb(&self::call_on_reason);
             s_ = s_res_reason;
             break;
 
-        case s_res_reason:
+        BEAST_HTTP_STATE(s_res_reason):
+        {
+            p = detail::skip_text(p, end);
+            if(p == end)
+            {
+                --p;
+                break;
+            }
+            ch = *p;
             if(ch == '\r')
             {
-                if(cb(nullptr))
+                if(BEAST_HTTP_UNLIKELY(cb(nullptr)))
                     return errc();
                 s_ = s_res_line_lf;
                 break;
             }
-            if(! is_text(ch))
-                return err(parse_error::bad_reason);
-            break;
+            return err(parse_error::bad_reason);
+        }
 
-        case s_res_line_lf:
-            if(ch != '\n')
+        BEAST_HTTP_STATE(s_res_line_lf):
+            if(BEAST_HTTP_UNLIKELY(ch != '\n'))
                 return err(parse_error::bad_crlf);
             s_ = s_res_line_done;
             break;
 
-        case s_res_line_done:
+        BEAST_HTTP_STATE(s_res_line_done):
             call_on_response(ec);
-            if(ec)
+            if(BEAST_HTTP_UNLIKELY(ec))
                 return errc();
             s_ = s_header_name0;
             goto redo;
 
         //----------------------------------------------------------------------
 
-        case s_header_name0:
+        BEAST_HTTP_STATE(s_header_name0):
         {
             if(ch == '\r')
             {
@@ -466,25 +571,18 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
                 break;
             }
             auto c = to_field_char(ch);
-            if(! c)
+            if(BEAST_HTTP_UNLIKELY(! c))
                 return err(parse_error::bad_field);
-            switch(c)
-            {
-            case 'c': pos_ = 0; fs_ = h_C; break;
-            case 'p': pos_ = 0; fs_ = h_matching_proxy_connection; break;
-            case 't': pos_ = 0; fs_ = h_matching_transfer_encoding; break;
-            case 'u': pos_ = 0; fs_ = h_matching_upgrade; break;
-            default:
-                fs_ = h_general;
-                break;
-            }
+            fs_ = h_general;
+            fid_ = detail::field_match(0, 0, c);
+            pos_ = 1;
             BOOST_ASSERT(! cb_);
             cb(&self::call_on_field);
             s_ = s_header_name;
             break;
         }
 
-        case s_header_name:
+        BEAST_HTTP_STATE(s_header_name):
         {
             for(; p != end; ++p)
             {
@@ -492,74 +590,10 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
                 auto c = to_field_char(ch);
                 if(! c)
                     break;
-                switch(fs_)
+                if(fid_ != 0)
                 {
-                default:
-                case h_general:
-                    break;
-                case h_C:  ++pos_; fs_ = c=='o' ? h_CO : h_general; break;
-                case h_CO: ++pos_; fs_ = c=='n' ? h_CON : h_general; break;
-                case h_CON:
-                    ++pos_;
-                    switch(c)
-                    {
-                    case 'n': fs_ = h_matching_connection; break;
-                    case 't': fs_ = h_matching_content_length; break;
-                    default:
-                        fs_ = h_general;
-                    }
-                    break;
-
-                case h_matching_connection:
-                    ++pos_;
-                    if(c != detail::parser_str::connection[pos_])
-                        fs_ = h_general;
-                    else if(pos_ == sizeof(detail::parser_str::connection)-2)
-                        fs_ = h_connection;
-                    break;
-
-                case h_matching_proxy_connection:
-                    ++pos_;
-                    if(c != detail::parser_str::proxy_connection[pos_])
-                        fs_ = h_general;
-                    else if(pos_ == sizeof(detail::parser_str::proxy_connection)-2)
-                        fs_ = h_connection;
-                    break;
-
-                case h_matching_content_length:
-                    ++pos_;
-                    if(c != detail::parser_str::content_length[pos_])
-                        fs_ = h_general;
-                    else if(pos_ == sizeof(detail::parser_str::content_length)-2)
-                    {
-                        if(flags_ & parse_flag::contentlength)
-                            return err(parse_error::bad_content_length);
-                        fs_ = h_content_length0;
-                    }
-                    break;
-
-                case h_matching_transfer_encoding:
-                    ++pos_;
-                    if(c != detail::parser_str::transfer_encoding[pos_])
-                        fs_ = h_general;
-                    else if(pos_ == sizeof(detail::parser_str::transfer_encoding)-2)
-                        fs_ = h_transfer_encoding;
-                    break;
-
-                case h_matching_upgrade:
+                    fid_ = detail::field_match(fid_, pos_, c);
                     ++pos_;
-                    if(c != detail::parser_str::upgrade[pos_])
-                        fs_ = h_general;
-                    else if(pos_ == sizeof(detail::parser_str::upgrade)-2)
-                        fs_ = h_upgrade;
-                    break;
-
-                case h_connection:
-                case h_content_length0:
-                case h_transfer_encoding:
-                case h_upgrade:
-                    fs_ = h_general;
-                    break;
                 }
             }
             if(p == end)
@@ -569,7 +603,29 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             }
             if(ch == ':')
             {
-                if(cb(nullptr))
+                if(! detail::field_matched(fid_, pos_))
+                    fid_ = 0;
+                switch(static_cast<field>(fid_))
+                {
+                case field::connection:
+                case field::proxy_connection:
+                    fs_ = h_connection;
+                    break;
+                case field::content_length:
+                    if(BEAST_HTTP_UNLIKELY(flags_ & parse_flag::contentlength))
+                        return err(parse_error::bad_content_length);
+                    fs_ = h_content_length0;
+                    break;
+                case field::transfer_encoding:
+                    fs_ = h_transfer_encoding;
+                    break;
+                case field::upgrade:
+                    fs_ = h_upgrade;
+                    break;
+                default:
+                    break;
+                }
+                if(BEAST_HTTP_UNLIKELY(cb(nullptr)))
                     return errc();
                 s_ = s_header_value0;
                 break;
@@ -585,7 +641,7 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
         obs-fold       = CRLF 1*( SP / HTAB ) 
                        ; obsolete line folding
     */
-        case s_header_value0:
+        BEAST_HTTP_STATE(s_header_value0):
             if(ch == ' ' || ch == '\t')
                 break;
             if(ch == '\r')
@@ -601,22 +657,40 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             BOOST_ASSERT(! cb_);
             cb(&self::call_on_value);
             s_ = s_header_value;
-            // fall through
+            BOOST_FALLTHROUGH;
 
-        case s_header_value:
+        BEAST_HTTP_STATE(s_header_value):
         {
+            if(fs_ == h_general)
+            {
+                // Most values need no inspection,
+                // so skip over them in bulk.
+                p = detail::skip_text(p, end);
+                if(p == end)
+                {
+                    --p;
+                    break;
+                }
+                ch = *p;
+                if(BEAST_HTTP_UNLIKELY(ch != '\r'))
+                    return err(parse_error::bad_value);
+                if(BEAST_HTTP_UNLIKELY(cb(nullptr)))
+                    return errc();
+                s_ = s_header_value_lf;
+                break;
+            }
             for(; p != end; ++p)
             {
                 ch = *p;
                 if(ch == '\r')
                 {
-                    if(cb(nullptr))
+                    if(BEAST_HTTP_UNLIKELY(cb(nullptr)))
                         return errc();
                     s_ = s_header_value_lf;
                     break;
                 }
                 auto const c = to_value_char(ch);
-                if(! c)
+                if(BEAST_HTTP_UNLIKELY(! c))
                     return err(parse_error::bad_value);
                 switch(fs_)
                 {
@@ -642,7 +716,7 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
                     default:
                         if(ch == ' ' || ch == '\t' || ch == ',')
                             break;
-                        if(! is_tchar(ch))
+                        if(BEAST_HTTP_UNLIKELY(! is_tchar(ch)))
                             return err(parse_error::bad_value);
                         fs_ = h_connection_token;
                         break;
@@ -768,7 +842,7 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
                     return err(parse_error::bad_value);
 
                 case h_content_length0:
-                    if(! is_digit(ch))
+                    if(BEAST_HTTP_UNLIKELY(! is_digit(ch)))
                         return err(parse_error::bad_content_length);
                     content_length_ = ch - '0';
                     fs_ = h_content_length;
@@ -780,16 +854,17 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
                         fs_ = h_content_length_ows;
                         break;
                     }
-                    if(! is_digit(ch))
+                    if(BEAST_HTTP_UNLIKELY(! is_digit(ch)))
                         return err(parse_error::bad_content_length);
-                    if(content_length_ > (no_content_length - 10) / 10)
+                    if(BEAST_HTTP_UNLIKELY(content_length_ >
+                            (no_content_length - 10) / 10))
                         return err(parse_error::bad_content_length);
                     content_length_ =
                         content_length_ * 10 + ch - '0';
                     break;
 
                 case h_content_length_ows:
-                    if(ch != ' ' && ch != '\t')
+                    if(BEAST_HTTP_UNLIKELY(ch != ' ' && ch != '\t'))
                         return err(parse_error::bad_content_length);
                     break;
 
@@ -834,36 +909,36 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             break;
         }
 
-        case s_header_value0_lf:
-            if(ch != '\n')
+        BEAST_HTTP_STATE(s_header_value0_lf):
+            if(BEAST_HTTP_UNLIKELY(ch != '\n'))
                 return err(parse_error::bad_crlf);
             s_ = s_header_value0_almost_done;
             break;
 
-        case s_header_value0_almost_done:
+        BEAST_HTTP_STATE(s_header_value0_almost_done):
             if(ch == ' ' || ch == '\t')
             {
                 s_ = s_header_value0;
                 break;
             }
-            if(fs_ == h_content_length0)
+            if(BEAST_HTTP_UNLIKELY(fs_ == h_content_length0))
                 return err(parse_error::bad_content_length);
             if(fs_ == h_upgrade)
                 flags_ |= parse_flag::upgrade;
             BOOST_ASSERT(! cb_);
             call_on_value(ec, boost::string_ref{"", 0});
-            if(ec)
+            if(BEAST_HTTP_UNLIKELY(ec))
                 return errc();
             s_ = s_header_name0;
             goto redo;
 
-        case s_header_value_lf:
-            if(ch != '\n')
+        BEAST_HTTP_STATE(s_header_value_lf):
+            if(BEAST_HTTP_UNLIKELY(ch != '\n'))
                 return err(parse_error::bad_crlf);
             s_ = s_header_value_almost_done;
             break;
 
-        case s_header_value_almost_done:
+        BEAST_HTTP_STATE(s_header_value_almost_done):
             if(ch == ' ' || ch == '\t')
             {
                 switch(fs_)
@@ -928,15 +1003,15 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             s_ = s_header_name0;
             goto redo;
 
-        case s_header_value_unfold:
+        BEAST_HTTP_STATE(s_header_value_unfold):
             BOOST_ASSERT(! cb_);
             cb(&self::call_on_value);
             s_ = s_header_value;
             goto redo;
 
-        case s_headers_almost_done:
+        BEAST_HTTP_STATE(s_headers_almost_done):
         {
-            if(ch != '\n')
+            if(BEAST_HTTP_UNLIKELY(ch != '\n'))
                 return err(parse_error::bad_crlf);
             if(flags_ & parse_flag::trailing)
             {
@@ -944,15 +1019,16 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
                 s_ = s_complete;
                 goto redo;
             }
-            if((flags_ & parse_flag::chunked) && (flags_ & parse_flag::contentlength))
+            if(BEAST_HTTP_UNLIKELY((flags_ & parse_flag::chunked) &&
+                    (flags_ & parse_flag::contentlength)))
                 return err(parse_error::illegal_content_length);
             upgrade_ = ((flags_ & (parse_flag::upgrade | parse_flag::connection_upgrade)) ==
                 (parse_flag::upgrade | parse_flag::connection_upgrade)) /*|| method == "connect"*/;
             call_on_headers(ec);
-            if(ec)
+            if(BEAST_HTTP_UNLIKELY(ec))
                 return errc();
             auto const what = call_on_body_what(ec);
-            if(ec)
+            if(BEAST_HTTP_UNLIKELY(ec))
                 return errc();
             switch(what)
             {
@@ -973,10 +1049,10 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             goto redo;
         }
 
-        case s_body_pause:
+        BEAST_HTTP_STATE(s_body_pause):
         {
             auto const what = call_on_body_what(ec);
-            if(ec)
+            if(BEAST_HTTP_UNLIKELY(ec))
                 return errc();
             switch(what)
             {
@@ -993,55 +1069,30 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             }
             --p;
             s_ = s_headers_done;
-            // fall through
+            BOOST_FALLTHROUGH;
         }
 
-        case s_headers_done:
+        BEAST_HTTP_STATE(s_headers_done):
         {
             BOOST_ASSERT(! cb_);
-            if(ec)
+            if(BEAST_HTTP_UNLIKELY(ec))
                 return errc();
-            bool const hasBody =
-                (flags_ & parse_flag::chunked) || (content_length_ > 0 &&
-                    content_length_ != no_content_length);
-            if(upgrade_ && (/*method == "connect" ||*/ (flags_ & parse_flag::skipbody) || ! hasBody))
-            {
-                s_ = s_complete;
-            }
-            else if((flags_ & parse_flag::skipbody) || content_length_ == 0)
-            {
-                s_ = s_complete;
-            }
-            else if(flags_ & parse_flag::chunked)
-            {
-                s_ = s_chunk_size0;
-                break;
-            }
-            else if(content_length_ != no_content_length)
-            {
-                s_ = s_body_identity0;
-                break;
-            }
-            else if(! needs_eof())
-            {
-                s_ = s_complete;
-            }
-            else
-            {
-                s_ = s_body_identity_eof0;
-                break;
-            }
-            goto redo;
+            s_ = body_state();
+            if(s_ == s_complete)
+                goto redo;
+            break;
         }
 
-        case s_body_identity0:
+        BEAST_HTTP_STATE(s_body_identity0):
             BOOST_ASSERT(! cb_);
             cb(&self::call_on_body);
             s_ = s_body_identity;
-            // fall through
+            BOOST_FALLTHROUGH;
 
-        case s_body_identity:
+        BEAST_HTTP_STATE(s_body_identity):
         {
+            if(direct_)
+                return used();
             std::size_t n;
             if(static_cast<std::size_t>((end - p)) < content_length_)
                 n = end - p;
@@ -1059,27 +1110,44 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             break;
         }
 
-        case s_body_identity_eof0:
+        BEAST_HTTP_STATE(s_body_identity_eof0):
             BOOST_ASSERT(! cb_);
             cb(&self::call_on_body);
             s_ = s_body_identity_eof;
-            // fall through
+            BOOST_FALLTHROUGH;
 
-        case s_body_identity_eof:
+        BEAST_HTTP_STATE(s_body_identity_eof):
+            if(direct_)
+                return used();
             p = end - 1;
             break;
 
-        case s_chunk_size0:
+        BEAST_HTTP_STATE(s_chunk_size0):
         {
+            // Fast path when the chunk-size line
+            // without extensions is in the buffer.
+            std::uint64_t size;
+            auto const n =
+                detail::parse_chunk_size(p, end, size);
+            if(n > 0 && p[n] == '\r' &&
+                static_cast<std::size_t>(end - p) > n + 1 &&
+                    p[n + 1] == '\n')
+            {
+                content_length_ = size;
+                p += n + 1;
+                ch = '\n';
+                s_ = s_chunk_size_lf;
+                goto redo;
+            }
             auto v = unhex(ch);
-            if(v == -1)
+            if(BEAST_HTTP_UNLIKELY(v == -1))
                 return err(parse_error::invalid_chunk_size);
             content_length_ = v;
             s_ = s_chunk_size;
             break;
         }
 
-        case s_chunk_size:
+        BEAST_HTTP_STATE(s_chunk_size):
         {
             if(ch == '\r')
             {
@@ -1092,22 +1160,23 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
                 break;
             }
             auto v = unhex(ch);
-            if(v == -1)
+            if(BEAST_HTTP_UNLIKELY(v == -1))
                 return err(parse_error::invalid_chunk_size);
-            if(content_length_ > (no_content_length - 16) / 16)
+            if(BEAST_HTTP_UNLIKELY(content_length_ >
+                    (no_content_length - 16) / 16))
                 return err(parse_error::bad_content_length);
             content_length_ =
                 content_length_ * 16 + v;
             break;
         }
 
-        case s_chunk_ext_name0:
-            if(! is_tchar(ch))
+        BEAST_HTTP_STATE(s_chunk_ext_name0):
+            if(BEAST_HTTP_UNLIKELY(! is_tchar(ch)))
                 return err(parse_error::invalid_ext_name);
             s_ = s_chunk_ext_name;
             break;
 
-        case s_chunk_ext_name:
+        BEAST_HTTP_STATE(s_chunk_ext_name):
             if(ch == '\r')
             {
                 s_ = s_chunk_size_lf;
@@ -1123,11 +1192,11 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
                 s_ = s_chunk_ext_name0;
                 break;
             }
-            if(! is_tchar(ch))
+            if(BEAST_HTTP_UNLIKELY(! is_tchar(ch)))
                 return err(parse_error::invalid_ext_name);
             break;
 
-        case s_chunk_ext_val:
+        BEAST_HTTP_STATE(s_chunk_ext_val):
             if(ch == '\r')
             {
                 s_ = s_chunk_size_lf;
@@ -1135,8 +1204,8 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             }
             break;
 
-        case s_chunk_size_lf:
-            if(ch != '\n')
+        BEAST_HTTP_STATE(s_chunk_size_lf):
+            if(BEAST_HTTP_UNLIKELY(ch != '\n'))
                 return err(parse_error::bad_crlf);
             if(content_length_ == 0)
             {
@@ -1145,17 +1214,27 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
                 break;
             }
             //call_chunk_header(ec); if(ec) return errc();
+            if(direct_)
+            {
+                if(BEAST_HTTP_UNLIKELY(
+                        b_max_ && content_length_ > b_left_))
+                    return err(parse_error::body_too_big);
+                s_ = s_chunk_data;
+                break;
+            }
             s_ = s_chunk_data0;
             break;
 
-        case s_chunk_data0:
+        BEAST_HTTP_STATE(s_chunk_data0):
             BOOST_ASSERT(! cb_);
             cb(&self::call_on_body);
             s_ = s_chunk_data;
             goto redo; // VFALCO fall through?
 
-        case s_chunk_data:
+        BEAST_HTTP_STATE(s_chunk_data):
         {
+            if(direct_)
+                return used();
             std::size_t n;
             if(static_cast<std::size_t>((end - p)) < content_length_)
                 n = end - p;
@@ -1168,31 +1247,37 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
             break;
         }
 
-        case s_chunk_data_cr:
-            if(ch != '\r')
+        BEAST_HTTP_STATE(s_chunk_data_cr):
+            if(BEAST_HTTP_UNLIKELY(ch != '\r'))
                 return err(parse_error::bad_crlf);
-            if(cb(nullptr))
+            if(BEAST_HTTP_UNLIKELY(cb(nullptr)))
                 return errc();
+            if(end - p > 1 && p[1] == '\n')
+            {
+                ++p;
+                s_ = s_chunk_size0;
+                break;
+            }
             s_ = s_chunk_data_lf;
             break;
 
-        case s_chunk_data_lf:
-            if(ch != '\n')
+        BEAST_HTTP_STATE(s_chunk_data_lf):
+            if(BEAST_HTTP_UNLIKELY(ch != '\n'))
                 return err(parse_error::bad_crlf);
             s_ = s_chunk_size0;
             break;
 
-        case s_complete:
+        BEAST_HTTP_STATE(s_complete):
             ++p;
-            if(cb(nullptr))
+            if(BEAST_HTTP_UNLIKELY(cb(nullptr)))
                 return errc();
             call_on_complete(ec);
-            if(ec)
+            if(BEAST_HTTP_UNLIKELY(ec))
                 return errc();
             s_ = s_restart;
             return used();
 
-        case s_restart:
+        BEAST_HTTP_STATE(s_restart):
             if(keep_alive())
                 reset();
             else
@@ -1203,12 +1288,17 @@ write(boost::asio::const_buffer const& buffer, error_code& ec)
     if(cb_)
     {
         (this->*cb_)(ec, piece());
-        if(ec)
+        if(BEAST_HTTP_UNLIKELY(ec))
             return errc();
     }
     return used();
 }
 
+#if BEAST_HTTP_COMPUTED_GOTO
+# pragma GCC diagnostic pop
+#endif
+#undef BEAST_HTTP_STATE
+
 template<bool isRequest, class Derived>
 void
 basic_parser_v1<isRequest, Derived>::
@@ -1243,6 +1333,121 @@ write_eof(error_code& ec)
     }
 }
 
+template<bool isRequest, class Derived>
+void
+basic_parser_v1<isRequest, Derived>::
+resume_direct(error_code& ec)
+{
+    BOOST_ASSERT(s_ == s_body_pause);
+    direct_ = true;
+    switch(body_state())
+    {
+    case s_chunk_size0:
+        s_ = s_chunk_size0;
+        break;
+
+    case s_body_identity0:
+        // The size is known, so enforce the limit now
+        // rather than after the caller allocates storage.
+        if(b_max_ && content_length_ > b_left_)
+        {
+            ec = parse_error::body_too_big;
+            s_ = s_dead;
+            return;
+        }
+        s_ = s_body_identity;
+        break;
+
+    case s_body_identity_eof0:
+        s_ = s_body_identity_eof;
+        break;
+
+    default:
+        finish(ec);
+        break;
+    }
+}
+
+template<bool isRequest, class Derived>
+std::uint64_t
+basic_parser_v1<isRequest, Derived>::
+body_remain() const
+{
+    if(! direct_)
+        return 0;
+    switch(s_)
+    {
+    case s_body_identity:
+    case s_chunk_data:
+        return content_length_;
+
+    case s_body_identity_eof:
+        return no_content_length;
+
+    default:
+        return 0;
+    }
+}
+
+template<bool isRequest, class Derived>
+void
+basic_parser_v1<isRequest, Derived>::
+consume_body(std::size_t n, error_code& ec)
+{
+    BOOST_ASSERT(n <= body_remain());
+    if(b_max_ && n > b_left_)
+    {
+        ec = parse_error::body_too_big;
+        s_ = s_dead;
+        return;
+    }
+    b_left_ -= n;
+    if(s_ == s_body_identity_eof)
+        return;
+    content_length_ -= n;
+    if(content_length_ != 0)
+        return;
+    if(s_ == s_chunk_data)
+        s_ = s_chunk_data_cr;
+    else
+        finish(ec);
+}
+
+template<bool isRequest, class Derived>
+template<class Allocator>
+std::size_t
+basic_parser_v1<isRequest, Derived>::
+write_body(boost::asio::const_buffer const& buffer,
+    std::vector<boost::asio::const_buffer, Allocator>& payload,
+        error_code& ec)
+{
+    using boost::asio::buffer_cast;
+    using boost::asio::buffer_size;
+    BOOST_ASSERT(direct_);
+    auto const begin = buffer_cast<char const*>(buffer);
+    auto const end = begin + buffer_size(buffer);
+    auto p = begin;
+    while(p != end && ! complete())
+    {
+        if(auto const n = body_remain())
+        {
+            auto const m = static_cast<std::size_t>(
+                (std::min<std::uint64_t>)(n, end - p));
+            payload.emplace_back(p, m);
+            p += m;
+            consume_body(m, ec);
+        }
+        else
+        {
+            p += write(boost::asio::const_buffer(
+                p, end - p), ec);
+        }
+        if(ec)
+            break;
+    }
+    return p - begin;
+}
+
 template<bool isRequest, class Derived>
 void
 basic_parser_v1<isRequest, Derived>::
@@ -1251,9 +1456,48 @@ reset()
     cb_ = nullptr;
     h_left_ = h_max_;
     b_left_ = b_max_;
+    fid_ = 0;
+    direct_ = false;
     reset(std::integral_constant<bool, isRequest>{});
 }
 
+template<bool isRequest, class Derived>
+auto
+basic_parser_v1<isRequest, Derived>::
+body_state() const ->
+    state
+{
+    bool const hasBody =
+        (flags_ & parse_flag::chunked) || (content_length_ > 0 &&
+            content_length_ != no_content_length);
+    if(upgrade_ && (/*method == "connect" ||*/ (flags_ & parse_flag::skipbody) || ! hasBody))
+        return s_complete;
+    if((flags_ & parse_flag::skipbody) || content_length_ == 0)
+        return s_complete;
+    if(flags_ & parse_flag::chunked)
+        return s_chunk_size0;
+    if(content_length_ != no_content_length)
+        return s_body_identity0;
+    if(! needs_eof())
+        return s_complete;
+    return s_body_identity_eof0;
+}
+
+template<bool isRequest, class Derived>
+void
+basic_parser_v1<isRequest, Derived>::
+finish(error_code& ec)
+{
+    cb_ = nullptr;
+    call_on_complete(ec);
+    if(ec)
+    {
+        s_ = s_dead;
+        return;
+    }
+    s_ = s_restart;
+}
+
 template<bool isRequest, class Derived>
 bool
 basic_parser_v1<isRequest, Derived>::
@@ -0,0 +1,242 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_IMPL_CACHED_RESPONSE_IPP
+#define BEAST_HTTP_IMPL_CACHED_RESPONSE_IPP
+
+#include <beast/http/concepts.hpp>
+#include <beast/http/write.hpp>
+#include <beast/core/bind_handler.hpp>
+#include <beast/core/handler_alloc.hpp>
+#include <beast/core/stream_concepts.hpp>
+#include <beast/core/detail/ci_char_traits.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/utility/string_ref.hpp>
+
+namespace beast {
+namespace http {
+
+namespace detail {
+
+// Returns the offset of the Date field value in a serialized
+// message, or std::string::npos if there is no usable Date field.
+//
+inline
+std::size_t
+find_date(std::string const& s)
+{
+    // skip the status line
+    auto pos = s.find("\r\n");
+    while(pos != std::string::npos)
+    {
+        pos += 2;
+        auto const end = s.find("\r\n", pos);
+        if(end == std::string::npos || end == pos)
+            break;
+        boost::string_ref const line{&s[pos], end - pos};
+        if(line.size() > 5 &&
+            beast::detail::ci_equal(line.substr(0, 5), "date:"))
+        {
+            auto first = pos + 5;
+            while(first < end && (s[first] == ' ' || s[first] == '\t'))
+                ++first;
+            // Only an IMF-fixdate, as produced by set_date,
+            // may be replaced without changing the size.
+            if(end - first == date_size)
+                return first;
+        }
+        pos = end;
+    }
+    return std::string::npos;
+}
+
+template<class Stream, class Handler>
+class cached_write_op
+{
+    using alloc_type =
+        handler_alloc<char, Handler>;
+
+    struct data
+    {
+        Stream& s;
+        cached_response cr;
+        Handler h;
+        char date[cached_response::date_size];
+        bool cont;
+        int state = 0;
+
+        template<class DeducedHandler>
+        data(DeducedHandler&& h_, Stream& s_,
+                cached_response const& cr_)
+            : s(s_)
+            , cr(cr_)
+            , h(std::forward<DeducedHandler>(h_))
+            , cont(boost_asio_handler_cont_helpers::
+                is_continuation(h))
+        {
+        }
+    };
+
+    std::shared_ptr<data> d_;
+
+public:
+    cached_write_op(cached_write_op&&) = default;
+    cached_write_op(cached_write_op const&) = default;
+
+    template<class DeducedHandler, class... Args>
+    cached_write_op(DeducedHandler&& h, Stream& s, Args&&... args)
+        : d_(std::allocate_shared<data>(alloc_type{h},
+            std::forward<DeducedHandler>(h), s,
+                std::forward<Args>(args)...))
+    {
+        (*this)(error_code{}, 0, false);
+    }
+
+    void
+    operator()(error_code ec,
+        std::size_t bytes_transferred, bool again = true);
+
+    friend
+    void* asio_handler_allocate(
+        std::size_t size, cached_write_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            allocate(size, op->d_->h);
+    }
+
+    friend
+    void asio_handler_deallocate(
+        void* p, std::size_t size, cached_write_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            deallocate(p, size, op->d_->h);
+    }
+
+    friend
+    bool asio_handler_is_continuation(cached_write_op* op)
+    {
+        return op->d_->cont;
+    }
+
+    template<class Function>
+    friend
+    void asio_handler_invoke(Function&& f, cached_write_op* op)
+    {
+        return boost_asio_handler_invoke_helpers::
+            invoke(f, op->d_->h);
+    }
+};
+
+template<class Stream, class Handler>
+void
+cached_write_op<Stream, Handler>::
+operator()(error_code ec, std::size_t, bool again)
+{
+    auto& d = *d_;
+    d.cont = d.cont || again;
+    while(! ec && d.state != 99)
+    {
+        switch(d.state)
+        {
+        case 0:
+            d.state = 1;
+            boost::asio::async_write(d.s,
+                d.cr.buffers(d.date), std::move(*this));
+            return;
+
+        case 1:
+            if(! d.cr.keep_alive())
+                ec = boost::asio::error::eof;
+            d.state = 99;
+            break;
+        }
+    }
+    d.h(ec);
+}
+
+} // detail
+
+template<class Body, class Headers>
+cached_response::
+cached_response(message<false, Body, Headers> const& msg)
+{
+    auto p = std::make_shared<block>();
+    detail::string_SyncStream ss{p->s};
+    error_code ec;
+    write(ss, msg, ec);
+    if(ec == boost::asio::error::eof)
+        p->close = true;
+    else if(ec)
+        throw system_error{ec};
+    p->date = detail::find_date(p->s);
+    p_ = std::move(p);
+}
+
+inline
+auto
+cached_response::
+buffers(char* date) const ->
+    const_buffers_type
+{
+    using boost::asio::const_buffer;
+    auto const& s = p_->s;
+    if(! has_date())
+        return {{const_buffer{s.data(), s.size()},
+            const_buffer{}, const_buffer{}}};
+    detail::date_cache::get().copy(date);
+    auto const pos = p_->date;
+    return {{const_buffer{s.data(), pos},
+        const_buffer{date, date_size},
+        const_buffer{s.data() + pos + date_size,
+            s.size() - pos - date_size}}};
+}
+
+template<class SyncWriteStream>
+void
+write(SyncWriteStream& stream, cached_response const& cr)
+{
+    static_assert(is_SyncWriteStream<SyncWriteStream>::value,
+        "SyncWriteStream requirements not met");
+    error_code ec;
+    write(stream, cr, ec);
+    if(ec)
+        throw system_error{ec};
+}
+
+template<class SyncWriteStream>
+void
+write(SyncWriteStream& stream,
+    cached_response const& cr, error_code& ec)
+{
+    static_assert(is_SyncWriteStream<SyncWriteStream>::value,
+        "SyncWriteStream requirements not met");
+    char date[cached_response::date_size];
+    boost::asio::write(stream, cr.buffers(date), ec);
+    if(! ec && ! cr.keep_alive())
+        ec = boost::asio::error::eof;
+}
+
+template<class AsyncWriteStream, class WriteHandler>
+typename async_completion<
+    WriteHandler, void(error_code)>::result_type
+async_write(AsyncWriteStream& stream,
+    cached_response const& cr, WriteHandler&& handler)
+{
+    static_assert(is_AsyncWriteStream<AsyncWriteStream>::value,
+        "AsyncWriteStream requirements not met");
+    beast::async_completion<WriteHandler,
+        void(error_code)> completion(handler);
+    detail::cached_write_op<AsyncWriteStream,
+        decltype(completion.handler)>{
+            completion.handler, stream, cr};
+    return completion.result.get();
+}
+
+} // http
+} // beast
+
+#endif
@@ -0,0 +1,47 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_IMPL_FIELD_IPP
+#define BEAST_HTTP_IMPL_FIELD_IPP
+
+#include <beast/http/detail/field.hpp>
+
+namespace beast {
+namespace http {
+
+inline
+boost::string_ref
+to_string(field f)
+{
+    auto const i = static_cast<std::size_t>(f);
+    if(i == 0 || i > detail::field_str::size)
+        return {};
+    return {detail::field_str::names[i - 1],
+        detail::field_str::sizes[i - 1]};
+}
+
+inline
+field
+string_to_field(boost::string_ref const& s)
+{
+    using beast::detail::tolower;
+    unsigned i = 0;
+    for(std::size_t pos = 0; pos < s.size(); ++pos)
+    {
+        i = detail::field_match(i, pos, tolower(s[pos]));
+        if(i == 0)
+            return field::unknown;
+    }
+    if(! detail::field_matched(i, s.size()))
+        return field::unknown;
+    return static_cast<field>(i);
+}
+
+} // http
+} // beast
+
+#endif
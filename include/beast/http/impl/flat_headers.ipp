@@ -0,0 +1,331 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_IMPL_FLAT_HEADERS_IPP
+#define BEAST_HTTP_IMPL_FLAT_HEADERS_IPP
+
+#include <beast/http/detail/rfc7230.hpp>
+#include <beast/core/detail/ci_char_traits.hpp>
+#include <boost/assert.hpp>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace beast {
+namespace http {
+
+template<class Allocator>
+class basic_flat_headers<Allocator>::const_iterator
+{
+    using iter_type = entry const*;
+
+    basic_flat_headers const* h_ = nullptr;
+    iter_type it_ = nullptr;
+
+    friend class basic_flat_headers;
+
+    const_iterator(basic_flat_headers const& h, iter_type it)
+        : h_(&h)
+        , it_(it)
+    {
+    }
+
+public:
+    using value_type =
+        typename basic_flat_headers::value_type;
+    using pointer = value_type const*;
+    using reference = value_type;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category =
+        std::forward_iterator_tag;
+
+    const_iterator() = default;
+    const_iterator(const_iterator&& other) = default;
+    const_iterator(const_iterator const& other) = default;
+    const_iterator& operator=(const_iterator&& other) = default;
+    const_iterator& operator=(const_iterator const& other) = default;
+
+    bool
+    operator==(const_iterator const& other) const
+    {
+        return it_ == other.it_;
+    }
+
+    bool
+    operator!=(const_iterator const& other) const
+    {
+        return !(*this == other);
+    }
+
+    reference
+    operator*() const
+    {
+        return h_->get(*it_);
+    }
+
+    const_iterator&
+    operator++()
+    {
+        ++it_;
+        return *this;
+    }
+
+    const_iterator
+    operator++(int)
+    {
+        auto temp = *this;
+        ++(*this);
+        return temp;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+template<class Allocator>
+basic_flat_headers<Allocator>::
+basic_flat_headers(basic_flat_headers&& other)
+    : buf_(std::move(other.buf_))
+    , index_(std::move(other.index_))
+    , unused_(other.unused_)
+{
+    other.clear();
+}
+
+template<class Allocator>
+auto
+basic_flat_headers<Allocator>::
+operator=(basic_flat_headers&& other) ->
+    basic_flat_headers&
+{
+    if(this == &other)
+        return *this;
+    buf_ = std::move(other.buf_);
+    index_ = std::move(other.index_);
+    unused_ = other.unused_;
+    other.clear();
+    return *this;
+}
+
+template<class Allocator>
+template<class FwdIt>
+basic_flat_headers<Allocator>::
+basic_flat_headers(FwdIt first, FwdIt last)
+{
+    for(;first != last; ++first)
+        insert((*first).name(), (*first).value());
+}
+
+template<class Allocator>
+auto
+basic_flat_headers<Allocator>::
+begin() const ->
+    const_iterator
+{
+    return {*this, index_.data()};
+}
+
+template<class Allocator>
+auto
+basic_flat_headers<Allocator>::
+end() const ->
+    const_iterator
+{
+    return {*this, index_.data() + index_.size()};
+}
+
+template<class Allocator>
+std::size_t
+basic_flat_headers<Allocator>::
+count(boost::string_ref const& name) const
+{
+    auto const id = string_to_field(name);
+    std::size_t n = 0;
+    for(auto const& e : index_)
+        if(match(e, id, name))
+            ++n;
+    return n;
+}
+
+template<class Allocator>
+std::size_t
+basic_flat_headers<Allocator>::
+count(field f) const
+{
+    if(f == field::unknown)
+        return 0;
+    std::size_t n = 0;
+    for(auto const& e : index_)
+        if(e.id == f)
+            ++n;
+    return n;
+}
+
+template<class Allocator>
+auto
+basic_flat_headers<Allocator>::
+find(boost::string_ref const& name) const ->
+    iterator
+{
+    auto const id = string_to_field(name);
+    for(auto const& e : index_)
+        if(match(e, id, name))
+            return {*this, &e};
+    return end();
+}
+
+template<class Allocator>
+auto
+basic_flat_headers<Allocator>::
+find(field f) const ->
+    iterator
+{
+    if(f == field::unknown)
+        return end();
+    for(auto const& e : index_)
+        if(e.id == f)
+            return {*this, &e};
+    return end();
+}
+
+template<class Allocator>
+boost::string_ref
+basic_flat_headers<Allocator>::
+operator[](boost::string_ref const& name) const
+{
+    auto const it = find(name);
+    if(it == end())
+        return {};
+    return (*it).second;
+}
+
+template<class Allocator>
+boost::string_ref
+basic_flat_headers<Allocator>::
+operator[](field f) const
+{
+    auto const it = find(f);
+    if(it == end())
+        return {};
+    return (*it).second;
+}
+
+template<class Allocator>
+std::size_t
+basic_flat_headers<Allocator>::
+erase(boost::string_ref const& name)
+{
+    auto const id = string_to_field(name);
+    std::size_t n = 0;
+    auto const it = std::remove_if(
+        index_.begin(), index_.end(),
+        [&](entry const& e)
+        {
+            if(! match(e, id, name))
+                return false;
+            unused_ += e.name_size + e.value_size;
+            ++n;
+            return true;
+        });
+    index_.erase(it, index_.end());
+    if(unused_ > buf_.size() - unused_)
+        compact();
+    return n;
+}
+
+template<class Allocator>
+void
+basic_flat_headers<Allocator>::
+insert(boost::string_ref const& name,
+    boost::string_ref value)
+{
+    value = detail::trim(value);
+    if(overlaps(name) || overlaps(value))
+    {
+        // The buffer may be reallocated below
+        std::string const s0(name.data(), name.size());
+        std::string const s1(value.data(), value.size());
+        return insert(s0, s1);
+    }
+    if(buf_.size() + name.size() + value.size() >
+            (std::numeric_limits<std::uint32_t>::max)())
+        throw std::length_error("flat_headers overflow");
+    entry const e{
+        static_cast<std::uint32_t>(buf_.size()),
+        static_cast<std::uint32_t>(name.size()),
+        static_cast<std::uint32_t>(value.size()),
+        string_to_field(name)};
+    buf_.insert(buf_.end(), name.begin(), name.end());
+    buf_.insert(buf_.end(), value.begin(), value.end());
+    index_.push_back(e);
+}
+
+template<class Allocator>
+void
+basic_flat_headers<Allocator>::
+insert(field f, boost::string_ref value)
+{
+    BOOST_ASSERT(f != field::unknown);
+    insert(to_string(f), value);
+}
+
+template<class Allocator>
+void
+basic_flat_headers<Allocator>::
+replace(boost::string_ref const& name,
+    boost::string_ref value)
+{
+    value = detail::trim(value);
+    if(overlaps(name) || overlaps(value))
+    {
+        // erase may overwrite the buffer
+        std::string const s0(name.data(), name.size());
+        std::string const s1(value.data(), value.size());
+        return replace(s0, s1);
+    }
+    erase(name);
+    insert(name, value);
+}
+
+template<class Allocator>
+bool
+basic_flat_headers<Allocator>::
+match(entry const& e, field id,
+    boost::string_ref const& name) const
+{
+    // Well-known names compare without
+    // examining the characters.
+    if(id != field::unknown)
+        return e.id == id;
+    return e.id == field::unknown &&
+        e.name_size == name.size() &&
+        beast::detail::ci_equal(get(e).first, name);
+}
+
+template<class Allocator>
+void
+basic_flat_headers<Allocator>::
+compact()
+{
+    // Entries are in order of increasing offset,
+    // so the buffer can be compacted in place.
+    std::uint32_t offset = 0;
+    for(auto& e : index_)
+    {
+        auto const first = buf_.begin() + e.offset;
+        std::copy(first, first + e.name_size + e.value_size,
+            buf_.begin() + offset);
+        e.offset = offset;
+        offset += e.name_size + e.value_size;
+    }
+    buf_.resize(offset);
+    unused_ = 0;
+}
+
+} // http
+} // beast
+
+#endif
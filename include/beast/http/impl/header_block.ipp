@@ -0,0 +1,215 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_IMPL_HEADER_BLOCK_IPP
+#define BEAST_HTTP_IMPL_HEADER_BLOCK_IPP
+
+#include <beast/http/detail/rfc7230.hpp>
+#include <beast/core/detail/ci_char_traits.hpp>
+
+namespace beast {
+namespace http {
+
+template<class Allocator>
+class basic_header_block<Allocator>::const_iterator
+{
+    using iter_type = entry const*;
+
+    basic_header_block const* h_ = nullptr;
+    iter_type it_ = nullptr;
+
+    friend class basic_header_block;
+
+    const_iterator(basic_header_block const& h, iter_type it)
+        : h_(&h)
+        , it_(it)
+    {
+    }
+
+public:
+    using value_type =
+        typename basic_header_block::value_type;
+    using pointer = value_type const*;
+    using reference = value_type;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category =
+        std::forward_iterator_tag;
+
+    const_iterator() = default;
+    const_iterator(const_iterator&& other) = default;
+    const_iterator(const_iterator const& other) = default;
+    const_iterator& operator=(const_iterator&& other) = default;
+    const_iterator& operator=(const_iterator const& other) = default;
+
+    bool
+    operator==(const_iterator const& other) const
+    {
+        return it_ == other.it_;
+    }
+
+    bool
+    operator!=(const_iterator const& other) const
+    {
+        return !(*this == other);
+    }
+
+    reference
+    operator*() const
+    {
+        return h_->get(*it_);
+    }
+
+    const_iterator&
+    operator++()
+    {
+        ++it_;
+        return *this;
+    }
+
+    const_iterator
+    operator++(int)
+    {
+        auto temp = *this;
+        ++(*this);
+        return temp;
+    }
+};
+
+//------------------------------------------------------------------------------
+
+template<class Allocator>
+auto
+basic_header_block<Allocator>::
+begin() const ->
+    const_iterator
+{
+    return {*this, index_.data()};
+}
+
+template<class Allocator>
+auto
+basic_header_block<Allocator>::
+end() const ->
+    const_iterator
+{
+    return {*this, index_.data() + index_.size()};
+}
+
+template<class Allocator>
+std::size_t
+basic_header_block<Allocator>::
+count(boost::string_ref const& name) const
+{
+    using beast::detail::ci_equal;
+    std::size_t n = 0;
+    for(auto const& e : index_)
+        if(e.name_size == name.size() &&
+                ci_equal(get(e).first, name))
+            ++n;
+    return n;
+}
+
+template<class Allocator>
+auto
+basic_header_block<Allocator>::
+find(boost::string_ref const& name) const ->
+    iterator
+{
+    using beast::detail::ci_equal;
+    for(auto const& e : index_)
+        if(e.name_size == name.size() &&
+                ci_equal(get(e).first, name))
+            return {*this, &e};
+    return end();
+}
+
+template<class Allocator>
+boost::string_ref
+basic_header_block<Allocator>::
+operator[](boost::string_ref const& name) const
+{
+    auto const it = find(name);
+    if(it == end())
+        return {};
+    return (*it).second;
+}
+
+template<class Allocator>
+void
+basic_header_block<Allocator>::
+insert(boost::string_ref const& name,
+    boost::string_ref value)
+{
+    value = detail::trim(value);
+    begin_name();
+    append_name(name);
+    begin_value();
+    append_value(value);
+    end_field();
+}
+
+template<class Allocator>
+void
+basic_header_block<Allocator>::
+begin_name()
+{
+    index_.push_back({
+        static_cast<std::uint32_t>(buf_.size()), 0, 0, 0});
+}
+
+template<class Allocator>
+void
+basic_header_block<Allocator>::
+append_name(boost::string_ref const& s)
+{
+    append(s);
+    index_.back().name_size +=
+        static_cast<std::uint32_t>(s.size());
+}
+
+template<class Allocator>
+void
+basic_header_block<Allocator>::
+begin_value()
+{
+    append(": ");
+    index_.back().value =
+        static_cast<std::uint32_t>(buf_.size());
+}
+
+template<class Allocator>
+void
+basic_header_block<Allocator>::
+append_value(boost::string_ref const& s)
+{
+    append(s);
+    index_.back().value_size +=
+        static_cast<std::uint32_t>(s.size());
+}
+
+template<class Allocator>
+void
+basic_header_block<Allocator>::
+end_field()
+{
+    auto& e = index_.back();
+    // Remove trailing whitespace from the value
+    while(e.value_size > 0)
+    {
+        auto const c = buf_.back();
+        if(c != ' ' && c != '\t')
+            break;
+        buf_.pop_back();
+        --e.value_size;
+    }
+    append("\r\n");
+}
+
+} // http
+} // beast
+
+#endif
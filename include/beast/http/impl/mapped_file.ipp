@@ -0,0 +1,255 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_IMPL_MAPPED_FILE_IPP
+#define BEAST_HTTP_IMPL_MAPPED_FILE_IPP
+
+#include <cerrno>
+#include <cstdio>
+#include <sys/stat.h>
+#include <sys/types.h>
+#if BEAST_HTTP_DETAIL_MMAP
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+
+namespace beast {
+namespace http {
+
+namespace detail {
+
+inline
+error_code
+last_error()
+{
+    return errc::make_error_code(
+        static_cast<errc::errc_t>(errno));
+}
+
+// Returns the modification time of a file in nanoseconds,
+// with the resolution the file system provides
+template<class Stat>
+std::uint64_t
+file_mtime(Stat const& st)
+{
+#if defined(__APPLE__)
+    return static_cast<std::uint64_t>(st.st_mtimespec.tv_sec) *
+        1000000000 + st.st_mtimespec.tv_nsec;
+#elif defined(_WIN32)
+    return static_cast<std::uint64_t>(st.st_mtime) * 1000000000;
+#else
+    return static_cast<std::uint64_t>(st.st_mtim.tv_sec) *
+        1000000000 + st.st_mtim.tv_nsec;
+#endif
+}
+
+// Returns the size and modification time of a file
+inline
+void
+stat_file(std::string const& path,
+    std::uint64_t& size, std::uint64_t& mtime,
+        error_code& ec)
+{
+#ifdef _MSC_VER
+    struct _stat64 st;
+    if(_stat64(path.c_str(), &st) != 0)
+#else
+    struct stat st;
+    if(::stat(path.c_str(), &st) != 0)
+#endif
+    {
+        ec = last_error();
+        return;
+    }
+    size = static_cast<std::uint64_t>(st.st_size);
+    mtime = file_mtime(st);
+    ec = {};
+}
+
+} // detail
+
+inline
+mapped_file::
+~mapped_file()
+{
+    close();
+}
+
+inline
+void
+mapped_file::
+open(std::string const& path, error_code& ec)
+{
+    close();
+#if BEAST_HTTP_DETAIL_MMAP
+    auto const fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0)
+    {
+        ec = detail::last_error();
+        return;
+    }
+    struct stat st;
+    if(::fstat(fd, &st) != 0)
+    {
+        ec = detail::last_error();
+        ::close(fd);
+        return;
+    }
+    auto const size = static_cast<std::size_t>(st.st_size);
+    if(size > 0)
+    {
+        auto const p = ::mmap(nullptr, size,
+            PROT_READ, MAP_SHARED, fd, 0);
+        if(p == MAP_FAILED)
+        {
+            ec = detail::last_error();
+            ::close(fd);
+            return;
+        }
+        data_ = p;
+    }
+    // The mapping remains valid after the descriptor is closed
+    ::close(fd);
+    size_ = size;
+    mtime_ = detail::file_mtime(st);
+    ec = {};
+#else
+    std::uint64_t size = 0;
+    std::uint64_t mtime = 0;
+    detail::stat_file(path, size, mtime, ec);
+    if(ec)
+        return;
+    auto const f = std::fopen(path.c_str(), "rb");
+    if(! f)
+    {
+        ec = detail::last_error();
+        return;
+    }
+    buf_.reset(new char[static_cast<std::size_t>(size)]);
+    auto const n = std::fread(buf_.get(), 1,
+        static_cast<std::size_t>(size), f);
+    std::fclose(f);
+    if(n != size)
+    {
+        buf_.reset();
+        ec = errc::make_error_code(errc::io_error);
+        return;
+    }
+    data_ = buf_.get();
+    size_ = static_cast<std::size_t>(size);
+    mtime_ = mtime;
+    ec = {};
+#endif
+}
+
+inline
+void
+mapped_file::
+close()
+{
+#if BEAST_HTTP_DETAIL_MMAP
+    if(data_)
+        ::munmap(const_cast<void*>(data_), size_);
+#else
+    buf_.reset();
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mtime_ = 0;
+}
+
+//------------------------------------------------------------------------------
+
+inline
+mapped_file_cache::
+mapped_file_cache(std::size_t capacity)
+    : capacity_(capacity)
+{
+}
+
+inline
+std::size_t
+mapped_file_cache::
+size() const
+{
+    std::lock_guard<std::mutex> lock(m_);
+    return list_.size();
+}
+
+inline
+std::shared_ptr<mapped_file const>
+mapped_file_cache::
+get(std::string const& path, error_code& ec)
+{
+    std::uint64_t size = 0;
+    std::uint64_t mtime = 0;
+    detail::stat_file(path, size, mtime, ec);
+    if(ec)
+        return nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_);
+        auto const it = map_.find(path);
+        if(it != map_.end())
+        {
+            auto const& file = *it->second->file;
+            if(file.size() == size && file.mtime() == mtime)
+            {
+                // move to the front
+                list_.splice(list_.begin(), list_, it->second);
+                return it->second->file;
+            }
+        }
+    }
+    // Open outside the lock, so that lookups of other
+    // files are not held up while this one is mapped.
+    auto file = std::make_shared<mapped_file>();
+    file->open(path, ec);
+    if(ec)
+        return nullptr;
+    if(capacity_ == 0)
+        return file;
+    std::lock_guard<std::mutex> lock(m_);
+    auto const it = map_.find(path);
+    if(it != map_.end())
+    {
+        auto const& other = *it->second->file;
+        if(other.size() == file->size() &&
+            other.mtime() == file->mtime())
+        {
+            // Another thread mapped the same file first
+            list_.splice(list_.begin(), list_, it->second);
+            return it->second->file;
+        }
+        list_.erase(it->second);
+        map_.erase(it);
+    }
+    if(list_.size() >= capacity_)
+    {
+        // evict the least recently used
+        map_.erase(list_.back().path);
+        list_.pop_back();
+    }
+    list_.push_front(entry{path, file});
+    map_.emplace(path, list_.begin());
+    return file;
+}
+
+inline
+void
+mapped_file_cache::
+clear()
+{
+    std::lock_guard<std::mutex> lock(m_);
+    map_.clear();
+    list_.clear();
+}
+
+} // http
+} // beast
+
+#endif
@@ -113,27 +113,16 @@ prepare_content_length(prepare_info& pi,
     pi.content_length = boost::none;
 }
 
-} // detail
-
+// Sets the fields once the content length is known
+//
 template<
     bool isRequest, class Body, class Headers,
     class... Options>
 void
-prepare(message<isRequest, Body, Headers>& msg,
-    Options&&... options)
+prepare_fields(message<isRequest, Body, Headers>& msg,
+    prepare_info& pi, Options&&... options)
 {
-    // VFALCO TODO
-    static_assert(is_Body<Body>::value,
-        "Body requirements not met");
-    static_assert(has_writer<Body>::value,
-        "Body has no writer");
-    static_assert(is_Writer<typename Body::writer,
-        message<isRequest, Body, Headers>>::value,
-            "Writer requirements not met");
-    detail::prepare_info pi;
-    detail::prepare_content_length(pi, msg,
-        detail::has_content_length<typename Body::writer>{});
-    detail::prepare_options(pi, msg,
+    prepare_options(pi, msg,
         std::forward<Options>(options)...);
 
     if(msg.headers.exists("Connection"))
@@ -156,7 +145,7 @@ prepare(message<isRequest, Body, Headers>& msg,
             {
                 void
                 operator()(message<true, Body, Headers>& msg,
-                    detail::prepare_info const& pi) const
+                    prepare_info const& pi) const
                 {
                     using beast::detail::ci_equal;
                     if(*pi.content_length > 0 ||
@@ -169,7 +158,7 @@ prepare(message<isRequest, Body, Headers>& msg,
 
                 void
                 operator()(message<false, Body, Headers>& msg,
-                    detail::prepare_info const& pi) const
+                    prepare_info const& pi) const
                 {
                     if((msg.status / 100 ) != 1 &&
                         msg.status != 204 &&
@@ -221,6 +210,30 @@ prepare(message<isRequest, Body, Headers>& msg,
             "invalid version for Connection: upgrade");
 }
 
+} // detail
+
+template<
+    bool isRequest, class Body, class Headers,
+    class... Options>
+void
+prepare(message<isRequest, Body, Headers>& msg,
+    Options&&... options)
+{
+    // VFALCO TODO
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_writer<Body>::value,
+        "Body has no writer");
+    static_assert(is_Writer<typename Body::writer,
+        message<isRequest, Body, Headers>>::value,
+            "Writer requirements not met");
+    detail::prepare_info pi;
+    detail::prepare_content_length(pi, msg,
+        detail::has_content_length<typename Body::writer>{});
+    detail::prepare_fields(msg, pi,
+        std::forward<Options>(options)...);
+}
+
 } // http
 } // beast
 
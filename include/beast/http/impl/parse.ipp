@@ -9,16 +9,49 @@
 #define BEAST_HTTP_IMPL_PARSE_IPP_HPP
 
 #include <beast/http/concepts.hpp>
+#include <beast/http/detail/inline_handler.hpp>
 #include <beast/core/bind_handler.hpp>
 #include <beast/core/handler_alloc.hpp>
 #include <beast/core/stream_concepts.hpp>
 #include <boost/assert.hpp>
+#include <cstddef>
 
 namespace beast {
 namespace http {
 
 namespace detail {
 
+// Counts the handlers invoked inline by parse_op
+// on the calling thread, which are still running.
+//
+class parse_depth
+{
+public:
+    // The most handlers which may be nested
+    static std::size_t constexpr limit = 8;
+
+    parse_depth()
+    {
+        ++value();
+    }
+
+    ~parse_depth()
+    {
+        --value();
+    }
+
+    parse_depth(parse_depth const&) = delete;
+    parse_depth& operator=(parse_depth const&) = delete;
+
+    static
+    std::size_t&
+    value()
+    {
+        static thread_local std::size_t n = 0;
+        return n;
+    }
+};
+
 template<class Stream,
     class DynamicBuffer, class Parser, class Handler>
 class parse_op
@@ -33,6 +66,7 @@ class parse_op
         Parser& p;
         Handler h;
         bool got_some = false;
+        bool inline_ok;
         bool cont;
         int state = 0;
 
@@ -43,6 +77,7 @@ class parse_op
             , db(sb_)
             , p(p_)
             , h(std::forward<DeducedHandler>(h_))
+            , inline_ok(inline_allowed(h))
             , cont(boost_asio_handler_cont_helpers::
                 is_continuation(h))
         {
@@ -52,6 +87,27 @@ class parse_op
 
     std::shared_ptr<data> d_;
 
+    // Invoke the handler for a message
+    // which completed without reading.
+    void
+    complete(error_code const& ec)
+    {
+        auto& ios = d_->s.get_io_service();
+        // A handler wrapped by allow_inline may be invoked
+        // inline. The depth is bounded, since a handler which
+        // starts another parse can complete inline again.
+        if(d_->inline_ok &&
+            parse_depth::value() < parse_depth::limit)
+        {
+            parse_depth guard;
+            ios.dispatch(bind_handler(std::move(*this), ec, 0));
+        }
+        else
+        {
+            ios.post(bind_handler(std::move(*this), ec, 0));
+        }
+    }
+
 public:
     parse_op(parse_op&&) = default;
     parse_op(parse_op const&) = default;
@@ -121,8 +177,7 @@ operator()(error_code ec, std::size_t bytes_transferred, bool again)
             {
                 // call handler
                 d.state = 99;
-                d.s.get_io_service().post(
-                    bind_handler(std::move(*this), ec, 0));
+                complete(ec);
                 return;
             }
             if(used > 0)
@@ -134,8 +189,7 @@ operator()(error_code ec, std::size_t bytes_transferred, bool again)
             {
                 // call handler
                 d.state = 99;
-                d.s.get_io_service().post(
-                    bind_handler(std::move(*this), ec, 0));
+                complete(ec);
                 return;
             }
             // Buffer must be empty,
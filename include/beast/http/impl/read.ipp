@@ -9,12 +9,22 @@
 #define BEAST_HTTP_IMPL_READ_IPP_HPP
 
 #include <beast/http/concepts.hpp>
+#include <beast/http/detail/inline_handler.hpp>
 #include <beast/http/parse.hpp>
+#include <beast/http/headers_parser_v1.hpp>
 #include <beast/http/parser_v1.hpp>
 #include <beast/core/bind_handler.hpp>
+#include <beast/core/consuming_buffers.hpp>
 #include <beast/core/handler_alloc.hpp>
 #include <beast/core/stream_concepts.hpp>
+#include <boost/asio/read.hpp>
 #include <boost/assert.hpp>
+#include <boost/optional.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
 namespace beast {
 namespace http {
@@ -99,6 +109,12 @@ public:
         return op->d_->cont;
     }
 
+    friend
+    bool allow_inline_hook(read_op* op)
+    {
+        return inline_allowed(op->d_->h);
+    }
+
     template<class Function>
     friend
     void asio_handler_invoke(Function&& f, read_op* op)
@@ -136,6 +152,537 @@ operator()(error_code ec, bool again)
     d.h(ec);
 }
 
+// The number of octets to read directly into the body in one
+// step. When the parser limits the body, the announced size was
+// checked against the limit and is read in one step. Otherwise
+// the step grows with the body octets received so far, so that
+// a large body takes few reads while storage still grows with
+// the octets received, not with the size announced by the peer.
+//
+template<class Parser>
+std::size_t
+direct_size(Parser const& p,
+    std::size_t buffered, std::uint64_t received)
+{
+    auto const remain = p.body_remain();
+    if(remain == no_content_length)
+    {
+        if(buffered > 0)
+            return buffered;
+        return static_cast<std::size_t>(
+            (std::max<std::uint64_t>)(received, 65536));
+    }
+    if(p.body_limit() != 0)
+        return static_cast<std::size_t>(remain);
+    auto const step = (std::max<std::uint64_t>)(
+        (std::max<std::uint64_t>)(buffered, received), 65536);
+    return static_cast<std::size_t>(
+        (std::min<std::uint64_t>)(remain, step));
+}
+
+// Append trailers received after the body was read
+//
+template<class Headers, class Parser>
+void
+merge_trailers(Headers& h, Parser& p)
+{
+    for(auto const& f : p.get().headers)
+        h.insert(f.name(), f.value());
+}
+
+// Read a message whose reader can supply storage for the
+// body. Once the headers are parsed, body octets go straight
+// from the stream into the reader. Only chunk headers and
+// trailers pass through the parser.
+//
+template<class Stream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers,
+        class Handler>
+class read_direct_op
+{
+    using alloc_type =
+        handler_alloc<char, Handler>;
+
+    using parser_type =
+        headers_parser_v1<isRequest, Headers>;
+
+    using message_type =
+        message<isRequest, Body, Headers>;
+
+    using reader_type =
+        typename Body::reader;
+
+    struct data
+    {
+        Stream& s;
+        DynamicBuffer& db;
+        message_type& m;
+        parser_type p;
+        message_type mp;
+        boost::optional<reader_type> r;
+        Handler h;
+        std::uint64_t received = 0;
+        std::size_t copied = 0;
+        bool cont;
+        int state = 0;
+
+        template<class DeducedHandler>
+        data(DeducedHandler&& h_, Stream& s_,
+                DynamicBuffer& sb_, message_type& m_)
+            : s(s_)
+            , db(sb_)
+            , m(m_)
+            , h(std::forward<DeducedHandler>(h_))
+            , cont(boost_asio_handler_cont_helpers::
+                is_continuation(h))
+        {
+        }
+    };
+
+    std::shared_ptr<data> d_;
+
+public:
+    read_direct_op(read_direct_op&&) = default;
+    read_direct_op(read_direct_op const&) = default;
+
+    template<class DeducedHandler, class... Args>
+    read_direct_op(DeducedHandler&& h, Stream& s, Args&&... args)
+        : d_(std::allocate_shared<data>(alloc_type{h},
+            std::forward<DeducedHandler>(h), s,
+                std::forward<Args>(args)...))
+    {
+        (*this)(error_code{}, 0, false);
+    }
+
+    void
+    operator()(error_code ec)
+    {
+        (*this)(ec, 0);
+    }
+
+    void
+    operator()(error_code ec,
+        std::size_t bytes_transferred, bool again = true);
+
+    friend
+    void* asio_handler_allocate(
+        std::size_t size, read_direct_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            allocate(size, op->d_->h);
+    }
+
+    friend
+    void asio_handler_deallocate(
+        void* p, std::size_t size, read_direct_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            deallocate(p, size, op->d_->h);
+    }
+
+    friend
+    bool asio_handler_is_continuation(read_direct_op* op)
+    {
+        return op->d_->cont;
+    }
+
+    friend
+    bool allow_inline_hook(read_direct_op* op)
+    {
+        return inline_allowed(op->d_->h);
+    }
+
+    template<class Function>
+    friend
+    void asio_handler_invoke(Function&& f, read_direct_op* op)
+    {
+        return boost_asio_handler_invoke_helpers::
+            invoke(f, op->d_->h);
+    }
+};
+
+template<class Stream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers,
+        class Handler>
+void
+read_direct_op<Stream, DynamicBuffer,
+    isRequest, Body, Headers, Handler>::
+operator()(error_code ec,
+    std::size_t bytes_transferred, bool again)
+{
+    using boost::asio::buffer_copy;
+    auto& d = *d_;
+    d.cont = d.cont || again;
+    while(d.state != 99)
+    {
+        switch(d.state)
+        {
+        case 0:
+            d.state = 1;
+            async_parse(d.s, d.db, d.p, std::move(*this));
+            return;
+
+        case 1:
+            if(ec)
+                break;
+            d.mp = message_type{d.p.release()};
+            d.r.emplace(d.mp);
+            d.r->init(ec);
+            if(ec)
+                break;
+            d.p.resume_direct(ec);
+            d.state = 2;
+            break;
+
+        case 2:
+        {
+            if(d.p.complete())
+            {
+                // call handler
+                d.state = 99;
+                merge_trailers(d.mp.headers, d.p);
+                d.m = std::move(d.mp);
+                break;
+            }
+            auto const remain = d.p.body_remain();
+            if(remain == 0)
+            {
+                // Chunk headers and trailers
+                if(d.db.size() == 0)
+                {
+                    d.state = 3;
+                    d.s.async_read_some(d.db.prepare(
+                        read_size_helper(d.db, 65536)),
+                            std::move(*this));
+                    return;
+                }
+                d.db.consume(d.p.write(d.db.data(), ec));
+                break;
+            }
+            auto const n = direct_size(
+                d.p, d.db.size(), d.received);
+            auto const b = d.r->prepare(n, ec);
+            if(ec)
+                break;
+            d.copied = buffer_copy(b, d.db.data());
+            d.db.consume(d.copied);
+            if(d.copied == n || (d.copied > 0 &&
+                remain == no_content_length))
+            {
+                d.r->commit(d.copied, ec);
+                if(! ec)
+                    d.p.consume_body(d.copied, ec);
+                d.received += d.copied;
+                break;
+            }
+            d.state = 4;
+            if(remain == no_content_length)
+            {
+                d.s.async_read_some(b, std::move(*this));
+                return;
+            }
+            consuming_buffers<typename std::decay<
+                decltype(b)>::type> cb{b};
+            cb.consume(d.copied);
+            boost::asio::async_read(
+                d.s, cb, std::move(*this));
+            return;
+        }
+
+        // got framing
+        case 3:
+            d.state = 2;
+            if(ec == boost::asio::error::eof)
+            {
+                ec = {};
+                d.p.write_eof(ec);
+                break;
+            }
+            if(ec)
+                break;
+            d.db.commit(bytes_transferred);
+            d.db.consume(d.p.write(d.db.data(), ec));
+            break;
+
+        // got body
+        case 4:
+        {
+            d.state = 2;
+            error_code ev;
+            auto const bytes = d.copied + bytes_transferred;
+            d.r->commit(bytes, ev);
+            if(! ev)
+                d.p.consume_body(bytes, ev);
+            if(ev)
+            {
+                ec = ev;
+                break;
+            }
+            d.received += bytes;
+            if(ec == boost::asio::error::eof)
+            {
+                ec = {};
+                d.p.write_eof(ec);
+            }
+            break;
+        }
+        }
+        // Reads which complete with an error, including
+        // eof, are handled above before the loop exits.
+        if(ec)
+            break;
+    }
+    d.h(ec);
+}
+
+template<class SyncReadStream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers>
+void
+read(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    message<isRequest, Body, Headers>& msg,
+        error_code& ec, std::false_type)
+{
+    parser_v1<isRequest, Body, Headers> p;
+    beast::http::parse(stream, dynabuf, p, ec);
+    if(ec)
+        return;
+    BOOST_ASSERT(p.complete());
+    msg = p.release();
+}
+
+template<class SyncReadStream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers>
+void
+read(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    message<isRequest, Body, Headers>& msg,
+        error_code& ec, std::true_type)
+{
+    using boost::asio::buffer_copy;
+    headers_parser_v1<isRequest, Headers> p;
+    beast::http::parse(stream, dynabuf, p, ec);
+    if(ec)
+        return;
+    message<isRequest, Body, Headers> m{p.release()};
+    typename Body::reader r{m};
+    r.init(ec);
+    if(ec)
+        return;
+    p.resume_direct(ec);
+    std::uint64_t received = 0;
+    while(! ec && ! p.complete())
+    {
+        auto const remain = p.body_remain();
+        if(remain == 0)
+        {
+            // Chunk headers and trailers
+            if(dynabuf.size() == 0)
+            {
+                dynabuf.commit(stream.read_some(
+                    dynabuf.prepare(read_size_helper(
+                        dynabuf, 65536)), ec));
+                if(ec == boost::asio::error::eof)
+                {
+                    ec = {};
+                    p.write_eof(ec);
+                    break;
+                }
+                if(ec)
+                    break;
+            }
+            dynabuf.consume(p.write(dynabuf.data(), ec));
+            continue;
+        }
+        auto const n = direct_size(
+            p, dynabuf.size(), received);
+        auto const b = r.prepare(n, ec);
+        if(ec)
+            break;
+        auto bytes = buffer_copy(b, dynabuf.data());
+        dynabuf.consume(bytes);
+        if(remain == no_content_length)
+        {
+            if(bytes == 0)
+                bytes = stream.read_some(b, ec);
+        }
+        else if(bytes < n)
+        {
+            consuming_buffers<typename std::decay<
+                decltype(b)>::type> cb{b};
+            cb.consume(bytes);
+            bytes += boost::asio::read(stream, cb, ec);
+        }
+        error_code ev;
+        r.commit(bytes, ev);
+        if(! ev)
+            p.consume_body(bytes, ev);
+        if(ev)
+        {
+            ec = ev;
+            break;
+        }
+        received += bytes;
+        if(ec == boost::asio::error::eof)
+        {
+            ec = {};
+            p.write_eof(ec);
+        }
+    }
+    if(ec)
+        return;
+    merge_trailers(m.headers, p);
+    msg = std::move(m);
+}
+
+// Parse the complete messages remaining in the buffer
+// after the first message of a batch.
+//
+template<class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+read_buffered(DynamicBuffer& db, parser_v1<
+    isRequest, Body, Headers>& p, std::vector<message<
+        isRequest, Body, Headers>, Allocator>& msgs)
+{
+    // Octets following these messages are not HTTP
+    auto more = p.keep_alive() && ! p.upgrade();
+    msgs.emplace_back(p.release());
+    while(more && db.size() > 0)
+    {
+        parser_v1<isRequest, Body, Headers> p1;
+        error_code ec;
+        auto const used = p1.write(db.data(), ec);
+        // Leave incomplete or invalid messages
+        // in the buffer for the next read.
+        if(ec || ! p1.complete())
+            break;
+        db.consume(used);
+        more = p1.keep_alive() && ! p1.upgrade();
+        msgs.emplace_back(p1.release());
+    }
+}
+
+template<class Stream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers,
+        class Allocator, class Handler>
+class read_batch_op
+{
+    using alloc_type =
+        handler_alloc<char, Handler>;
+
+    using parser_type =
+        parser_v1<isRequest, Body, Headers>;
+
+    using message_type =
+        message<isRequest, Body, Headers>;
+
+    struct data
+    {
+        Stream& s;
+        DynamicBuffer& db;
+        std::vector<message_type, Allocator>& v;
+        parser_type p;
+        Handler h;
+        bool cont;
+        int state = 0;
+
+        template<class DeducedHandler>
+        data(DeducedHandler&& h_, Stream& s_, DynamicBuffer& sb_,
+                std::vector<message_type, Allocator>& v_)
+            : s(s_)
+            , db(sb_)
+            , v(v_)
+            , h(std::forward<DeducedHandler>(h_))
+            , cont(boost_asio_handler_cont_helpers::
+                is_continuation(h))
+        {
+        }
+    };
+
+    std::shared_ptr<data> d_;
+
+public:
+    read_batch_op(read_batch_op&&) = default;
+    read_batch_op(read_batch_op const&) = default;
+
+    template<class DeducedHandler, class... Args>
+    read_batch_op(DeducedHandler&& h, Stream& s, Args&&... args)
+        : d_(std::allocate_shared<data>(alloc_type{h},
+            std::forward<DeducedHandler>(h), s,
+                std::forward<Args>(args)...))
+    {
+        (*this)(error_code{}, false);
+    }
+
+    void
+    operator()(error_code ec, bool again = true);
+
+    friend
+    void* asio_handler_allocate(
+        std::size_t size, read_batch_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            allocate(size, op->d_->h);
+    }
+
+    friend
+    void asio_handler_deallocate(
+        void* p, std::size_t size, read_batch_op* op)
+    {
+        return boost_asio_handler_alloc_helpers::
+            deallocate(p, size, op->d_->h);
+    }
+
+    friend
+    bool asio_handler_is_continuation(read_batch_op* op)
+    {
+        return op->d_->cont;
+    }
+
+    friend
+    bool allow_inline_hook(read_batch_op* op)
+    {
+        return inline_allowed(op->d_->h);
+    }
+
+    template<class Function>
+    friend
+    void asio_handler_invoke(Function&& f, read_batch_op* op)
+    {
+        return boost_asio_handler_invoke_helpers::
+            invoke(f, op->d_->h);
+    }
+};
+
+template<class Stream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers,
+        class Allocator, class Handler>
+void
+read_batch_op<Stream, DynamicBuffer,
+    isRequest, Body, Headers, Allocator, Handler>::
+operator()(error_code ec, bool again)
+{
+    auto& d = *d_;
+    d.cont = d.cont || again;
+    while(! ec && d.state != 99)
+    {
+        switch(d.state)
+        {
+        case 0:
+            d.state = 1;
+            d.v.clear();
+            async_parse(d.s, d.db, d.p, std::move(*this));
+            return;
+
+        case 1:
+            // call handler
+            d.state = 99;
+            read_buffered(d.db, d.p, d.v);
+            break;
+        }
+    }
+    d.h(ec);
+}
+
 } // detail
 
 //------------------------------------------------------------------------------
@@ -181,21 +728,100 @@ read(SyncReadStream& stream, DynamicBuffer& dynabuf,
     static_assert(is_Reader<typename Body::reader,
         message<isRequest, Body, Headers>>::value,
             "Reader requirements not met");
+    detail::read(stream, dynabuf, m, ec,
+        detail::is_direct_reader<typename Body::reader>{});
+}
+
+template<class AsyncReadStream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers,
+        class ReadHandler>
+typename async_completion<
+    ReadHandler, void(error_code)>::result_type
+async_read(AsyncReadStream& stream, DynamicBuffer& dynabuf,
+    message<isRequest, Body, Headers>& m,
+        ReadHandler&& handler)
+{
+    static_assert(is_AsyncReadStream<AsyncReadStream>::value,
+        "AsyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_reader<Body>::value,
+        "Body has no reader");
+    static_assert(is_Reader<typename Body::reader,
+        message<isRequest, Body, Headers>>::value,
+            "Reader requirements not met");
+    beast::async_completion<ReadHandler,
+        void(error_code)> completion(handler);
+    using op_type = typename std::conditional<
+        detail::is_direct_reader<typename Body::reader>::value,
+        detail::read_direct_op<AsyncReadStream, DynamicBuffer,
+            isRequest, Body, Headers, decltype(completion.handler)>,
+        detail::read_op<AsyncReadStream, DynamicBuffer,
+            isRequest, Body, Headers, decltype(completion.handler)>
+                >::type;
+    op_type{completion.handler, stream, dynabuf, m};
+    return completion.result.get();
+}
+
+template<class SyncReadStream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+read_batch(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    std::vector<message<isRequest, Body, Headers>, Allocator>& msgs)
+{
+    static_assert(is_SyncReadStream<SyncReadStream>::value,
+        "SyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_reader<Body>::value,
+        "Body has no reader");
+    static_assert(is_Reader<typename Body::reader,
+        message<isRequest, Body, Headers>>::value,
+            "Reader requirements not met");
+    error_code ec;
+    beast::http::read_batch(stream, dynabuf, msgs, ec);
+    if(ec)
+        throw system_error{ec};
+}
+
+template<class SyncReadStream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+read_batch(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    std::vector<message<isRequest, Body, Headers>, Allocator>& msgs,
+        error_code& ec)
+{
+    static_assert(is_SyncReadStream<SyncReadStream>::value,
+        "SyncReadStream requirements not met");
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_reader<Body>::value,
+        "Body has no reader");
+    static_assert(is_Reader<typename Body::reader,
+        message<isRequest, Body, Headers>>::value,
+            "Reader requirements not met");
+    msgs.clear();
     parser_v1<isRequest, Body, Headers> p;
     beast::http::parse(stream, dynabuf, p, ec);
     if(ec)
         return;
     BOOST_ASSERT(p.complete());
-    m = p.release();
+    detail::read_buffered(dynabuf, p, msgs);
 }
 
 template<class AsyncReadStream, class DynamicBuffer,
-    bool isRequest, class Body, class Headers,
+    bool isRequest, class Body, class Headers, class Allocator,
         class ReadHandler>
 typename async_completion<
     ReadHandler, void(error_code)>::result_type
-async_read(AsyncReadStream& stream, DynamicBuffer& dynabuf,
-    message<isRequest, Body, Headers>& m,
+async_read_batch(AsyncReadStream& stream, DynamicBuffer& dynabuf,
+    std::vector<message<isRequest, Body, Headers>, Allocator>& msgs,
         ReadHandler&& handler)
 {
     static_assert(is_AsyncReadStream<AsyncReadStream>::value,
@@ -211,10 +837,10 @@ async_read(AsyncReadStream& stream, DynamicBuffer& dynabuf,
             "Reader requirements not met");
     beast::async_completion<ReadHandler,
         void(error_code)> completion(handler);
-    detail::read_op<AsyncReadStream, DynamicBuffer,
-        isRequest, Body, Headers, decltype(
+    detail::read_batch_op<AsyncReadStream, DynamicBuffer,
+        isRequest, Body, Headers, Allocator, decltype(
             completion.handler)>{completion.handler,
-                stream, dynabuf, m};
+                stream, dynabuf, msgs};
     return completion.result.get();
 }
 
@@ -0,0 +1,245 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_IMPL_SERIALIZER_IPP
+#define BEAST_HTTP_IMPL_SERIALIZER_IPP
+
+#include <beast/http/concepts.hpp>
+#include <beast/core/error.hpp>
+#include <boost/assert.hpp>
+#include <boost/logic/tribool.hpp>
+#include <type_traits>
+#include <utility>
+
+namespace beast {
+namespace http {
+
+namespace detail {
+
+struct serializer_access
+{
+    template<bool isRequest, class Body, class Headers>
+    static
+    write_preparation<isRequest, Body, Headers>&
+    preparation(serializer<isRequest, Body, Headers>& sr)
+    {
+        // The serializer must not have started
+        BOOST_ASSERT(sr.s_ == sr.s_init);
+        return sr.wp_;
+    }
+};
+
+template<class WritePreparation>
+void
+prepare_writer(prepare_info& pi,
+    WritePreparation& wp, std::true_type)
+{
+    error_code ec;
+    wp.init_writer(ec);
+    if(ec)
+        throw system_error{ec};
+    pi.content_length = wp.w.content_length();
+}
+
+template<class WritePreparation>
+void
+prepare_writer(prepare_info& pi,
+    WritePreparation&, std::false_type)
+{
+    pi.content_length = boost::none;
+}
+
+} // detail
+
+template<bool isRequest, class Body, class Headers>
+class serializer<isRequest, Body, Headers>::const_buffers_type
+{
+    boost::asio::const_buffer const* begin_ = nullptr;
+    boost::asio::const_buffer const* end_ = nullptr;
+
+    friend class serializer;
+
+    const_buffers_type(
+            boost::asio::const_buffer const* begin,
+            boost::asio::const_buffer const* end)
+        : begin_(begin)
+        , end_(end)
+    {
+    }
+
+public:
+    using value_type = boost::asio::const_buffer;
+    using const_iterator = value_type const*;
+
+    const_buffers_type() = default;
+    const_buffers_type(const_buffers_type const&) = default;
+    const_buffers_type& operator=(const_buffers_type const&) = default;
+
+    const_iterator
+    begin() const
+    {
+        return begin_;
+    }
+
+    const_iterator
+    end() const
+    {
+        return end_;
+    }
+};
+
+// Receives body buffers from the writer
+//
+template<bool isRequest, class Body, class Headers>
+class serializer<isRequest, Body, Headers>::append
+{
+    serializer& sr_;
+
+public:
+    explicit
+    append(serializer& sr)
+        : sr_(sr)
+    {
+    }
+
+    template<class ConstBufferSequence>
+    void
+    operator()(ConstBufferSequence const& buffers) const
+    {
+        using boost::asio::buffer_size;
+        auto const n = buffer_size(buffers);
+        if(n == 0)
+            return;
+        if(sr_.wp_.chunked)
+        {
+            sr_.chunk_.emplace_back(n);
+            sr_.v_.push_back(*sr_.chunk_.back().begin());
+        }
+        for(auto const& b : buffers)
+            sr_.v_.emplace_back(b);
+        if(sr_.wp_.chunked)
+            sr_.v_.emplace_back("\r\n", 2);
+    }
+
+    // Each call to next() already returns everything
+    // written so far, so there is nothing to flush.
+    void flush() const
+    {
+    }
+};
+
+template<bool isRequest, class Body, class Headers>
+serializer<isRequest, Body, Headers>::
+serializer(message_type const& msg)
+    : wp_(msg)
+{
+}
+
+template<bool isRequest, class Body, class Headers>
+serializer<isRequest, Body, Headers>::
+serializer(message_type const& msg, resume_context resume)
+    : wp_(msg)
+    , resume_(std::move(resume))
+{
+}
+
+template<bool isRequest, class Body, class Headers>
+auto
+serializer<isRequest, Body, Headers>::
+next(error_code& ec) ->
+    const_buffers_type
+{
+    if(pos_ == v_.size())
+    {
+        v_.clear();
+        chunk_.clear();
+        pos_ = 0;
+        if(s_ == s_init)
+        {
+            wp_.init(ec);
+            if(ec)
+                return {};
+            v_.push_back(*wp_.hb.data().begin());
+            s_ = s_body;
+        }
+        // A writer may return `false` without
+        // producing data, so keep asking.
+        auto const n = v_.size();
+        while(s_ == s_body && v_.size() == n)
+        {
+            auto copy = resume_;
+            boost::tribool const result =
+                wp_.w.write(std::move(copy), ec, append{*this});
+            if(ec)
+            {
+                v_.clear();
+                return {};
+            }
+            if(boost::indeterminate(result))
+                break;
+            if(result)
+            {
+                // The final chunk goes out
+                // with the last body data.
+                if(wp_.chunked)
+                    v_.push_back(*detail::
+                        chunk_encode_final().begin());
+                s_ = s_done;
+            }
+        }
+    }
+    return {v_.data() + pos_, v_.data() + v_.size()};
+}
+
+template<bool isRequest, class Body, class Headers>
+void
+serializer<isRequest, Body, Headers>::
+consume(std::size_t n)
+{
+    using boost::asio::buffer_size;
+    while(pos_ < v_.size())
+    {
+        auto const len = buffer_size(v_[pos_]);
+        if(n < len)
+        {
+            v_[pos_] = v_[pos_] + n;
+            break;
+        }
+        n -= len;
+        ++pos_;
+    }
+}
+
+template<
+    bool isRequest, class Body, class Headers,
+    class... Options>
+void
+prepare(message<isRequest, Body, Headers>& msg,
+    serializer<isRequest, Body, Headers>& sr,
+        Options&&... options)
+{
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_writer<Body>::value,
+        "Body has no writer");
+    static_assert(is_Writer<typename Body::writer,
+        message<isRequest, Body, Headers>>::value,
+            "Writer requirements not met");
+    auto& wp = detail::serializer_access::preparation(sr);
+    BOOST_ASSERT(&wp.msg == &msg);
+    detail::prepare_info pi;
+    detail::prepare_writer(pi, wp,
+        detail::has_content_length<typename Body::writer>{});
+    detail::prepare_fields(msg, pi,
+        std::forward<Options>(options)...);
+    wp.update();
+}
+
+} // http
+} // beast
+
+#endif
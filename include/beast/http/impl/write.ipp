@@ -11,19 +11,30 @@
 #include <beast/http/concepts.hpp>
 #include <beast/http/resume_context.hpp>
 #include <beast/http/detail/chunk_encode.hpp>
+#include <beast/http/detail/sendfile.hpp>
+#include <beast/http/detail/write_preparation.hpp>
 #include <beast/core/buffer_cat.hpp>
 #include <beast/core/bind_handler.hpp>
 #include <beast/core/buffer_concepts.hpp>
+#include <beast/core/consuming_buffers.hpp>
 #include <beast/core/handler_alloc.hpp>
 #include <beast/core/stream_concepts.hpp>
 #include <beast/core/streambuf.hpp>
 #include <beast/core/write_dynabuf.hpp>
+#include <beast/core/detail/write_cached.hpp>
 #include <boost/asio/write.hpp>
+#include <boost/assert.hpp>
 #include <boost/logic/tribool.hpp>
+#include <boost/utility/string_ref.hpp>
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <memory>
 #include <mutex>
 #include <ostream>
 #include <sstream>
+#include <string>
 #include <type_traits>
 
 namespace beast {
@@ -31,117 +42,66 @@ namespace http {
 
 namespace detail {
 
-template<class DynamicBuffer, class Body, class Headers>
-void
-write_firstline(DynamicBuffer& dynabuf,
-    message<true, Body, Headers> const& msg)
-{
-    write(dynabuf, msg.method);
-    write(dynabuf, " ");
-    write(dynabuf, msg.url);
-    switch(msg.version)
-    {
-    case 10:
-        write(dynabuf, " HTTP/1.0\r\n");
-        break;
-    case 11:
-        write(dynabuf, " HTTP/1.1\r\n");
-        break;
-    default:
-    {
-        std::string s;
-        s = " HTTP/" +
-            std::to_string(msg.version/10) + '.' +
-            std::to_string(msg.version%10) + "\r\n";
-        write(dynabuf, s);
-        break;
-    }
-    }
+template<class Writer>
+std::size_t
+min_chunk_size(Writer const& w, std::true_type)
+{
+    return w.min_chunk_size();
 }
 
-template<class DynamicBuffer, class Body, class Headers>
-void
-write_firstline(DynamicBuffer& dynabuf,
-    message<false, Body, Headers> const& msg)
-{
-    switch(msg.version)
-    {
-    case 10:
-        write(dynabuf, "HTTP/1.0 ");
-        break;
-    case 11:
-        write(dynabuf, "HTTP/1.1 ");
-        break;
-    default:
-    {
-        std::string s;
-        s = " HTTP/" +
-            std::to_string(msg.version/10) + '.' +
-            std::to_string(msg.version%10) + ' ';
-        write(dynabuf, s);
-        break;
-    }
-    }
-    write(dynabuf, msg.status);
-    write(dynabuf, " ");
-    write(dynabuf, msg.reason);
-    write(dynabuf, "\r\n");
+template<class Writer>
+std::size_t
+min_chunk_size(Writer const&, std::false_type)
+{
+    return 0;
 }
 
-template<class DynamicBuffer, class FieldSequence>
-void
-write_fields(DynamicBuffer& dynabuf, FieldSequence const& fields)
+// Returns the smallest chunk the writer wants sent,
+// or zero if each piece of body data is its own chunk.
+//
+template<class WritePreparation>
+std::size_t
+coalesce_limit(WritePreparation const& wp)
 {
-    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
-        "DynamicBuffer requirements not met");
-    //static_assert(is_FieldSequence<FieldSequence>::value,
-    //    "FieldSequence requirements not met");
-    for(auto const& field : fields)
-    {
-        write(dynabuf, field.name());
-        write(dynabuf, ": ");
-        write(dynabuf, field.value());
-        write(dynabuf, "\r\n");
-    }
+    using writer_type = typename WritePreparation::writer_type;
+    if(! wp.chunked)
+        return 0;
+    return min_chunk_size(wp.w,
+        has_min_chunk_size<writer_type>{});
 }
 
-template<bool isRequest, class Body, class Headers>
-struct write_preparation
+// Collects body data so that small pieces
+// can be sent together in one larger chunk.
+//
+class coalesce_lambda
 {
-    message<isRequest, Body, Headers> const& msg;
-    typename Body::writer w;
-    streambuf sb;
-    bool chunked;
-    bool close;
+    std::string& buf_;
+    bool& flush_;
 
-    explicit
-    write_preparation(
-            message<isRequest, Body, Headers> const& msg_)
-        : msg(msg_)
-        , w(msg)
-        , chunked(token_list{
-            msg.headers["Transfer-Encoding"]}.exists("chunked"))
-        , close(token_list{
-            msg.headers["Connection"]}.exists("close") ||
-                (msg.version < 11 && ! msg.headers.exists(
-                    "Content-Length")))
+public:
+    coalesce_lambda(std::string& buf, bool& flush)
+        : buf_(buf)
+        , flush_(flush)
     {
     }
 
-    void
-    init(error_code& ec)
+    template<class ConstBufferSequence>
+    void operator()(ConstBufferSequence const& buffers) const
     {
-        w.init(ec);
-        if(ec)
-            return;
-        write_firstline(sb, msg);
-        write_fields(sb, msg.headers);
-        beast::write(sb, "\r\n");
+        using boost::asio::buffer_cast;
+        using boost::asio::buffer_size;
+        for(auto const& b : buffers)
+            buf_.append(buffer_cast<char const*>(b),
+                buffer_size(b));
+    }
+
+    void flush() const
+    {
+        flush_ = true;
     }
 };
 
-template<class Stream, class Handler,
-    bool isRequest, class Body, class Headers>
+template<class Stream, class Handler, class WritePreparation>
 class write_op
 {
     using alloc_type =
@@ -151,19 +111,24 @@ class write_op
     {
         Stream& s;
         // VFALCO How do we use handler_alloc in write_preparation?
-        write_preparation<
-            isRequest, Body, Headers> wp;
+        WritePreparation wp;
         Handler h;
+        // Set while the writer holds the resume context
+        std::shared_ptr<data> self;
         resume_context resume;
-        resume_context copy;
+        std::uint64_t offset = 0;
+        std::string chunk;
+        std::size_t limit = 0;
+        error_code join_ec;
+        std::atomic<int> join{0};
+        bool flush = false;
         bool cont;
         int state = 0;
 
-        template<class DeducedHandler>
-        data(DeducedHandler&& h_, Stream& s_,
-                message<isRequest, Body, Headers> const& m_)
+        template<class DeducedHandler, class... Args>
+        data(DeducedHandler&& h_, Stream& s_, Args&... args)
             : s(s_)
-            , wp(m_)
+            , wp(args...)
             , h(std::forward<DeducedHandler>(h_))
             , cont(boost_asio_handler_cont_helpers::
                 is_continuation(h))
@@ -188,15 +153,19 @@ class write_op
             auto& d = *self_.d_;
             // write headers and body
             if(d.wp.chunked)
-                boost::asio::async_write(d.s,
-                    buffer_cat(d.wp.sb.data(),
+                beast::detail::async_write_cached(d.s,
+                    buffer_cat(d.wp.hb.data(),
                         detail::chunk_encode(buffers)),
                             std::move(self_));
             else
-                boost::asio::async_write(d.s,
-                    buffer_cat(d.wp.sb.data(),
+                beast::detail::async_write_cached(d.s,
+                    buffer_cat(d.wp.hb.data(),
                         buffers), std::move(self_));
         }
+
+        void flush() const
+        {
+        }
     };
 
     class writef_lambda
@@ -216,17 +185,36 @@ class write_op
             auto& d = *self_.d_;
             // write body
             if(d.wp.chunked)
-                boost::asio::async_write(d.s,
+                beast::detail::async_write_cached(d.s,
                     detail::chunk_encode(buffers),
                         std::move(self_));
             else
-                boost::asio::async_write(d.s,
+                beast::detail::async_write_cached(d.s,
                     buffers, std::move(self_));
         }
+
+        void flush() const
+        {
+        }
     };
 
     std::shared_ptr<data> d_;
 
+    using is_sendfile = use_sendfile<Stream, typename
+        std::remove_reference<WritePreparation>::type::writer_type>;
+
+    bool
+    send_file(error_code& ec, std::true_type);
+
+    bool
+    send_file(error_code&, std::false_type)
+    {
+        return true;
+    }
+
+    void
+    write_chunk(bool last);
+
 public:
     write_op(write_op&&) = default;
     write_op(write_op const&) = default;
@@ -237,18 +225,21 @@ public:
             std::forward<DeducedHandler>(h), s,
                 std::forward<Args>(args)...))
     {
+        // The resume context only holds a pointer to the
+        // state, so it is stored without allocating. While
+        // the writer holds the context, the state owns itself,
+        // and resuming hands that ownership to the operation.
         auto& d = *d_;
-        auto sp = d_;
+        auto const p = &d;
         d.resume = {
-            [sp]() mutable
+            [p]
             {
-                write_op self(std::move(sp));
-                self.d_->cont = false;
+                BOOST_ASSERT(p->self);
+                write_op self(std::move(p->self));
                 auto& ios = self.d_->s.get_io_service();
                 ios.dispatch(bind_handler(std::move(self),
                     error_code{}, 0, false));
             }};
-        d.copy = d.resume;
         (*this)(error_code{}, 0, false);
     }
 
@@ -293,14 +284,39 @@ public:
     }
 };
 
-template<class Stream, class Handler,
-    bool isRequest, class Body, class Headers>
+template<class Stream, class Handler, class WritePreparation>
 void
-write_op<Stream, Handler, isRequest, Body, Headers>::
+write_op<Stream, Handler, WritePreparation>::
 operator()(error_code ec, std::size_t, bool again)
 {
     auto& d = *d_;
-    d.cont = d.cont || again;
+    if(d.state == 8)
+    {
+        // The write of the collected data and the resume
+        // may complete at the same time on different threads,
+        // so nothing else is touched until the last of them
+        // arrives. A failed write completes the operation at
+        // once, and the resume which follows does nothing.
+        if(ec)
+            d.join_ec = ec;
+        if(d.join.fetch_sub(1, std::memory_order_acq_rel) > 1)
+        {
+            if(! ec)
+                return;
+        }
+        else if(! ec)
+        {
+            if(d.join_ec)
+                return;
+            d.state = 10;
+        }
+    }
+    // Only the constructor and a resume pass `again` as
+    // false, and a resumed operation is not a continuation.
+    if(again)
+        d.cont = true;
+    else if(d.state != 0)
+        d.cont = false;
     while(! ec && d.state != 99)
     {
         switch(d.state)
@@ -316,14 +332,26 @@ operator()(error_code ec, std::size_t, bool again)
                     std::move(*this), ec, 0, false));
                 return;
             }
-            d.state = 1;
+            if(is_sendfile::value && ! d.wp.chunked)
+            {
+                // write headers, then the file
+                d.state = 6;
+                boost::asio::async_write(d.s,
+                    d.wp.hb.data(), std::move(*this));
+                return;
+            }
+            d.limit = coalesce_limit(d.wp);
+            d.state = d.limit > 0 ? 9 : 1;
             break;
         }
 
         case 1:
         {
+            d.self = d_;
             boost::tribool const result = d.wp.w.write(
-                std::move(d.copy), ec, writef0_lambda{*this});
+                resume_context{d.resume}, ec, writef0_lambda{*this});
+            if(ec || ! boost::indeterminate(result))
+                d.self = nullptr;
             if(ec)
             {
                 // call handler
@@ -333,11 +361,8 @@ operator()(error_code ec, std::size_t, bool again)
                 return;
             }
             if(boost::indeterminate(result))
-            {
                 // suspend
-                d.copy = d.resume;
                 return;
-            }
             if(result)
                 d.state = d.wp.chunked ? 4 : 5;
             else
@@ -347,14 +372,17 @@ operator()(error_code ec, std::size_t, bool again)
 
         // sent headers and body
         case 2:
-            d.wp.sb.consume(d.wp.sb.size());
+            d.wp.hb.clear();
             d.state = 3;
             break;
 
         case 3:
         {
+            d.self = d_;
             boost::tribool result = d.wp.w.write(
-                std::move(d.copy), ec, writef_lambda{*this});
+                resume_context{d.resume}, ec, writef_lambda{*this});
+            if(ec || ! boost::indeterminate(result))
+                d.self = nullptr;
             if(ec)
             {
                 // call handler
@@ -362,11 +390,8 @@ operator()(error_code ec, std::size_t, bool again)
                 break;
             }
             if(boost::indeterminate(result))
-            {
                 // suspend
-                d.copy = d.resume;
                 return;
-            }
             if(result)
                 d.state = d.wp.chunked ? 4 : 5;
             else
@@ -393,25 +418,168 @@ operator()(error_code ec, std::size_t, bool again)
             }
             d.state = 99;
             break;
+
+        // sent headers
+        case 6:
+            d.wp.hb.clear();
+            d.state = 7;
+            break;
+
+        case 7:
+            if(! send_file(ec, is_sendfile{}))
+                return;
+            d.state = 5;
+            break;
+
+        case 9:
+        {
+            // The writer may resume from another thread as
+            // soon as it holds the context, so the join with
+            // the resume is prepared before the call.
+            d.self = d_;
+            d.join_ec = {};
+            d.join = 2;
+            d.state = 8;
+            boost::tribool const result = d.wp.w.write(
+                resume_context{d.resume}, ec,
+                    coalesce_lambda{d.chunk, d.flush});
+            if(ec || ! boost::indeterminate(result))
+            {
+                d.self = nullptr;
+                d.state = 9;
+            }
+            if(ec)
+            {
+                // call handler
+                d.state = 99;
+                d.s.get_io_service().post(bind_handler(
+                    std::move(*this), ec, 0, false));
+                return;
+            }
+            if(boost::indeterminate(result))
+            {
+                if(d.chunk.empty() && d.wp.hb.size() == 0)
+                {
+                    // suspend, unless the resume arrived
+                    if(d.join.fetch_sub(1,
+                            std::memory_order_acq_rel) > 1)
+                        return;
+                    d.state = 9;
+                    break;
+                }
+                // send what we have, then wait for
+                // the write and the resume to complete.
+                write_chunk(false);
+                return;
+            }
+            if(result)
+            {
+                // the last chunk goes with the final chunk
+                d.state = 5;
+                write_chunk(true);
+                return;
+            }
+            if(d.flush || d.chunk.size() >= d.limit)
+            {
+                d.state = 10;
+                write_chunk(false);
+                return;
+            }
+            // keep collecting
+            break;
+        }
+
+        // sent coalesced chunk
+        case 10:
+            d.wp.hb.clear();
+            d.chunk.clear();
+            d.flush = false;
+            d.state = 9;
+            break;
         }
     }
     d.h(ec);
     d.resume = {};
-    d.copy = {};
 }
 
-template<class SyncWriteStream, class DynamicBuffer>
+// Sends the headers if they were not sent yet, followed
+// by the collected body data as one chunk, and the final
+// chunk if this is the last write.
+//
+template<class Stream, class Handler, class WritePreparation>
+void
+write_op<Stream, Handler, WritePreparation>::
+write_chunk(bool last)
+{
+    auto& d = *d_;
+    auto const data = boost::asio::buffer(d.chunk);
+    if(d.chunk.empty())
+    {
+        if(last)
+            beast::detail::async_write_cached(d.s, buffer_cat(
+                d.wp.hb.data(), chunk_encode_final()),
+                    std::move(*this));
+        else
+            boost::asio::async_write(d.s,
+                d.wp.hb.data(), std::move(*this));
+    }
+    else if(last)
+    {
+        beast::detail::async_write_cached(d.s, buffer_cat(
+            d.wp.hb.data(), chunk_encode(data),
+                chunk_encode_final()), std::move(*this));
+    }
+    else
+    {
+        beast::detail::async_write_cached(d.s, buffer_cat(
+            d.wp.hb.data(), chunk_encode(data)),
+                std::move(*this));
+    }
+}
+
+// Returns `false` if the operation is waiting
+// for the socket to become writable.
+//
+template<class Stream, class Handler, class WritePreparation>
+bool
+write_op<Stream, Handler, WritePreparation>::
+send_file(error_code& ec, std::true_type)
+{
+    auto& d = *d_;
+    d.s.native_non_blocking(true, ec);
+    if(ec)
+        return true;
+    auto const size = d.wp.w.content_length();
+    while(d.offset < size)
+    {
+        detail::send_file(d.s.native_handle(),
+            d.wp.w.native_handle(), d.offset,
+                size - d.offset, ec);
+        if(ec == boost::asio::error::would_block)
+        {
+            ec = {};
+            d.s.async_write_some(boost::asio::null_buffers(),
+                std::move(*this));
+            return false;
+        }
+        if(ec)
+            break;
+    }
+    return true;
+}
+
+template<class SyncWriteStream, class HeaderBuffer>
 class writef0_lambda
 {
-    DynamicBuffer const& sb_;
+    HeaderBuffer const& hb_;
     SyncWriteStream& stream_;
     bool chunked_;
     error_code& ec_;
 
 public:
     writef0_lambda(SyncWriteStream& stream,
-            DynamicBuffer const& sb, bool chunked, error_code& ec)
-        : sb_(sb)
+            HeaderBuffer const& hb, bool chunked, error_code& ec)
+        : hb_(hb)
         , stream_(stream)
         , chunked_(chunked)
         , ec_(ec)
@@ -423,11 +591,15 @@ public:
     {
         // write headers and body
         if(chunked_)
-            boost::asio::write(stream_, buffer_cat(
-                sb_.data(), detail::chunk_encode(buffers)), ec_);
+            beast::detail::write_cached(stream_, buffer_cat(
+                hb_.data(), detail::chunk_encode(buffers)), ec_);
         else
-            boost::asio::write(stream_, buffer_cat(
-                sb_.data(), buffers), ec_);
+            beast::detail::write_cached(stream_, buffer_cat(
+                hb_.data(), buffers), ec_);
+    }
+
+    void flush() const
+    {
     }
 };
 
@@ -452,93 +624,160 @@ public:
     {
         // write body
         if(chunked_)
-            boost::asio::write(stream_,
+            beast::detail::write_cached(stream_,
                 detail::chunk_encode(buffers), ec_);
         else
-            boost::asio::write(stream_, buffers, ec_);
+            beast::detail::write_cached(stream_, buffers, ec_);
+    }
+
+    void flush() const
+    {
     }
 };
 
-} // detail
+// Blocks a synchronous write until a suspended writer
+// resumes it. The resume context only holds a pointer to
+// this object, so it is stored without allocating.
+//
+class sync_resume
+{
+    std::mutex m_;
+    std::condition_variable cv_;
+    bool ready_ = false;
 
-//------------------------------------------------------------------------------
+public:
+    resume_context
+    context()
+    {
+        return
+            [this]
+            {
+                std::lock_guard<std::mutex> lock(m_);
+                ready_ = true;
+                cv_.notify_one();
+            };
+    }
 
-template<class SyncWriteStream,
-    bool isRequest, class Body, class Headers>
+    void
+    wait()
+    {
+        std::unique_lock<std::mutex> lock(m_);
+        cv_.wait(lock, [this]{ return ready_; });
+        ready_ = false;
+    }
+};
+
+// Write the body as chunks of at least `limit` octets
+//
+template<class SyncWriteStream, class WritePreparation>
 void
-write(SyncWriteStream& stream,
-    message<isRequest, Body, Headers> const& msg)
+write_coalesced(SyncWriteStream& stream,
+    WritePreparation& wp, std::size_t limit, error_code& ec)
 {
-    static_assert(is_SyncWriteStream<SyncWriteStream>::value,
-        "SyncWriteStream requirements not met");
-    static_assert(is_Body<Body>::value,
-        "Body requirements not met");
-    static_assert(has_writer<Body>::value,
-        "Body has no writer");
-    static_assert(is_Writer<typename Body::writer,
-        message<isRequest, Body, Headers>>::value,
-            "Writer requirements not met");
-    error_code ec;
-    write(stream, msg, ec);
-    if(ec)
-        throw system_error{ec};
+    sync_resume sr;
+    auto const resume = sr.context();
+    std::string chunk;
+    bool flush = false;
+    auto const send =
+        [&](bool last)
+        {
+            auto const data = boost::asio::buffer(chunk);
+            if(chunk.empty())
+            {
+                if(last)
+                    beast::detail::write_cached(stream, buffer_cat(
+                        wp.hb.data(), chunk_encode_final()), ec);
+                else
+                    boost::asio::write(stream, wp.hb.data(), ec);
+            }
+            else if(last)
+            {
+                beast::detail::write_cached(stream, buffer_cat(
+                    wp.hb.data(), chunk_encode(data),
+                        chunk_encode_final()), ec);
+            }
+            else
+            {
+                beast::detail::write_cached(stream, buffer_cat(
+                    wp.hb.data(), chunk_encode(data)), ec);
+            }
+            wp.hb.clear();
+            chunk.clear();
+            flush = false;
+        };
+    for(;;)
+    {
+        auto copy = resume;
+        boost::tribool const result = wp.w.write(
+            std::move(copy), ec, coalesce_lambda{chunk, flush});
+        if(ec)
+            return;
+        if(boost::indeterminate(result))
+        {
+            if(! chunk.empty() || wp.hb.size() > 0)
+            {
+                send(false);
+                if(ec)
+                    return;
+            }
+            sr.wait();
+            continue;
+        }
+        if(result)
+        {
+            send(true);
+            if(ec)
+                return;
+            break;
+        }
+        if(flush || chunk.size() >= limit)
+        {
+            send(false);
+            if(ec)
+                return;
+        }
+    }
+    if(wp.close)
+    {
+        // VFALCO TODO Decide on an error code
+        ec = boost::asio::error::eof;
+    }
 }
 
-template<class SyncWriteStream,
-    bool isRequest, class Body, class Headers>
+template<class SyncWriteStream, class WritePreparation>
 void
-write(SyncWriteStream& stream,
-    message<isRequest, Body, Headers> const& msg,
-        error_code& ec)
+write_prepared(SyncWriteStream& stream,
+    WritePreparation& wp, error_code& ec, std::false_type)
 {
-    static_assert(is_SyncWriteStream<SyncWriteStream>::value,
-        "SyncWriteStream requirements not met");
-    static_assert(is_Body<Body>::value,
-        "Body requirements not met");
-    static_assert(has_writer<Body>::value,
-        "Body has no writer");
-    static_assert(is_Writer<typename Body::writer,
-        message<isRequest, Body, Headers>>::value,
-            "Writer requirements not met");
-    detail::write_preparation<isRequest, Body, Headers> wp(msg);
     wp.init(ec);
     if(ec)
         return;
-    std::mutex m;
-    std::condition_variable cv;
-    bool ready = false;
-    resume_context resume{
-        [&]
-        {
-            std::lock_guard<std::mutex> lock(m);
-            ready = true;
-            cv.notify_one();
-        }};
+    auto const limit = coalesce_limit(wp);
+    if(limit > 0)
+        return write_coalesced(stream, wp, limit, ec);
+    sync_resume sr;
+    auto const resume = sr.context();
     auto copy = resume;
     boost::tribool result =
         wp.w.write(std::move(copy), ec,
-            detail::writef0_lambda<SyncWriteStream,
-                decltype(wp.sb)>{stream,
-                    wp.sb, wp.chunked, ec});
+            writef0_lambda<SyncWriteStream,
+                decltype(wp.hb)>{stream,
+                    wp.hb, wp.chunked, ec});
     if(ec)
         return;
     if(boost::indeterminate(result))
     {
         copy = resume;
-        {
-            std::unique_lock<std::mutex> lock(m);
-            cv.wait(lock, [&]{ return ready; });
-            ready = false;
-        }
-        boost::asio::write(stream, wp.sb.data(), ec);
+        sr.wait();
+        boost::asio::write(stream, wp.hb.data(), ec);
         if(ec)
             return;
         result = false;
     }
-    wp.sb.consume(wp.sb.size());
+    wp.hb.clear();
     if(! result)
     {
-        detail::writef_lambda<SyncWriteStream> wf{
+        writef_lambda<SyncWriteStream> wf{
             stream, wp.chunked, ec};
         for(;;)
         {
@@ -550,9 +789,7 @@ write(SyncWriteStream& stream,
             if(! result)
                 continue;
             copy = resume;
-            std::unique_lock<std::mutex> lock(m);
-            cv.wait(lock, [&]{ return ready; });
-            ready = false;
+            sr.wait();
         }
     }
     if(wp.chunked)
@@ -562,7 +799,7 @@ write(SyncWriteStream& stream,
         //        final body chunk with the final chunk delimiter.
         //
         // write final chunk
-        boost::asio::write(stream, detail::chunk_encode_final(), ec);
+        boost::asio::write(stream, chunk_encode_final(), ec);
         if(ec)
             return;
     }
@@ -573,6 +810,143 @@ write(SyncWriteStream& stream,
     }
 }
 
+template<class SyncWriteStream, class WritePreparation>
+void
+write_prepared(SyncWriteStream& stream,
+    WritePreparation& wp, error_code& ec, std::true_type)
+{
+    if(wp.chunked)
+        return write_prepared(
+            stream, wp, ec, std::false_type{});
+    wp.init(ec);
+    if(ec)
+        return;
+    boost::asio::write(stream, wp.hb.data(), ec);
+    if(ec)
+        return;
+    wp.hb.clear();
+    std::uint64_t offset = 0;
+    auto const size = wp.w.content_length();
+    while(offset < size)
+    {
+        send_file(stream.native_handle(),
+            wp.w.native_handle(), offset,
+                size - offset, ec);
+        if(ec == boost::asio::error::would_block &&
+            ! stream.non_blocking())
+        {
+            // wait until the socket is writable
+            stream.write_some(
+                boost::asio::null_buffers(), ec);
+        }
+        if(ec)
+            return;
+    }
+    if(wp.close)
+    {
+        // VFALCO TODO Decide on an error code
+        ec = boost::asio::error::eof;
+    }
+}
+
+template<class SyncWriteStream, class WritePreparation>
+void
+write_prepared(SyncWriteStream& stream,
+    WritePreparation& wp, error_code& ec)
+{
+    write_prepared(stream, wp, ec, use_sendfile<SyncWriteStream,
+        typename WritePreparation::writer_type>{});
+}
+
+} // detail
+
+//------------------------------------------------------------------------------
+
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers>
+void
+write(SyncWriteStream& stream,
+    message<isRequest, Body, Headers> const& msg)
+{
+    static_assert(is_SyncWriteStream<SyncWriteStream>::value,
+        "SyncWriteStream requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_writer<Body>::value,
+        "Body has no writer");
+    static_assert(is_Writer<typename Body::writer,
+        message<isRequest, Body, Headers>>::value,
+            "Writer requirements not met");
+    error_code ec;
+    write(stream, msg, ec);
+    if(ec)
+        throw system_error{ec};
+}
+
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers>
+void
+write(SyncWriteStream& stream,
+    message<isRequest, Body, Headers> const& msg,
+        error_code& ec)
+{
+    static_assert(is_SyncWriteStream<SyncWriteStream>::value,
+        "SyncWriteStream requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_writer<Body>::value,
+        "Body has no writer");
+    static_assert(is_Writer<typename Body::writer,
+        message<isRequest, Body, Headers>>::value,
+            "Writer requirements not met");
+    detail::write_preparation<isRequest, Body, Headers> wp(msg);
+    detail::write_prepared(stream, wp, ec);
+}
+
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+write(SyncWriteStream& stream,
+    message<isRequest, Body, Headers> const& msg,
+        basic_header_buffer<Allocator>& buffer)
+{
+    static_assert(is_SyncWriteStream<SyncWriteStream>::value,
+        "SyncWriteStream requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_writer<Body>::value,
+        "Body has no writer");
+    static_assert(is_Writer<typename Body::writer,
+        message<isRequest, Body, Headers>>::value,
+            "Writer requirements not met");
+    error_code ec;
+    write(stream, msg, buffer, ec);
+    if(ec)
+        throw system_error{ec};
+}
+
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+write(SyncWriteStream& stream,
+    message<isRequest, Body, Headers> const& msg,
+        basic_header_buffer<Allocator>& buffer,
+            error_code& ec)
+{
+    static_assert(is_SyncWriteStream<SyncWriteStream>::value,
+        "SyncWriteStream requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_writer<Body>::value,
+        "Body has no writer");
+    static_assert(is_Writer<typename Body::writer,
+        message<isRequest, Body, Headers>>::value,
+            "Writer requirements not met");
+    detail::write_preparation<
+        isRequest, Body, Headers, Allocator> wp(msg, buffer);
+    detail::write_prepared(stream, wp, ec);
+}
+
 template<class AsyncWriteStream,
     bool isRequest, class Body, class Headers,
         class WriteHandler>
@@ -594,7 +968,82 @@ async_write(AsyncWriteStream& stream,
     beast::async_completion<WriteHandler,
         void(error_code)> completion(handler);
     detail::write_op<AsyncWriteStream, decltype(completion.handler),
-        isRequest, Body, Headers>{completion.handler, stream, msg};
+        detail::write_preparation<isRequest, Body, Headers>>{
+            completion.handler, stream, msg};
+    return completion.result.get();
+}
+
+template<class AsyncWriteStream,
+    bool isRequest, class Body, class Headers,
+        class Allocator, class WriteHandler>
+typename async_completion<
+    WriteHandler, void(error_code)>::result_type
+async_write(AsyncWriteStream& stream,
+    message<isRequest, Body, Headers> const& msg,
+        basic_header_buffer<Allocator>& buffer,
+            WriteHandler&& handler)
+{
+    static_assert(is_AsyncWriteStream<AsyncWriteStream>::value,
+        "AsyncWriteStream requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_writer<Body>::value,
+        "Body has no writer");
+    static_assert(is_Writer<typename Body::writer,
+        message<isRequest, Body, Headers>>::value,
+            "Writer requirements not met");
+    beast::async_completion<WriteHandler,
+        void(error_code)> completion(handler);
+    detail::write_op<AsyncWriteStream, decltype(completion.handler),
+        detail::write_preparation<isRequest, Body, Headers, Allocator>>{
+            completion.handler, stream, msg, buffer};
+    return completion.result.get();
+}
+
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers>
+void
+write(SyncWriteStream& stream,
+    serializer<isRequest, Body, Headers>& sr)
+{
+    static_assert(is_SyncWriteStream<SyncWriteStream>::value,
+        "SyncWriteStream requirements not met");
+    error_code ec;
+    write(stream, sr, ec);
+    if(ec)
+        throw system_error{ec};
+}
+
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers>
+void
+write(SyncWriteStream& stream,
+    serializer<isRequest, Body, Headers>& sr,
+        error_code& ec)
+{
+    static_assert(is_SyncWriteStream<SyncWriteStream>::value,
+        "SyncWriteStream requirements not met");
+    detail::write_prepared(stream,
+        detail::serializer_access::preparation(sr), ec);
+}
+
+template<class AsyncWriteStream,
+    bool isRequest, class Body, class Headers,
+        class WriteHandler>
+typename async_completion<
+    WriteHandler, void(error_code)>::result_type
+async_write(AsyncWriteStream& stream,
+    serializer<isRequest, Body, Headers>& sr,
+        WriteHandler&& handler)
+{
+    static_assert(is_AsyncWriteStream<AsyncWriteStream>::value,
+        "AsyncWriteStream requirements not met");
+    beast::async_completion<WriteHandler,
+        void(error_code)> completion(handler);
+    detail::write_op<AsyncWriteStream, decltype(completion.handler),
+        detail::write_preparation<isRequest, Body, Headers>&>{
+            completion.handler, stream,
+                detail::serializer_access::preparation(sr)};
     return completion.result.get();
 }
 
@@ -645,6 +1094,119 @@ public:
     }
 };
 
+class string_SyncStream
+{
+    std::string& s_;
+
+public:
+    explicit
+    string_SyncStream(std::string& s)
+        : s_(s)
+    {
+    }
+
+    template<class ConstBufferSequence>
+    std::size_t
+    write_some(ConstBufferSequence const& buffers)
+    {
+        error_code ec;
+        return write_some(buffers, ec);
+    }
+
+    template<class ConstBufferSequence>
+    std::size_t
+    write_some(ConstBufferSequence const& buffers,
+        error_code&)
+    {
+        std::size_t n = 0;
+        using boost::asio::buffer_cast;
+        using boost::asio::buffer_size;
+        for(auto const& buffer : buffers)
+        {
+            s_.append(buffer_cast<char const*>(buffer),
+                buffer_size(buffer));
+            n += buffer_size(buffer);
+        }
+        return n;
+    }
+};
+
+template<class DynamicBuffer>
+class dynabuf_SyncStream
+{
+    DynamicBuffer& db_;
+
+public:
+    explicit
+    dynabuf_SyncStream(DynamicBuffer& db)
+        : db_(db)
+    {
+    }
+
+    template<class ConstBufferSequence>
+    std::size_t
+    write_some(ConstBufferSequence const& buffers)
+    {
+        error_code ec;
+        return write_some(buffers, ec);
+    }
+
+    template<class ConstBufferSequence>
+    std::size_t
+    write_some(ConstBufferSequence const& buffers,
+        error_code&)
+    {
+        using boost::asio::buffer_copy;
+        using boost::asio::buffer_size;
+        auto const n = buffer_copy(
+            db_.prepare(buffer_size(buffers)), buffers);
+        db_.commit(n);
+        return n;
+    }
+};
+
+// Returns the size of the serialized message given the size
+// `n` of the header, if the writer knows the body size, else
+// the size of the header.
+//
+template<class WritePreparation>
+std::size_t
+serialized_size(WritePreparation& wp,
+    std::size_t n, std::true_type)
+{
+    if(wp.chunked)
+        return n;
+    return n + static_cast<std::size_t>(wp.w.content_length());
+}
+
+template<class WritePreparation>
+std::size_t
+serialized_size(WritePreparation&,
+    std::size_t n, std::false_type)
+{
+    return n;
+}
+
+// Copy the serialized start line and fields
+// to the beginning of a buffer sequence.
+//
+template<class MutableBufferSequence,
+    bool isRequest, class Body, class Headers>
+void
+copy_header(MutableBufferSequence const& buffers,
+    message<isRequest, Body, Headers> const& msg)
+{
+    using boost::asio::buffer;
+    using boost::asio::buffer_copy;
+    consuming_buffers<MutableBufferSequence> cb{buffers};
+    for_each_header(msg,
+        [&](boost::string_ref const& s)
+        {
+            cb.consume(buffer_copy(
+                cb, buffer(s.data(), s.size())));
+        });
+}
+
 } // detail
 
 template<bool isRequest, class Body, class Headers>
@@ -667,6 +1229,88 @@ operator<<(std::ostream& os,
     return os;
 }
 
+template<class DynamicBuffer,
+    bool isRequest, class Body, class Headers>
+void
+serialize_to(DynamicBuffer& dynabuf,
+    message<isRequest, Body, Headers> const& msg)
+{
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    error_code ec;
+    serialize_to(dynabuf, msg, ec);
+    if(ec)
+        throw system_error{ec};
+}
+
+template<class DynamicBuffer,
+    bool isRequest, class Body, class Headers>
+void
+serialize_to(DynamicBuffer& dynabuf,
+    message<isRequest, Body, Headers> const& msg,
+        error_code& ec)
+{
+    static_assert(is_DynamicBuffer<DynamicBuffer>::value,
+        "DynamicBuffer requirements not met");
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_writer<Body>::value,
+        "Body has no writer");
+    static_assert(is_Writer<typename Body::writer,
+        message<isRequest, Body, Headers>>::value,
+            "Writer requirements not met");
+    detail::write_preparation<isRequest, Body, Headers> wp(msg);
+    wp.init_writer(ec);
+    if(ec)
+        return;
+    // Reserve space for the whole message up front, and
+    // serialize the header directly into the reserved space.
+    auto const n = detail::header_size(msg);
+    detail::copy_header(dynabuf.prepare(detail::serialized_size(
+        wp, n, detail::has_content_length<
+            typename Body::writer>{})), msg);
+    dynabuf.commit(n);
+    wp.header_written = true;
+    detail::dynabuf_SyncStream<DynamicBuffer> ss{dynabuf};
+    detail::write_prepared(ss, wp, ec);
+    if(ec == boost::asio::error::eof)
+        ec = {};
+}
+
+template<bool isRequest, class Body, class Headers>
+std::string
+to_string(message<isRequest, Body, Headers> const& msg)
+{
+    static_assert(is_Body<Body>::value,
+        "Body requirements not met");
+    static_assert(has_writer<Body>::value,
+        "Body has no writer");
+    static_assert(is_Writer<typename Body::writer,
+        message<isRequest, Body, Headers>>::value,
+            "Writer requirements not met");
+    detail::write_preparation<isRequest, Body, Headers> wp(msg);
+    error_code ec;
+    wp.init_writer(ec);
+    if(ec)
+        throw system_error{ec};
+    // Reserve space for the whole message up front, and
+    // serialize the header directly into the reserved space.
+    std::string s;
+    s.reserve(detail::serialized_size(wp, detail::header_size(msg),
+        detail::has_content_length<typename Body::writer>{}));
+    detail::for_each_header(msg,
+        [&](boost::string_ref const& sv)
+        {
+            s.append(sv.data(), sv.size());
+        });
+    wp.header_written = true;
+    detail::string_SyncStream ss{s};
+    detail::write_prepared(ss, wp, ec);
+    if(ec && ec != boost::asio::error::eof)
+        throw system_error{ec};
+    return s;
+}
+
 } // http
 } // beast
 
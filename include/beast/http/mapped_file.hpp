@@ -0,0 +1,199 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_MAPPED_FILE_HPP
+#define BEAST_HTTP_MAPPED_FILE_HPP
+
+#include <beast/core/error.hpp>
+#include <boost/asio/buffer.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#ifndef BEAST_NO_MMAP
+# if defined(__unix__) || defined(__APPLE__)
+#  define BEAST_HTTP_DETAIL_MMAP 1
+# endif
+#endif
+
+namespace beast {
+namespace http {
+
+/** A read-only view of the contents of a file.
+
+    On POSIX systems the file is mapped into memory, so its pages
+    are shared with the operating system's file cache. On other
+    systems the contents are read into memory when the file is
+    opened.
+
+    Objects of this type are usually obtained from a
+    @ref mapped_file_cache and sent with @ref mmap_body.
+
+    @warning When the file is mapped, truncating it on disk makes
+    the pages past the new end of the file invalid. Reading them
+    raises `SIGBUS`, which terminates the process. Files which may
+    be truncated or rewritten in place while mapped should instead
+    be replaced by renaming a new file over them, or the program
+    should be built with `BEAST_NO_MMAP` defined, which copies the
+    contents into memory when the file is opened.
+*/
+class mapped_file
+{
+    void const* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::uint64_t mtime_ = 0;
+#if ! BEAST_HTTP_DETAIL_MMAP
+    std::unique_ptr<char[]> buf_;
+#endif
+
+public:
+    /// Default constructor.
+    mapped_file() = default;
+
+    /// Copy constructor (disallowed).
+    mapped_file(mapped_file const&) = delete;
+
+    /// Copy assignment (disallowed).
+    mapped_file& operator=(mapped_file const&) = delete;
+
+    /// Destructor.
+    ~mapped_file();
+
+    /** Open a file.
+
+        Any previously opened file is closed first.
+
+        @param path The path of the file to open.
+
+        @param ec Set to the error, if any occurred.
+    */
+    void
+    open(std::string const& path, error_code& ec);
+
+    /// Close the file.
+    void
+    close();
+
+    /// Returns the contents of the file.
+    boost::asio::const_buffers_1
+    data() const
+    {
+        return {data_, size_};
+    }
+
+    /// Returns the size of the file.
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    /** Returns the modification time of the file when it was opened.
+
+        The value is only meaningful when compared with other values
+        returned by this function. Its resolution is the one provided
+        by the file system, down to one nanosecond.
+    */
+    std::uint64_t
+    mtime() const
+    {
+        return mtime_;
+    }
+};
+
+/** A cache of shared, read-only file mappings.
+
+    This container maps each file at most once and hands out shared
+    references to the mapping. Responses for the same file being sent
+    on many connections at once then use the same pages, instead of
+    each connection reading the file into its own buffer.
+
+    The cache holds up to a fixed number of files. When it is full,
+    the least recently used file is removed. A removed mapping stays
+    valid for as long as a response still refers to it.
+
+    Each lookup checks the size and modification time of the file,
+    and maps it again if it changed on disk. This only affects later
+    lookups. A response which is already being sent keeps using the
+    old mapping, so the file must not be truncated in the meantime;
+    see the warning on @ref mapped_file.
+
+    @par Thread Safety
+    @e Distinct @e objects: Safe.@n
+    @e Shared @e objects: Safe.
+*/
+class mapped_file_cache
+{
+    struct entry
+    {
+        std::string path;
+        std::shared_ptr<mapped_file const> file;
+    };
+
+    using list_type = std::list<entry>;
+
+    std::size_t capacity_;
+    list_type list_;
+    std::unordered_map<std::string,
+        list_type::iterator> map_;
+    mutable std::mutex m_;
+
+public:
+    /** Constructor.
+
+        @param capacity The largest number of files to keep mapped.
+    */
+    explicit
+    mapped_file_cache(std::size_t capacity = 64);
+
+    /// Copy constructor (disallowed).
+    mapped_file_cache(mapped_file_cache const&) = delete;
+
+    /// Copy assignment (disallowed).
+    mapped_file_cache& operator=(mapped_file_cache const&) = delete;
+
+    /// Returns the largest number of files kept mapped.
+    std::size_t
+    capacity() const
+    {
+        return capacity_;
+    }
+
+    /// Returns the number of files currently in the cache.
+    std::size_t
+    size() const;
+
+    /** Return the mapping of a file, opening it if needed.
+
+        @param path The path of the file.
+
+        @param ec Set to the error, if any occurred.
+
+        @return A shared reference to the mapping, or `nullptr`
+        if an error occurred.
+    */
+    std::shared_ptr<mapped_file const>
+    get(std::string const& path, error_code& ec);
+
+    /** Remove all files from the cache.
+
+        Mappings still in use remain valid until released.
+    */
+    void
+    clear();
+};
+
+} // http
+} // beast
+
+#include <beast/http/impl/mapped_file.ipp>
+
+#endif
@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_MMAP_BODY_HPP
+#define BEAST_HTTP_MMAP_BODY_HPP
+
+#include <beast/http/body_type.hpp>
+#include <beast/http/mapped_file.hpp>
+#include <beast/core/error.hpp>
+#include <boost/logic/tribool.hpp>
+#include <cstdint>
+#include <memory>
+
+namespace beast {
+namespace http {
+
+/** A Body which sends a memory mapped file.
+
+    The body of the message is a shared reference to a
+    @ref mapped_file, usually obtained from a @ref mapped_file_cache.
+    The writer presents the mapped region to the write operation as
+    a single buffer, so the file is sent without being copied into
+    an intermediate buffer. Any number of messages may share the
+    same mapping.
+
+    Example:
+    @code
+    mapped_file_cache cache;
+    ...
+    response<mmap_body> res;
+    res.body = cache.get(path, ec);
+    @endcode
+
+    This body has no reader, it can only be used for sending.
+
+    @warning On POSIX systems the file must not be truncated while
+    a message referring to it is being sent. Reading a page of the
+    mapping beyond the new end of the file raises `SIGBUS`, which
+    terminates the process. Replace served files by writing a new
+    file and renaming it over the old one, which leaves existing
+    mappings intact. When files may be truncated in place, define
+    `BEAST_NO_MMAP` so that their contents are copied into memory.
+
+    Meets the requirements of @b `Body`.
+*/
+struct mmap_body
+{
+    /// The type of the `message::body` member
+    using value_type = std::shared_ptr<mapped_file const>;
+
+#if GENERATING_DOCS
+private:
+#endif
+
+    class writer
+    {
+        value_type const& body_;
+
+    public:
+        writer(writer const&) = delete;
+        writer& operator=(writer const&) = delete;
+
+        template<bool isRequest, class Headers>
+        explicit
+        writer(message<isRequest,
+                mmap_body, Headers> const& m) noexcept
+            : body_(m.body)
+        {
+        }
+
+        void
+        init(error_code& ec) noexcept
+        {
+            if(! body_)
+                ec = errc::make_error_code(
+                    errc::bad_file_descriptor);
+        }
+
+        std::uint64_t
+        content_length() const noexcept
+        {
+            return body_->size();
+        }
+
+        template<class WriteFunction>
+        boost::tribool
+        write(resume_context&&, error_code&,
+            WriteFunction&& wf) noexcept
+        {
+            wf(body_->data());
+            return true;
+        }
+    };
+};
+
+} // http
+} // beast
+
+#endif
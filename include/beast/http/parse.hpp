@@ -132,6 +132,11 @@ parse(SyncReadStream& stream,
     immediately or not, the handler will not be invoked from within
     this function. Invocation of the handler will be performed in a
     manner equivalent to using `boost::asio::io_service::post`.
+
+    As an exception, if the handler was returned by @ref allow_inline
+    and the stream buffer already holds a complete message, the
+    handler is invoked in a manner equivalent to using
+    `boost::asio::io_service::dispatch`.
 */
 template<class AsyncReadStream,
     class DynamicBuffer, class Parser, class ReadHandler>
@@ -10,7 +10,9 @@
 
 #include <beast/core/async_completion.hpp>
 #include <beast/core/error.hpp>
+#include <beast/http/allow_inline.hpp>
 #include <beast/http/message.hpp>
+#include <vector>
 
 namespace beast {
 namespace http {
@@ -125,6 +127,11 @@ read(SyncReadStream& stream, DynamicBuffer& dynabuf,
     immediately or not, the handler will not be invoked from within
     this function. Invocation of the handler will be performed in a
     manner equivalent to using `boost::asio::io_service::post`.
+
+    As an exception, if the handler was returned by @ref allow_inline
+    and the stream buffer already holds a complete message, the
+    handler is invoked in a manner equivalent to using
+    `boost::asio::io_service::dispatch`.
 */
 template<class AsyncReadStream, class DynamicBuffer,
     bool isRequest, class Body, class Headers,
@@ -139,6 +146,145 @@ async_read(AsyncReadStream& stream, DynamicBuffer& dynabuf,
     message<isRequest, Body, Headers>& msg,
         ReadHandler&& handler);
 
+/** Read a batch of pipelined HTTP/1 messages from a stream.
+
+    This function is used to synchronously read one or more messages
+    from the stream. It first reads a message as if by calling
+    @ref read. Then, every complete message which remains in the
+    stream buffer is parsed as well, without reading from the stream
+    again. This allows a server whose clients pipeline requests to
+    handle all of the requests received together, with one call.
+
+    The batch ends at the first message which would require reading
+    from the stream, or after a message which does not keep the
+    connection alive or which is an upgrade request, since octets
+    following such a message are not meant for the HTTP parser.
+    Bytes belonging to messages not in the batch are left in the
+    stream buffer, and are used by subsequent calls.
+
+    @param stream The stream from which the data is to be read.
+    The type must support the @b `SyncReadStream` concept.
+
+    @param dynabuf A @b `DynamicBuffer` holding additional bytes
+    read by the implementation from the stream. This is both
+    an input and an output parameter; on entry, any data in the
+    stream buffer's input sequence will be given to the parser
+    first.
+
+    @param msgs A container to store the messages. Any contents
+    will be replaced. Upon success, this holds at least one message.
+
+    @throws system_error Thrown on failure.
+*/
+template<class SyncReadStream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+read_batch(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    std::vector<message<isRequest, Body, Headers>, Allocator>& msgs);
+
+/** Read a batch of pipelined HTTP/1 messages from a stream.
+
+    This function is used to synchronously read one or more messages
+    from the stream. It first reads a message as if by calling
+    @ref read. Then, every complete message which remains in the
+    stream buffer is parsed as well, without reading from the stream
+    again. This allows a server whose clients pipeline requests to
+    handle all of the requests received together, with one call.
+
+    The batch ends at the first message which would require reading
+    from the stream, or after a message which does not keep the
+    connection alive or which is an upgrade request, since octets
+    following such a message are not meant for the HTTP parser.
+    Bytes belonging to messages not in the batch are left in the
+    stream buffer, and are used by subsequent calls.
+
+    @param stream The stream from which the data is to be read.
+    The type must support the @b `SyncReadStream` concept.
+
+    @param dynabuf A @b `DynamicBuffer` holding additional bytes
+    read by the implementation from the stream. This is both
+    an input and an output parameter; on entry, any data in the
+    stream buffer's input sequence will be given to the parser
+    first.
+
+    @param msgs A container to store the messages. Any contents
+    will be replaced. Upon success, this holds at least one message.
+
+    @param ec Set to the error, if any occurred.
+*/
+template<class SyncReadStream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+read_batch(SyncReadStream& stream, DynamicBuffer& dynabuf,
+    std::vector<message<isRequest, Body, Headers>, Allocator>& msgs,
+        error_code& ec);
+
+/** Start an asynchronous operation to read a batch of pipelined HTTP/1 messages.
+
+    This function is used to asynchronously read one or more messages
+    from the stream. The function call always returns immediately.
+    The operation first reads a message as if by calling
+    @ref async_read. Then, every complete message which remains in
+    the stream buffer is parsed as well, without reading from the
+    stream again, and the handler is invoked once for the entire
+    batch. This allows a server whose clients pipeline requests to
+    handle all of the requests received together, with one
+    completion.
+
+    The batch ends at the first message which would require reading
+    from the stream, or after a message which does not keep the
+    connection alive or which is an upgrade request, since octets
+    following such a message are not meant for the HTTP parser.
+    Bytes belonging to messages not in the batch are left in the
+    stream buffer, and are used by subsequent calls.
+
+    This operation is implemented in terms of one or more calls to the
+    next layer's `async_read_some` function, and is known as a
+    <em>composed operation</em>. The program must ensure that the stream
+    performs no other operations until this operation completes.
+
+    @param stream The stream to read the messages from.
+    The type must support the @b `AsyncReadStream` concept.
+
+    @param dynabuf A @b `DynamicBuffer` holding additional bytes
+    read by the implementation from the stream. This is both
+    an input and an output parameter; on entry, any data in the
+    stream buffer's input sequence will be given to the parser
+    first.
+
+    @param msgs A container to store the messages. Any contents
+    will be replaced. Upon success, this holds at least one message.
+    The container must remain valid until the handler is called.
+
+    @param handler The handler to be called when the request completes.
+    Copies will be made of the handler as required. The equivalent
+    function signature of the handler must be:
+    @code void handler(
+        error_code const& error // result of operation
+    ); @endcode
+    Regardless of whether the asynchronous operation completes
+    immediately or not, the handler will not be invoked from within
+    this function. Invocation of the handler will be performed in a
+    manner equivalent to using `boost::asio::io_service::post`.
+
+    As an exception, if the handler was returned by @ref allow_inline
+    and the stream buffer already holds a complete message, the
+    handler is invoked in a manner equivalent to using
+    `boost::asio::io_service::dispatch`.
+*/
+template<class AsyncReadStream, class DynamicBuffer,
+    bool isRequest, class Body, class Headers, class Allocator,
+        class ReadHandler>
+#if GENERATING_DOCS
+void_or_deduced
+#else
+typename async_completion<
+    ReadHandler, void(error_code)>::result_type
+#endif
+async_read_batch(AsyncReadStream& stream, DynamicBuffer& dynabuf,
+    std::vector<message<isRequest, Body, Headers>, Allocator>& msgs,
+        ReadHandler&& handler);
+
 } // http
 } // beast
 
@@ -0,0 +1,220 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_SERIALIZER_HPP
+#define BEAST_HTTP_SERIALIZER_HPP
+
+#include <beast/http/message.hpp>
+#include <beast/http/resume_context.hpp>
+#include <beast/http/detail/chunk_encode.hpp>
+#include <beast/http/detail/write_preparation.hpp>
+#include <beast/core/error.hpp>
+#include <boost/asio/buffer.hpp>
+#include <deque>
+#include <vector>
+
+namespace beast {
+namespace http {
+
+namespace detail {
+struct serializer_access;
+} // detail
+
+/** Serializes a HTTP/1 message into buffers on demand.
+
+    This object produces the serialized representation of a message
+    as a series of buffer sequences, without performing any I/O.
+    Each call to @ref next returns the buffers which come next in
+    the message, and the caller reports how many octets it used
+    with @ref consume. This allows the output of several messages
+    to be gathered into one write, sent through a custom event loop,
+    or stored in memory.
+
+    The serializer applies the same rules as @ref write. It performs
+    chunk encoding when the message specifies it, and it indicates
+    whether the connection should be closed after the message.
+
+    Buffers returned by @ref next may refer to the message body and
+    to storage owned by the serializer. They remain valid until the
+    octets they represent are consumed, or until the serializer is
+    destroyed, whichever comes first.
+
+    Example:
+    @code
+    serializer<false, string_body, headers> sr{res};
+    do
+    {
+        auto const buffers = sr.next(ec);
+        if(ec)
+            break;
+        sr.consume(sock.write_some(buffers));
+    }
+    while(! sr.is_done());
+    @endcode
+
+    A serializer may also be passed to @ref prepare, which then
+    initializes the body writer only once for both preparation and
+    serialization, and written with @ref write or @ref async_write.
+
+    @note The message must remain valid for the lifetime of the
+    serializer. Its headers may only be modified by @ref prepare,
+    and only before the first call to @ref next.
+*/
+template<bool isRequest, class Body, class Headers>
+class serializer
+{
+    enum
+    {
+        s_init,
+        s_body,
+        s_done
+    };
+
+    class append;
+
+    friend struct detail::serializer_access;
+
+    detail::write_preparation<isRequest, Body, Headers> wp_;
+    resume_context resume_;
+    std::vector<boost::asio::const_buffer> v_;
+    std::deque<detail::chunk_encode_text> chunk_;
+    std::size_t pos_ = 0;
+    int s_ = s_init;
+
+public:
+    /// The type of message this serializer produces.
+    using message_type =
+        message<isRequest, Body, Headers>;
+
+    /** The type of buffer sequence returned by @ref next.
+
+        Meets the requirements of @b ConstBufferSequence.
+    */
+#if GENERATING_DOCS
+    using const_buffers_type = implementation_defined;
+#else
+    class const_buffers_type;
+#endif
+
+    /// Copy constructor (disallowed)
+    serializer(serializer const&) = delete;
+
+    /// Copy assignment (disallowed)
+    serializer& operator=(serializer const&) = delete;
+
+    /** Construct the serializer.
+
+        @param msg The message to serialize. The message is not
+        copied, and must remain valid for the lifetime of the
+        serializer.
+    */
+    explicit
+    serializer(message_type const& msg);
+
+    /** Construct the serializer.
+
+        @param msg The message to serialize. The message is not
+        copied, and must remain valid for the lifetime of the
+        serializer.
+
+        @param resume The function to call when a body writer
+        which previously suspended is ready to produce more data.
+        See @ref next.
+    */
+    serializer(message_type const& msg, resume_context resume);
+
+    /// Returns `true` when the entire message has been consumed.
+    bool
+    is_done() const
+    {
+        return s_ == s_done && pos_ == v_.size();
+    }
+
+    /** Returns `true` if the connection may be kept open.
+
+        When this returns `false`, the semantics of the message
+        require that the connection be closed after it is sent.
+    */
+    bool
+    keep_alive() const
+    {
+        return ! wp_.close;
+    }
+
+    /** Returns the next buffers in the serialized message.
+
+        If octets from a previous call remain unconsumed, those
+        are returned again. Otherwise the body writer is asked for
+        more data. The first call also serializes the headers,
+        which are returned together with the first body data.
+
+        When the body writer suspends, this function returns an
+        empty buffer sequence while @ref is_done returns `false`.
+        The resume context passed on construction is invoked when
+        the writer is ready, after which `next` may be called again.
+
+        @param ec Set to the error, if any occurred.
+
+        @return The buffers to send. The sequence is empty if the
+        message is done, the writer suspended, or an error occurred.
+    */
+    const_buffers_type
+    next(error_code& ec);
+
+    /** Consume octets from the buffers returned by @ref next.
+
+        @param n The number of octets consumed. Values greater
+        than the size of the buffers returned by the last call
+        to @ref next are clamped.
+    */
+    void
+    consume(std::size_t n);
+};
+
+/** Prepare a HTTP message for serialization.
+
+    This function behaves like the overload of @ref prepare which
+    takes only the message, except that the body writer of the
+    serializer is used to determine the content length. The writer
+    stays initialized, so when the serializer produces the message
+    the writer is not constructed or initialized a second time.
+    For bodies whose initialization is expensive, such as opening
+    a file or generating content, the cost is paid once.
+
+    Example:
+    @code
+    response<file_body> res;
+    ...
+    serializer<false, file_body, headers> sr{res};
+    prepare(res, sr);
+    write(sock, sr);
+    @endcode
+
+    @param msg The message to prepare. The headers may be modified.
+
+    @param sr A serializer constructed from `msg`, which has not
+    produced any buffers yet.
+
+    @param options A list of prepare options.
+
+    @throws system_error Thrown if the body writer fails to
+    initialize.
+*/
+template<
+    bool isRequest, class Body, class Headers,
+    class... Options>
+void
+prepare(message<isRequest, Body, Headers>& msg,
+    serializer<isRequest, Body, Headers>& sr,
+        Options&&... options);
+
+} // http
+} // beast
+
+#include <beast/http/impl/serializer.ipp>
+
+#endif
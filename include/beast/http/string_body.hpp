@@ -9,9 +9,12 @@
 #define BEAST_HTTP_STRING_BODY_HPP
 
 #include <beast/http/body_type.hpp>
+#include <beast/core/error.hpp>
 #include <beast/core/detail/type_traits.hpp>
 #include <boost/asio/buffer.hpp>
 #include <memory>
+#include <new>
+#include <stdexcept>
 #include <string>
 
 namespace beast {
@@ -19,6 +22,11 @@ namespace http {
 
 /** A Body represented by a std::string.
 
+    When a body is read directly into the string, storage for
+    each read is zero-filled before it is overwritten, unless
+    the standard library provides `resize_and_overwrite`. Use
+    @ref streambuf_body to read large bodies without the fill.
+
     Meets the requirements of @b `Body`.
 */
 struct string_body
@@ -33,6 +41,7 @@ private:
     class reader
     {
         value_type& s_;
+        std::size_t len_ = 0;
 
     public:
         template<bool isRequest, class Headers>
@@ -56,6 +65,52 @@ private:
             s_.resize(n + size);
             std::memcpy(&s_[n], data, size);
         }
+
+        boost::asio::mutable_buffers_1
+        prepare(std::size_t n, error_code& ec)
+        {
+            len_ = s_.size();
+            try
+            {
+                grow(len_ + n);
+            }
+            catch(std::length_error const&)
+            {
+                ec = errc::make_error_code(
+                    errc::value_too_large);
+                n = 0;
+            }
+            catch(std::bad_alloc const&)
+            {
+                ec = errc::make_error_code(
+                    errc::not_enough_memory);
+                n = 0;
+            }
+            return {&s_[len_], n};
+        }
+
+        void
+        commit(std::size_t n, error_code&)
+        {
+            s_.resize(len_ + n);
+        }
+
+    private:
+        // The prepared octets are overwritten by the read,
+        // so avoid filling them where the library allows it.
+        void
+        grow(std::size_t size)
+        {
+#ifdef __cpp_lib_string_resize_and_overwrite
+            s_.resize_and_overwrite(size,
+                [](char*, std::size_t n)
+                {
+                    return n;
+                });
+#else
+            s_.resize(size);
+#endif
+        }
     };
 
     class writer
@@ -8,10 +8,13 @@
 #ifndef BEAST_HTTP_WRITE_HPP
 #define BEAST_HTTP_WRITE_HPP
 
+#include <beast/http/header_buffer.hpp>
 #include <beast/http/message.hpp>
+#include <beast/http/serializer.hpp>
 #include <beast/core/error.hpp>
 #include <beast/core/async_completion.hpp>
 #include <ostream>
+#include <string>
 #include <type_traits>
 
 namespace beast {
@@ -80,6 +83,57 @@ write(SyncWriteStream& stream,
     message<isRequest, Body, Headers> const& msg,
         error_code& ec);
 
+/** Write a HTTP/1 message on a stream, reusing a header buffer.
+
+    This function behaves like the overload without a buffer,
+    except that the start line and header fields are serialized
+    into `buffer`. Storage allocated by the buffer is retained
+    when the function returns, so passing the same buffer to
+    each call avoids allocating for the headers of every message
+    written on a connection.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the @b `SyncWriteStream` concept.
+
+    @param msg The message to write.
+
+    @param buffer The buffer to serialize the headers into.
+
+    @throws system_error Thrown on failure.
+*/
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+write(SyncWriteStream& stream,
+    message<isRequest, Body, Headers> const& msg,
+        basic_header_buffer<Allocator>& buffer);
+
+/** Write a HTTP/1 message on a stream, reusing a header buffer.
+
+    This function behaves like the overload without a buffer,
+    except that the start line and header fields are serialized
+    into `buffer`. Storage allocated by the buffer is retained
+    when the function returns, so passing the same buffer to
+    each call avoids allocating for the headers of every message
+    written on a connection.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the @b `SyncWriteStream` concept.
+
+    @param msg The message to write.
+
+    @param buffer The buffer to serialize the headers into.
+
+    @param ec Set to the error, if any occurred.
+*/
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers, class Allocator>
+void
+write(SyncWriteStream& stream,
+    message<isRequest, Body, Headers> const& msg,
+        basic_header_buffer<Allocator>& buffer,
+            error_code& ec);
+
 /** Start an asynchronous operation to write a HTTP/1 message to a stream.
 
     This function is used to asynchronously write a message to a stream.
@@ -135,6 +189,137 @@ async_write(AsyncWriteStream& stream,
     message<isRequest, Body, Headers> const& msg,
         WriteHandler&& handler);
 
+/** Start an asynchronous operation to write a HTTP/1 message to a stream.
+
+    This function behaves like the overload without a buffer,
+    except that the start line and header fields are serialized
+    into `buffer`. Storage allocated by the buffer is retained
+    when the operation completes, so passing the same buffer to
+    each call avoids allocating for the headers of every message
+    written on a connection.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the @b `AsyncWriteStream` concept.
+
+    @param msg The message to send.
+
+    @param buffer The buffer to serialize the headers into.
+
+    @param handler The handler to be called when the request completes.
+    Copies will be made of the handler as required. The equivalent
+    function signature of the handler must be:
+    @code void handler(
+        error_code const& error // result of operation
+    ); @endcode
+    Regardless of whether the asynchronous operation completes
+    immediately or not, the handler will not be invoked from within
+    this function. Invocation of the handler will be performed in a
+    manner equivalent to using `boost::asio::io_service::post`.
+
+    @note The message object and the buffer must remain valid at
+          least until the completion handler is called, no copies
+          are made.
+*/
+template<class AsyncWriteStream,
+    bool isRequest, class Body, class Headers,
+        class Allocator, class WriteHandler>
+#if GENERATING_DOCS
+void_or_deduced
+#else
+typename async_completion<
+    WriteHandler, void(error_code)>::result_type
+#endif
+async_write(AsyncWriteStream& stream,
+    message<isRequest, Body, Headers> const& msg,
+        basic_header_buffer<Allocator>& buffer,
+            WriteHandler&& handler);
+
+/** Write the message of a serializer on a stream.
+
+    This function behaves like the overload which takes a message,
+    except that the body writer of the serializer is used. When the
+    serializer was passed to @ref prepare, the writer was already
+    initialized there, and is not initialized again.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the @b `SyncWriteStream` concept.
+
+    @param sr The serializer holding the message to write. It must
+    not have produced any buffers, and it may not be used after
+    this call.
+
+    @throws system_error Thrown on failure.
+*/
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers>
+void
+write(SyncWriteStream& stream,
+    serializer<isRequest, Body, Headers>& sr);
+
+/** Write the message of a serializer on a stream.
+
+    This function behaves like the overload which takes a message,
+    except that the body writer of the serializer is used. When the
+    serializer was passed to @ref prepare, the writer was already
+    initialized there, and is not initialized again.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the @b `SyncWriteStream` concept.
+
+    @param sr The serializer holding the message to write. It must
+    not have produced any buffers, and it may not be used after
+    this call.
+
+    @param ec Set to the error, if any occurred.
+*/
+template<class SyncWriteStream,
+    bool isRequest, class Body, class Headers>
+void
+write(SyncWriteStream& stream,
+    serializer<isRequest, Body, Headers>& sr,
+        error_code& ec);
+
+/** Start an asynchronous operation to write the message of a serializer.
+
+    This function behaves like the overload which takes a message,
+    except that the body writer of the serializer is used. When the
+    serializer was passed to @ref prepare, the writer was already
+    initialized there, and is not initialized again.
+
+    @param stream The stream to which the data is to be written.
+    The type must support the @b `AsyncWriteStream` concept.
+
+    @param sr The serializer holding the message to write. It must
+    not have produced any buffers, and it may not be used after the
+    operation completes.
+
+    @param handler The handler to be called when the request completes.
+    Copies will be made of the handler as required. The equivalent
+    function signature of the handler must be:
+    @code void handler(
+        error_code const& error // result of operation
+    ); @endcode
+    Regardless of whether the asynchronous operation completes
+    immediately or not, the handler will not be invoked from within
+    this function. Invocation of the handler will be performed in a
+    manner equivalent to using `boost::asio::io_service::post`.
+
+    @note The serializer and its message must remain valid at least
+          until the completion handler is called, no copies are made.
+*/
+template<class AsyncWriteStream,
+    bool isRequest, class Body, class Headers,
+        class WriteHandler>
+#if GENERATING_DOCS
+void_or_deduced
+#else
+typename async_completion<
+    WriteHandler, void(error_code)>::result_type
+#endif
+async_write(AsyncWriteStream& stream,
+    serializer<isRequest, Body, Headers>& sr,
+        WriteHandler&& handler);
+
 /** Serialize a HTTP/1 message to an ostream.
 
     The function converts the message to its HTTP/1 serialized
@@ -152,6 +337,75 @@ std::ostream&
 operator<<(std::ostream& os,
     message<isRequest, Body, Headers> const& msg);
 
+/** Serialize a HTTP/1 message into a dynamic buffer.
+
+    The function converts the message to its HTTP/1 serialized
+    representation and appends the result to the dynamic buffer.
+    Space for the start line, the fields, and the body is requested
+    from the buffer once, when the size of the body is known ahead of
+    time, so that the message is stored in a single allocation.
+
+    The implementation will automatically perform chunk encoding if
+    the contents of the message indicate that chunk encoding is required.
+    Unlike @ref write, no error is reported for messages which indicate
+    that the connection should be closed.
+
+    @param dynabuf The dynamic buffer to write to.
+
+    @param msg The message to write.
+
+    @throws system_error Thrown on failure.
+*/
+template<class DynamicBuffer,
+    bool isRequest, class Body, class Headers>
+void
+serialize_to(DynamicBuffer& dynabuf,
+    message<isRequest, Body, Headers> const& msg);
+
+/** Serialize a HTTP/1 message into a dynamic buffer.
+
+    The function converts the message to its HTTP/1 serialized
+    representation and appends the result to the dynamic buffer.
+    Space for the start line, the fields, and the body is requested
+    from the buffer once, when the size of the body is known ahead of
+    time, so that the message is stored in a single allocation.
+
+    The implementation will automatically perform chunk encoding if
+    the contents of the message indicate that chunk encoding is required.
+    Unlike @ref write, no error is reported for messages which indicate
+    that the connection should be closed.
+
+    @param dynabuf The dynamic buffer to write to.
+
+    @param msg The message to write.
+
+    @param ec Set to the error, if any occurred.
+*/
+template<class DynamicBuffer,
+    bool isRequest, class Body, class Headers>
+void
+serialize_to(DynamicBuffer& dynabuf,
+    message<isRequest, Body, Headers> const& msg,
+        error_code& ec);
+
+/** Return a HTTP/1 message serialized to a string.
+
+    The function converts the message to its HTTP/1 serialized
+    representation. The string is sized exactly once when the size
+    of the body is known ahead of time. This is considerably faster
+    than formatting the message with `operator<<`.
+
+    The implementation will automatically perform chunk encoding if
+    the contents of the message indicate that chunk encoding is required.
+
+    @param msg The message to convert.
+
+    @throws system_error Thrown on failure.
+*/
+template<bool isRequest, class Body, class Headers>
+std::string
+to_string(message<isRequest, Body, Headers> const& msg);
+
 } // http
 } // beast
 
@@ -17,6 +17,7 @@
 #include <beast/core/static_streambuf.hpp>
 #include <beast/core/stream_concepts.hpp>
 #include <beast/core/detail/clamp.hpp>
+#include <beast/core/detail/write_cached.hpp>
 #include <beast/websocket/detail/frame.hpp>
 #include <boost/assert.hpp>
 #include <algorithm>
@@ -166,7 +167,7 @@ public:
     template<class DeducedHandler, class... Args>
     write_frame_op(DeducedHandler&& h,
             stream<NextLayer>& ws, Args&&... args)
-        : d_(std::make_shared<data>(
+        : d_(std::allocate_shared<data>(alloc_type{h},
             std::forward<DeducedHandler>(h), ws,
                 std::forward<Args>(args)...))
     {
@@ -272,7 +273,7 @@ operator()(error_code ec, bool again)
                 d.state = 99;
                 BOOST_ASSERT(! d.ws.wr_block_);
                 d.ws.wr_block_ = &d;
-                boost::asio::async_write(d.ws.stream_,
+                beast::detail::async_write_cached(d.ws.stream_,
                     buffer_cat(d.fh_buf.data(), d.cb),
                         std::move(*this));
                 return;
@@ -287,7 +288,7 @@ operator()(error_code ec, bool again)
             d.state = d.remain > 0 ? 2 : 99;
             BOOST_ASSERT(! d.ws.wr_block_);
             d.ws.wr_block_ = &d;
-            boost::asio::async_write(d.ws.stream_,
+            beast::detail::async_write_cached(d.ws.stream_,
                 buffer_cat(d.fh_buf.data(),
                     mb), std::move(*this));
             return;
@@ -421,7 +422,7 @@ write_frame(bool fin,
         fh.len = remain;
         detail::fh_streambuf fh_buf;
         detail::write<static_streambuf>(fh_buf, fh);
-        boost::asio::write(stream_,
+        beast::detail::write_cached(stream_,
             buffer_cat(fh_buf.data(), buffers), ec);
         failed_ = ec != 0;
         if(failed_)
@@ -441,7 +442,7 @@ write_frame(bool fin,
             fh.fin = fin ? remain == 0 : false;
             detail::fh_streambuf fh_buf;
             detail::write<static_streambuf>(fh_buf, fh);
-            boost::asio::write(stream_,
+            beast::detail::write_cached(stream_,
                 buffer_cat(fh_buf.data(),
                     prepare_buffers(n, cb)), ec);
             failed_ = ec != 0;
@@ -472,7 +473,7 @@ write_frame(bool fin,
             cb.consume(n);
             remain -= n;
             detail::mask_inplace(mb, key);
-            boost::asio::write(stream_,
+            beast::detail::write_cached(stream_,
                 buffer_cat(fh_buf.data(), mb), ec);
             failed_ = ec != 0;
             if(failed_)
@@ -512,7 +513,7 @@ write_frame(bool fin,
             fh.fin = fin ? remain == 0 : false;
             detail::fh_streambuf fh_buf;
             detail::write<static_streambuf>(fh_buf, fh);
-            boost::asio::write(stream_,
+            beast::detail::write_cached(stream_,
                 buffer_cat(fh_buf.data(), mb), ec);
             failed_ = ec != 0;
             if(failed_)
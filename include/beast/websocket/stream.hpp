@@ -13,6 +13,7 @@
 #include <beast/http/message.hpp>
 #include <beast/http/string_body.hpp>
 #include <beast/core/dynabuf_readstream.hpp>
+#include <beast/core/flat_streambuf.hpp>
 #include <beast/core/async_completion.hpp>
 #include <beast/core/detail/get_lowest_layer.hpp>
 #include <boost/asio.hpp>
@@ -86,7 +87,7 @@ class stream : public detail::stream_base
 {
     friend class stream_test;
 
-    dynabuf_readstream<NextLayer, streambuf> stream_;
+    dynabuf_readstream<NextLayer, flat_streambuf> stream_;
 
 public:
     /// The type of the next layer.
@@ -15,8 +15,11 @@
 #include <boost/asio/buffer.hpp>
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace beast {
 
@@ -461,6 +464,71 @@ public:
         }
     }
 
+    // Repeatedly fill and drain short-lived stream buffers
+    template<class Streambuf>
+    static
+    std::size_t
+    churn(std::size_t n)
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        std::string const s(1500, '*');
+        std::size_t total = 0;
+        for(std::size_t i = 0; i < n; ++i)
+        {
+            Streambuf sb;
+            for(int j = 0; j < 4; ++j)
+                sb.commit(buffer_copy(
+                    sb.prepare(s.size()), buffer(s)));
+            total += sb.size();
+            sb.consume(sb.size() / 2);
+            sb.commit(buffer_copy(
+                sb.prepare(s.size()), buffer(s)));
+            total += sb.size();
+        }
+        return total;
+    }
+
+    void testPooled()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        using detail::block_pool;
+        {
+            pooled_streambuf sb(3);
+            std::string const s = "Hello, world";
+            sb.commit(buffer_copy(sb.prepare(5), buffer(s.data(), 5)));
+            sb.commit(buffer_copy(sb.prepare(7), buffer(s.data() + 5, 7)));
+            BEAST_EXPECT(to_string(sb.data()) == s);
+            pooled_streambuf sb2(sb);
+            sb.consume(7);
+            BEAST_EXPECT(to_string(sb.data()) == "world");
+            BEAST_EXPECT(to_string(sb2.data()) == s);
+        }
+        // Once warmed up, the elements come from the free lists
+        churn<pooled_streambuf>(1);
+        auto const n = block_pool::heap_allocations();
+        BEAST_EXPECT(block_pool::retained() > 0);
+        BEAST_EXPECT(churn<pooled_streambuf>(1000) ==
+            churn<streambuf>(1000));
+        BEAST_EXPECT(block_pool::heap_allocations() == n);
+        // Each thread has its own free lists
+        std::size_t n1 = 0;
+        std::size_t n2 = 0;
+        std::thread t(
+            [&]
+            {
+                churn<pooled_streambuf>(1000);
+                n1 = block_pool::heap_allocations();
+                churn<pooled_streambuf>(1000);
+                n2 = block_pool::heap_allocations();
+            });
+        t.join();
+        BEAST_EXPECT(n1 > 0);
+        BEAST_EXPECT(n1 == n2);
+        BEAST_EXPECT(block_pool::heap_allocations() == n);
+    }
+
     void run() override
     {
         testSpecialMembers();
@@ -472,9 +540,59 @@ public:
         testIterators();
         testOutputStream();
         testCapacity();
+        testPooled();
     }
 };
 
 BEAST_DEFINE_TESTSUITE(basic_streambuf,core,beast);
 
+//------------------------------------------------------------------------------
+
+class basic_streambuf_bench_test : public beast::unit_test::suite
+{
+public:
+    template<class Streambuf>
+    void
+    timedChurn(std::string const& name,
+        std::size_t threads, std::size_t n)
+    {
+        using clock_type = std::chrono::high_resolution_clock;
+        using std::chrono::duration_cast;
+        using std::chrono::milliseconds;
+        std::vector<std::thread> v;
+        v.reserve(threads);
+        auto const t0 = clock_type::now();
+        for(std::size_t i = 0; i < threads; ++i)
+            v.emplace_back(
+                [n]
+                {
+                    basic_streambuf_test::churn<Streambuf>(n);
+                });
+        for(auto& t : v)
+            t.join();
+        auto const elapsed = clock_type::now() - t0;
+        log << name << ", " << threads << " threads: " <<
+            duration_cast<milliseconds>(elapsed).count() <<
+                " ms" << std::endl;
+    }
+
+    void
+    run() override
+    {
+        static std::size_t constexpr N = 10000;
+        auto const threads = (std::max)(4u,
+            std::thread::hardware_concurrency());
+        for(std::size_t i = 1; i <= threads; i *= 2)
+        {
+            testcase << "Churn " << N << " buffers on " <<
+                i << " threads";
+            timedChurn<streambuf>("streambuf", i, N);
+            timedChurn<pooled_streambuf>("pooled_streambuf", i, N);
+            pass();
+        }
+    }
+};
+
+BEAST_DEFINE_TESTSUITE_MANUAL(basic_streambuf_bench,core,beast);
+
 } // beast
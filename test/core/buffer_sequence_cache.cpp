@@ -0,0 +1,315 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/buffer_sequence_cache.hpp>
+
+#include <beast/core/bind_handler.hpp>
+#include <beast/core/buffer_cat.hpp>
+#include <beast/core/consuming_buffers.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/core/detail/write_cached.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/write.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iterator>
+#include <string>
+
+namespace beast {
+
+class buffer_sequence_cache_test : public beast::unit_test::suite
+{
+public:
+    // A stream which accepts at most `limit` bytes per write
+    class limited_ostream
+    {
+        boost::asio::io_service& ios_;
+        std::size_t limit_;
+
+    public:
+        std::string str;
+        std::size_t calls = 0;
+
+        limited_ostream(boost::asio::io_service& ios,
+                std::size_t limit)
+            : ios_(ios)
+            , limit_(limit)
+        {
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(ConstBufferSequence const& buffers,
+            error_code& ec)
+        {
+            using boost::asio::buffer;
+            using boost::asio::buffer_copy;
+            using boost::asio::buffer_size;
+            ++calls;
+            ec = {};
+            auto const n = (std::min)(
+                limit_, buffer_size(buffers));
+            auto const pos = str.size();
+            str.resize(pos + n);
+            return buffer_copy(buffer(&str[pos], n), buffers);
+        }
+
+        template<class ConstBufferSequence, class WriteHandler>
+        void
+        async_write_some(ConstBufferSequence const& buffers,
+            WriteHandler&& handler)
+        {
+            error_code ec;
+            auto const n = write_some(buffers, ec);
+            ios_.post(bind_handler(
+                std::forward<WriteHandler>(handler), ec, n));
+        }
+    };
+
+    // Accepts at most `limit` bytes per write, discarding them
+    class null_ostream
+    {
+        boost::asio::io_service& ios_;
+        std::size_t limit_;
+
+    public:
+        null_ostream(boost::asio::io_service& ios,
+                std::size_t limit)
+            : ios_(ios)
+            , limit_(limit)
+        {
+        }
+
+        boost::asio::io_service&
+        get_io_service()
+        {
+            return ios_;
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(ConstBufferSequence const& buffers,
+            error_code& ec)
+        {
+            using boost::asio::buffer_size;
+            ec = {};
+            std::size_t n = 0;
+            for(auto it = buffers.begin();
+                    it != buffers.end() && n < limit_; ++it)
+                n += (std::min)(limit_ - n, buffer_size(*it));
+            return n;
+        }
+
+        template<class ConstBufferSequence, class WriteHandler>
+        void
+        async_write_some(ConstBufferSequence const& buffers,
+            WriteHandler&& handler)
+        {
+            error_code ec;
+            auto const n = write_some(buffers, ec);
+            ios_.post(bind_handler(
+                std::forward<WriteHandler>(handler), ec, n));
+        }
+    };
+
+    template<class BufferSequence>
+    static
+    std::size_t
+    count(BufferSequence const& bs)
+    {
+        return std::distance(bs.begin(), bs.end());
+    }
+
+    void testFlatten()
+    {
+        using boost::asio::const_buffers_1;
+        std::string const s = "Hello, world";
+        auto bs = buffer_cat(
+            const_buffers_1{s.data(), 5},
+            const_buffers_1{s.data(), 0},
+            const_buffers_1{s.data() + 5, 2},
+            const_buffers_1{s.data() + 7, 5});
+        buffer_sequence_cache<decltype(bs)> cb(bs);
+        BEAST_EXPECT(count(cb) == 3);
+        BEAST_EXPECT(to_string(cb) == s);
+        BEAST_EXPECT(! cb.empty());
+        for(std::size_t i = 0; i <= s.size() + 1; ++i)
+        {
+            buffer_sequence_cache<decltype(bs)> cb1(bs);
+            consuming_buffers<decltype(bs)> cb2(bs);
+            cb1.consume(i);
+            cb2.consume(i);
+            BEAST_EXPECT(to_string(cb1) == to_string(cb2));
+            BEAST_EXPECT(cb1.empty() == (i >= s.size()));
+        }
+    }
+
+    void testCapacity()
+    {
+        using boost::asio::const_buffer;
+        std::string const s = "abcdefghij";
+        std::array<const_buffer, 10> v;
+        for(std::size_t i = 0; i < v.size(); ++i)
+            v[i] = const_buffer{&s[i], 1};
+        // Only two buffers are presented at once
+        buffer_sequence_cache<decltype(v), 2> cb(v);
+        std::string got;
+        while(! cb.empty())
+        {
+            BEAST_EXPECT(count(cb) <= 2);
+            got += to_string(cb).substr(0, 1);
+            cb.consume(1);
+        }
+        BEAST_EXPECT(got == s);
+        for(std::size_t i = 0; i <= s.size(); ++i)
+        {
+            buffer_sequence_cache<decltype(v), 3> cb1(v);
+            cb1.consume(i);
+            std::string rest;
+            while(! cb1.empty())
+            {
+                auto const t = to_string(cb1);
+                rest += t;
+                cb1.consume(t.size());
+            }
+            BEAST_EXPECT(rest == s.substr(i));
+        }
+    }
+
+    void testSpecialMembers()
+    {
+        using boost::asio::const_buffers_1;
+        std::string const s = "Hello, world";
+        auto bs = buffer_cat(
+            const_buffers_1{s.data(), 5},
+            const_buffers_1{s.data() + 5, 7});
+        buffer_sequence_cache<decltype(bs)> cb(bs);
+        cb.consume(3);
+        {
+            auto cb2 = cb;
+            BEAST_EXPECT(to_string(cb2) == "lo, world");
+            auto cb3 = std::move(cb2);
+            BEAST_EXPECT(to_string(cb3) == "lo, world");
+        }
+        {
+            buffer_sequence_cache<decltype(bs)> cb2(bs);
+            cb2 = cb;
+            BEAST_EXPECT(to_string(cb2) == "lo, world");
+            cb2.consume(4);
+            cb = std::move(cb2);
+            BEAST_EXPECT(to_string(cb) == "world");
+        }
+    }
+
+    void testWrite()
+    {
+        using boost::asio::const_buffers_1;
+        std::string const s(1000, '*');
+        auto bs = buffer_cat(
+            const_buffers_1{s.data(), 300},
+            const_buffers_1{s.data() + 300, 0},
+            const_buffers_1{s.data() + 300, 700});
+        boost::asio::io_service ios;
+        {
+            limited_ostream os(ios, 64);
+            error_code ec;
+            auto const n = detail::write_cached(os, bs, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(n == s.size());
+            BEAST_EXPECT(os.str == s);
+            BEAST_EXPECT(os.calls == 16);
+        }
+        {
+            limited_ostream os(ios, 64);
+            error_code result;
+            std::size_t n = 0;
+            bool invoked = false;
+            detail::async_write_cached(os, bs,
+                [&](error_code const& ec, std::size_t bytes)
+                {
+                    invoked = true;
+                    result = ec;
+                    n = bytes;
+                });
+            BEAST_EXPECT(! invoked);
+            ios.run();
+            BEAST_EXPECT(invoked);
+            BEAST_EXPECTS(! result, result.message());
+            BEAST_EXPECT(n == s.size());
+            BEAST_EXPECT(os.str == s);
+            BEAST_EXPECT(os.calls == 16);
+        }
+    }
+
+    // Compare the time to write a sequence of many
+    // buffers in several partial writes with and
+    // without the cache.
+    void testBench()
+    {
+        using clock_type = std::chrono::high_resolution_clock;
+        using namespace std::chrono;
+        using boost::asio::const_buffers_1;
+        static std::size_t constexpr Repeat = 20000;
+        std::string const s(4096, '*');
+        auto const bs = buffer_cat(
+            const_buffers_1{s.data(), 100},
+            const_buffers_1{s.data() + 100, 2},
+            const_buffers_1{s.data() + 102, 6},
+            const_buffers_1{s.data() + 108, 2},
+            const_buffers_1{s.data() + 110, 3000},
+            const_buffers_1{s.data() + 3110, 2},
+            const_buffers_1{s.data() + 3112, 5},
+            const_buffers_1{s.data() + 3117, 979});
+        boost::asio::io_service ios;
+        null_ostream os(ios, 512);
+        auto const measure =
+            [&](bool cached)
+            {
+                std::size_t total = 0;
+                auto const handler =
+                    [&](error_code const&, std::size_t n)
+                    {
+                        total += n;
+                    };
+                auto const start = clock_type::now();
+                for(std::size_t i = 0; i < Repeat; ++i)
+                {
+                    if(cached)
+                        detail::async_write_cached(os, bs, handler);
+                    else
+                        boost::asio::async_write(os, bs, handler);
+                    ios.run();
+                    ios.reset();
+                }
+                auto const elapsed = clock_type::now() - start;
+                BEAST_EXPECT(total == Repeat * s.size());
+                return duration_cast<nanoseconds>(
+                    elapsed).count() / Repeat;
+            };
+        log << "async_write:        " <<
+            measure(false) << " ns per message" << std::endl;
+        log << "async_write_cached: " <<
+            measure(true) << " ns per message" << std::endl;
+    }
+
+    void run() override
+    {
+        testFlatten();
+        testCapacity();
+        testSpecialMembers();
+        testWrite();
+        testBench();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(buffer_sequence_cache,core,beast);
+
+} // beast
@@ -0,0 +1,198 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/flat_streambuf.hpp>
+
+#include <beast/core/buffer_concepts.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace beast {
+
+static_assert(is_DynamicBuffer<flat_streambuf>::value, "");
+
+class flat_streambuf_test : public beast::unit_test::suite
+{
+public:
+    static
+    void
+    append(flat_streambuf& sb, std::string const& s)
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        sb.commit(buffer_copy(
+            sb.prepare(s.size()), buffer(s)));
+    }
+
+    static
+    char const*
+    ptr(flat_streambuf const& sb)
+    {
+        return boost::asio::buffer_cast<
+            char const*>(*sb.data().begin());
+    }
+
+    void testMatrix()
+    {
+        using boost::asio::buffer_size;
+        std::string const s = "Hello, world";
+        for(std::size_t i = 0; i <= s.size(); ++i)
+        {
+            for(std::size_t j = 0; j <= s.size() - i; ++j)
+            {
+                flat_streambuf sb;
+                append(sb, s.substr(0, i));
+                append(sb, s.substr(i, j));
+                append(sb, s.substr(i + j));
+                BEAST_EXPECT(sb.size() == s.size());
+                BEAST_EXPECT(to_string(sb.data()) == s);
+                for(std::size_t n = 0; n <= s.size(); ++n)
+                {
+                    auto sb2 = sb;
+                    sb2.consume(n);
+                    BEAST_EXPECT(to_string(sb2.data()) ==
+                        s.substr((std::min)(n, s.size())));
+                }
+            }
+        }
+    }
+
+    void testContiguous()
+    {
+        using boost::asio::buffer_size;
+        flat_streambuf sb;
+        BEAST_EXPECT(sb.capacity() == 0);
+        std::string s;
+        for(int i = 0; i < 1000; ++i)
+        {
+            auto const piece = std::to_string(i) + ",";
+            append(sb, piece);
+            s += piece;
+            // the input is always a single buffer
+            auto const d = sb.data();
+            BEAST_EXPECT(std::distance(d.begin(), d.end()) == 1);
+        }
+        BEAST_EXPECT(to_string(sb.data()) == s);
+        BEAST_EXPECT(sb.capacity() >= sb.size());
+        BEAST_EXPECT(sb.capacity() < 2 * sb.size());
+    }
+
+    void testCompact()
+    {
+        flat_streambuf sb;
+        append(sb, std::string(400, '*'));
+        auto const cap = sb.capacity();
+        auto const p = ptr(sb);
+        sb.consume(300);
+        BEAST_EXPECT(ptr(sb) == p + 300);
+        // moving the input to the front avoids growing
+        append(sb, std::string(cap - 200, '+'));
+        BEAST_EXPECT(sb.capacity() == cap);
+        BEAST_EXPECT(ptr(sb) == p);
+        BEAST_EXPECT(to_string(sb.data()) ==
+            std::string(100, '*') + std::string(cap - 200, '+'));
+        // consuming everything starts over at the front
+        sb.consume(sb.size());
+        BEAST_EXPECT(sb.size() == 0);
+        append(sb, "x");
+        BEAST_EXPECT(ptr(sb) == p);
+    }
+
+    void testLimit()
+    {
+        flat_streambuf sb{10};
+        BEAST_EXPECT(sb.max_size() == 10);
+        append(sb, "0123456789");
+        try
+        {
+            sb.prepare(1);
+            fail();
+        }
+        catch(std::length_error const&)
+        {
+            pass();
+        }
+        BEAST_EXPECT(read_size_helper(sb, 100) == 1);
+        sb.consume(5);
+        BEAST_EXPECT(read_size_helper(sb, 100) == 5);
+        append(sb, "abcde");
+        BEAST_EXPECT(to_string(sb.data()) == "56789abcde");
+        BEAST_EXPECT(sb.capacity() == 10);
+    }
+
+    void testReadSizeHelper()
+    {
+        flat_streambuf sb;
+        BEAST_EXPECT(read_size_helper(sb, 65536) == 512);
+        BEAST_EXPECT(read_size_helper(sb, 100) == 100);
+        append(sb, "x");
+        BEAST_EXPECT(read_size_helper(sb, 65536) ==
+            sb.capacity() - 1);
+        append(sb, std::string(sb.capacity() - 1, 'x'));
+        BEAST_EXPECT(read_size_helper(sb, 65536) == sb.capacity());
+    }
+
+    void testSpecialMembers()
+    {
+        flat_streambuf sb;
+        append(sb, "Hello");
+        sb.prepare(10);
+        {
+            flat_streambuf sb2{sb};
+            BEAST_EXPECT(to_string(sb2.data()) == "Hello");
+            BEAST_EXPECT(ptr(sb2) != ptr(sb));
+        }
+        {
+            flat_streambuf sb2;
+            append(sb2, "something longer than hello");
+            sb2 = sb;
+            BEAST_EXPECT(to_string(sb2.data()) == "Hello");
+        }
+        {
+            auto sb1 = sb;
+            auto const p = ptr(sb1);
+            flat_streambuf sb2{std::move(sb1)};
+            BEAST_EXPECT(ptr(sb2) == p);
+            BEAST_EXPECT(to_string(sb2.data()) == "Hello");
+            BEAST_EXPECT(sb1.size() == 0);
+            BEAST_EXPECT(sb1.capacity() == 0);
+            flat_streambuf sb3;
+            sb3 = std::move(sb2);
+            BEAST_EXPECT(ptr(sb3) == p);
+            BEAST_EXPECT(sb2.capacity() == 0);
+            // a moved-from buffer is usable
+            append(sb2, "again");
+            BEAST_EXPECT(to_string(sb2.data()) == "again");
+        }
+    }
+
+    void testOutputStream()
+    {
+        flat_streambuf sb;
+        sb << "x" << 1 << std::string{"y"};
+        BEAST_EXPECT(to_string(sb.data()) == "x1y");
+    }
+
+    void run() override
+    {
+        testMatrix();
+        testContiguous();
+        testCompact();
+        testLimit();
+        testReadSizeHelper();
+        testSpecialMembers();
+        testOutputStream();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(flat_streambuf,core,beast);
+
+} // beast
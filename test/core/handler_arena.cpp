@@ -0,0 +1,526 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/handler_arena.hpp>
+
+#include <beast/core/bind_handler.hpp>
+#include <beast/core/dynabuf_readstream.hpp>
+#include <beast/core/flat_streambuf.hpp>
+#include <beast/core/handler_alloc.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/core/detail/write_cached.hpp>
+#include <beast/http/string_body.hpp>
+#include <beast/http/read.hpp>
+#include <beast/http/write.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <beast/websocket/stream.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/asio/detail/handler_cont_helpers.hpp>
+#include <boost/asio/detail/handler_invoke_helpers.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/config.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+// This test is built as its own executable, since it
+// replaces the global operator new and delete.
+
+namespace {
+
+// Counts calls to the global allocator
+std::atomic<std::size_t> global_allocations{0};
+
+} // (anon)
+
+// Not inlined, so that the compiler does not pair the
+// calls to malloc and free with the operators it sees.
+
+BOOST_NOINLINE
+void*
+operator new(std::size_t size)
+{
+    ++global_allocations;
+    if(auto p = std::malloc(size > 0 ? size : 1))
+        return p;
+    throw std::bad_alloc{};
+}
+
+void*
+operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+BOOST_NOINLINE
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void
+operator delete[](void* p) noexcept
+{
+    ::operator delete(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    ::operator delete(p);
+}
+
+void
+operator delete[](void* p, std::size_t) noexcept
+{
+    ::operator delete(p);
+}
+
+namespace beast {
+
+class handler_arena_test : public beast::unit_test::suite
+{
+public:
+    // A stream which reads back what was written to it,
+    // or what was written to its peer once connected.
+    class loop_stream
+    {
+        boost::asio::io_service& ios_;
+        std::string s_;
+        loop_stream* out_ = this;
+
+        // Reads when invoked, so that data written by the
+        // peer before then is seen by the read.
+        template<class MutableBufferSequence, class Handler>
+        class read_some_op
+        {
+            loop_stream& s_;
+            MutableBufferSequence b_;
+            Handler h_;
+
+        public:
+            template<class DeducedHandler>
+            read_some_op(loop_stream& s,
+                    MutableBufferSequence const& b,
+                        DeducedHandler&& h)
+                : s_(s)
+                , b_(b)
+                , h_(std::forward<DeducedHandler>(h))
+            {
+            }
+
+            void
+            operator()()
+            {
+                error_code ec;
+                auto const n = s_.read_some(b_, ec);
+                h_(ec, n);
+            }
+
+            friend
+            void* asio_handler_allocate(
+                std::size_t size, read_some_op* op)
+            {
+                return boost_asio_handler_alloc_helpers::
+                    allocate(size, op->h_);
+            }
+
+            friend
+            void asio_handler_deallocate(
+                void* p, std::size_t size, read_some_op* op)
+            {
+                return boost_asio_handler_alloc_helpers::
+                    deallocate(p, size, op->h_);
+            }
+
+            friend
+            bool asio_handler_is_continuation(read_some_op* op)
+            {
+                return boost_asio_handler_cont_helpers::
+                    is_continuation(op->h_);
+            }
+
+            template<class Function>
+            friend
+            void asio_handler_invoke(Function&& f, read_some_op* op)
+            {
+                return boost_asio_handler_invoke_helpers::
+                    invoke(f, op->h_);
+            }
+        };
+
+    public:
+        explicit
+        loop_stream(boost::asio::io_service& ios)
+            : ios_(ios)
+        {
+            s_.reserve(4096);
+        }
+
+        void
+        connect(loop_stream& peer)
+        {
+            out_ = &peer;
+            peer.out_ = this;
+        }
+
+        boost::asio::io_service&
+        get_io_service()
+        {
+            return ios_;
+        }
+
+        template<class MutableBufferSequence>
+        std::size_t
+        read_some(MutableBufferSequence const& buffers,
+            error_code& ec)
+        {
+            auto const n = boost::asio::buffer_copy(
+                buffers, boost::asio::buffer(s_));
+            if(n > 0)
+                s_.erase(0, n);
+            else
+                ec = boost::asio::error::eof;
+            return n;
+        }
+
+        template<class MutableBufferSequence, class ReadHandler>
+        void
+        async_read_some(MutableBufferSequence const& buffers,
+            ReadHandler&& handler)
+        {
+            ios_.post(read_some_op<MutableBufferSequence,
+                typename std::decay<ReadHandler>::type>{*this,
+                    buffers, std::forward<ReadHandler>(handler)});
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(ConstBufferSequence const& buffers,
+            error_code& ec)
+        {
+            using boost::asio::buffer_cast;
+            using boost::asio::buffer_size;
+            ec = {};
+            std::size_t n = 0;
+            for(auto const& b : buffers)
+            {
+                out_->s_.append(buffer_cast<char const*>(b),
+                    buffer_size(b));
+                n += buffer_size(b);
+            }
+            return n;
+        }
+
+        template<class ConstBufferSequence, class WriteHandler>
+        void
+        async_write_some(ConstBufferSequence const& buffers,
+            WriteHandler&& handler)
+        {
+            error_code ec;
+            auto const n = write_some(buffers, ec);
+            ios_.post(bind_handler(
+                std::forward<WriteHandler>(handler), ec, n));
+        }
+
+        friend
+        void
+        teardown(websocket::teardown_tag,
+            loop_stream&, error_code& ec)
+        {
+            ec = {};
+        }
+
+        template<class TeardownHandler>
+        friend
+        void
+        async_teardown(websocket::teardown_tag,
+            loop_stream& stream, TeardownHandler&& handler)
+        {
+            stream.get_io_service().post(bind_handler(
+                std::forward<TeardownHandler>(handler),
+                    error_code{}));
+        }
+    };
+
+    struct test_handler
+    {
+        int& calls;
+
+        void
+        operator()(int v)
+        {
+            calls += v;
+        }
+
+        friend
+        bool
+        asio_handler_is_continuation(test_handler*)
+        {
+            return true;
+        }
+    };
+
+    void
+    testArena()
+    {
+        handler_arena a;
+        BEAST_EXPECT(a.heap_allocations() == 0);
+        auto p1 = a.allocate(100);
+        auto p2 = a.allocate(200);
+        BEAST_EXPECT(a.heap_allocations() == 2);
+        a.deallocate(p1, 100);
+        a.deallocate(p2, 200);
+
+        // Free slots are reused
+        auto p3 = a.allocate(50);
+        auto p4 = a.allocate(180);
+        BEAST_EXPECT(p3 == p1);
+        BEAST_EXPECT(p4 == p2);
+        BEAST_EXPECT(a.heap_allocations() == 2);
+        a.deallocate(p4, 180);
+
+        // A free slot which is too small grows
+        auto p5 = a.allocate(1000);
+        BEAST_EXPECT(a.heap_allocations() == 3);
+        a.deallocate(p5, 1000);
+        p5 = a.allocate(1000);
+        BEAST_EXPECT(a.heap_allocations() == 3);
+        a.deallocate(p5, 1000);
+        a.deallocate(p3, 50);
+
+        // Allocations beyond the last slot are not retained
+        void* v[handler_arena::max_slots + 2];
+        for(auto& p : v)
+            p = a.allocate(10);
+        for(auto& p : v)
+            a.deallocate(p, 10);
+        auto const n = a.heap_allocations();
+        for(auto& p : v)
+            p = a.allocate(10);
+        for(auto& p : v)
+            a.deallocate(p, 10);
+        BEAST_EXPECT(a.heap_allocations() == n + 2);
+    }
+
+    void
+    testBind()
+    {
+        handler_arena a;
+        int calls = 0;
+        auto h = bind_arena(a, test_handler{calls});
+        h(1);
+        h(2);
+        BEAST_EXPECT(calls == 3);
+        BEAST_EXPECT(boost_asio_handler_cont_helpers::
+            is_continuation(h));
+        {
+            handler_alloc<char, decltype(h)> alloc{h};
+            auto p = alloc.allocate(100);
+            BEAST_EXPECT(a.heap_allocations() == 1);
+            alloc.deallocate(p, 100);
+            p = alloc.allocate(100);
+            BEAST_EXPECT(a.heap_allocations() == 1);
+            alloc.deallocate(p, 100);
+        }
+    }
+
+    // Write and read back messages, binding
+    // each completion handler to the arena.
+    void
+    testSteadyState()
+    {
+        using boost::asio::buffer;
+        std::string const msg(100, '*');
+        boost::asio::io_service ios;
+        handler_arena a;
+        dynabuf_readstream<loop_stream, flat_streambuf> ls(ios);
+        std::string got(msg.size(), 0);
+        std::size_t allocs = 0;
+        std::size_t heap = 0;
+        for(int i = 0; i < 20; ++i)
+        {
+            if(i == 10)
+            {
+                allocs = global_allocations;
+                heap = a.heap_allocations();
+            }
+            error_code ec;
+            std::size_t n = 0;
+            beast::detail::async_write_cached(ls.next_layer(),
+                buffer(msg), bind_arena(a,
+                    [&](error_code const& ec_, std::size_t n_)
+                    {
+                        ec = ec_;
+                        n = n_;
+                    }));
+            ios.run();
+            ios.reset();
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                return;
+            BEAST_EXPECT(n == msg.size());
+            ls.async_read_some(buffer(&got[0], got.size()),
+                bind_arena(a,
+                    [&](error_code const& ec_, std::size_t n_)
+                    {
+                        ec = ec_;
+                        n = n_;
+                    }));
+            ios.run();
+            ios.reset();
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                return;
+            BEAST_EXPECT(n == msg.size());
+            BEAST_EXPECT(got == msg);
+        }
+        BEAST_EXPECT(a.heap_allocations() > 0);
+        BEAST_EXPECT(a.heap_allocations() == heap);
+        BEAST_EXPECT(global_allocations == allocs);
+    }
+
+    // Write and read back HTTP messages on a keep-alive
+    // connection, binding each completion handler to the arena.
+    // The header buffer is reused, as described in its docs.
+    void
+    testHttp()
+    {
+        boost::asio::io_service ios;
+        handler_arena a;
+        loop_stream ls(ios);
+        flat_streambuf fb(4096);
+        http::request<http::string_body> req;
+        req.version = 11;
+        req.method = "GET";
+        req.url = "/";
+        http::request<http::string_body> got;
+        http::header_buffer hb;
+        std::size_t allocs = 0;
+        std::size_t heap = 0;
+        for(int i = 0; i < 20; ++i)
+        {
+            if(i == 10)
+            {
+                allocs = global_allocations;
+                heap = a.heap_allocations();
+            }
+            error_code ec;
+            http::async_write(ls, req, hb, bind_arena(a,
+                [&](error_code const& ec_)
+                {
+                    ec = ec_;
+                }));
+            ios.run();
+            ios.reset();
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                return;
+            http::async_read(ls, fb, got, bind_arena(a,
+                [&](error_code const& ec_)
+                {
+                    ec = ec_;
+                }));
+            ios.run();
+            ios.reset();
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                return;
+            BEAST_EXPECT(got.method == req.method);
+            BEAST_EXPECT(got.url == req.url);
+        }
+        BEAST_EXPECT(a.heap_allocations() > 0);
+        BEAST_EXPECT(a.heap_allocations() == heap);
+        BEAST_EXPECT(global_allocations == allocs);
+    }
+
+    // Send and receive WebSocket messages between two
+    // streams, binding each completion handler to the arena.
+    void
+    testWebsocket()
+    {
+        using boost::asio::buffer;
+        std::string const msg(100, '*');
+        boost::asio::io_service ios;
+        handler_arena a;
+        websocket::stream<loop_stream> ws1(ios);
+        websocket::stream<loop_stream> ws2(ios);
+        ws1.next_layer().connect(ws2.next_layer());
+        error_code ec1;
+        error_code ec2;
+        ws1.async_handshake("localhost", "/",
+            [&](error_code const& ec)
+            {
+                ec1 = ec;
+            });
+        ws2.async_accept(
+            [&](error_code const& ec)
+            {
+                ec2 = ec;
+            });
+        ios.run();
+        ios.reset();
+        if(! BEAST_EXPECTS(! ec1, ec1.message()) ||
+                ! BEAST_EXPECTS(! ec2, ec2.message()))
+            return;
+        streambuf sb;
+        std::string got(msg.size(), 0);
+        std::size_t allocs = 0;
+        std::size_t heap = 0;
+        for(int i = 0; i < 20; ++i)
+        {
+            if(i == 10)
+            {
+                allocs = global_allocations;
+                heap = a.heap_allocations();
+            }
+            error_code ec;
+            ws1.async_write(buffer(msg), bind_arena(a,
+                [&](error_code const& ec_)
+                {
+                    ec = ec_;
+                }));
+            ios.run();
+            ios.reset();
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                return;
+            websocket::opcode op;
+            ws2.async_read(op, sb, bind_arena(a,
+                [&](error_code const& ec_)
+                {
+                    ec = ec_;
+                }));
+            ios.run();
+            ios.reset();
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                return;
+            BEAST_EXPECT(boost::asio::buffer_copy(
+                buffer(&got[0], got.size()), sb.data()) == msg.size());
+            BEAST_EXPECT(got == msg);
+            sb.consume(sb.size());
+        }
+        BEAST_EXPECT(a.heap_allocations() > 0);
+        BEAST_EXPECT(a.heap_allocations() == heap);
+        BEAST_EXPECT(global_allocations == allocs);
+    }
+
+    void
+    run() override
+    {
+        testArena();
+        testBind();
+        testSteadyState();
+        testHttp();
+        testWebsocket();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(handler_arena,core,beast);
+
+} // beast
@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/pool_allocator.hpp>
+
+#include <beast/unit_test/suite.hpp>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace beast {
+
+class pool_allocator_test : public beast::unit_test::suite
+{
+public:
+    void testReuse()
+    {
+        using detail::block_pool;
+        pool_allocator<char> a;
+        auto const p = a.allocate(1000);
+        a.deallocate(p, 1000);
+        auto const n = block_pool::heap_allocations();
+        // same size class
+        auto const p1 = a.allocate(600);
+        BEAST_EXPECT(p1 == p);
+        // different size class
+        auto const p2 = a.allocate(200);
+        BEAST_EXPECT(p2 != p);
+        BEAST_EXPECT(block_pool::heap_allocations() == n + 1);
+        a.deallocate(p1, 600);
+        a.deallocate(p2, 200);
+        // too large to pool
+        auto const p3 = a.allocate(block_pool::max_size + 1);
+        a.deallocate(p3, block_pool::max_size + 1);
+        BEAST_EXPECT(block_pool::heap_allocations() == n + 1);
+    }
+
+    void testRetention()
+    {
+        using detail::block_pool;
+        pool_allocator<char> a;
+        std::vector<char*> v;
+        for(int i = 0; i < 100; ++i)
+            v.push_back(a.allocate(block_pool::max_size));
+        auto const n = block_pool::retained();
+        for(auto p : v)
+            a.deallocate(p, block_pool::max_size);
+        // only a bounded amount is kept
+        BEAST_EXPECT(block_pool::retained() > n);
+        BEAST_EXPECT(block_pool::retained() - n <=
+            4 * block_pool::max_size);
+    }
+
+    void testThreads()
+    {
+        // Memory may be freed on another thread
+        pool_allocator<std::uint64_t> a;
+        std::vector<std::uint64_t*> v;
+        for(int i = 0; i < 100; ++i)
+            v.push_back(a.allocate(10));
+        std::thread t(
+            [&]
+            {
+                for(auto p : v)
+                    a.deallocate(p, 10);
+            });
+        t.join();
+        pass();
+    }
+
+    void testContainer()
+    {
+        pool_allocator<int> a;
+        pool_allocator<std::string> b(a);
+        BEAST_EXPECT(a == b);
+        BEAST_EXPECT(! (a != b));
+        std::list<std::string,
+            pool_allocator<std::string>> list;
+        for(int i = 0; i < 1000; ++i)
+            list.emplace_back(std::to_string(i));
+        BEAST_EXPECT(list.size() == 1000);
+        BEAST_EXPECT(list.back() == "999");
+    }
+
+    void run() override
+    {
+        testReuse();
+        testRetention();
+        testThreads();
+        testContainer();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(pool_allocator,core,beast);
+
+} // beast
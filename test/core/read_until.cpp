@@ -0,0 +1,353 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/read_until.hpp>
+
+#include <beast/core/bind_handler.hpp>
+#include <beast/core/flat_streambuf.hpp>
+#include <beast/core/ring_streambuf.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/core/detail/find_delimiter.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <array>
+#include <string>
+
+namespace beast {
+
+class read_until_test : public beast::unit_test::suite
+{
+public:
+    // A stream which returns at most `limit` bytes per read
+    class trickle_stream
+    {
+        boost::asio::io_service& ios_;
+        std::string s_;
+        std::size_t limit_;
+
+    public:
+        std::size_t reads = 0;
+
+        // Set to return eof along with the last bytes
+        bool eof_with_data = false;
+
+        trickle_stream(boost::asio::io_service& ios,
+                std::string s, std::size_t limit)
+            : ios_(ios)
+            , s_(std::move(s))
+            , limit_(limit)
+        {
+        }
+
+        boost::asio::io_service&
+        get_io_service()
+        {
+            return ios_;
+        }
+
+        template<class MutableBufferSequence>
+        std::size_t
+        read_some(MutableBufferSequence const& buffers)
+        {
+            error_code ec;
+            auto const n = read_some(buffers, ec);
+            if(ec)
+                throw system_error{ec};
+            return n;
+        }
+
+        template<class MutableBufferSequence>
+        std::size_t
+        read_some(MutableBufferSequence const& buffers,
+            error_code& ec)
+        {
+            ++reads;
+            auto const n = boost::asio::buffer_copy(buffers,
+                boost::asio::buffer(s_.data(),
+                    (std::min)(limit_, s_.size())));
+            if(n > 0)
+                s_.erase(0, n);
+            if(s_.empty() && (n == 0 || eof_with_data))
+                ec = boost::asio::error::eof;
+            return n;
+        }
+
+        template<class MutableBufferSequence, class ReadHandler>
+        void
+        async_read_some(MutableBufferSequence const& buffers,
+            ReadHandler&& handler)
+        {
+            error_code ec;
+            auto const n = read_some(buffers, ec);
+            ios_.post(bind_handler(
+                std::forward<ReadHandler>(handler), ec, n));
+        }
+    };
+
+    // Search s split into three buffers at every pair of positions
+    void
+    check(std::string const& s, std::string const& delim)
+    {
+        using boost::asio::const_buffer;
+        auto const pos = s.find(delim);
+        auto const expected = pos == std::string::npos ?
+            0 : pos + delim.size();
+        for(std::size_t i = 0; i <= s.size(); ++i)
+        {
+            for(std::size_t j = i; j <= s.size(); ++j)
+            {
+                std::array<const_buffer, 3> bs{{
+                    const_buffer{s.data(), i},
+                    const_buffer{s.data() + i, j - i},
+                    const_buffer{s.data() + j, s.size() - j}}};
+                std::size_t start = 0;
+                auto const n = detail::find_delimiter(
+                    bs, start, delim);
+                if(! BEAST_EXPECTS(n == expected, s))
+                    return;
+            }
+        }
+    }
+
+    void
+    testFind()
+    {
+        check("", "\r\n");
+        check("\r\n", "\r\n");
+        check("abc", "c");
+        check("abc", "d");
+        check("\r\n\r", "\r\n\r\n");
+        check("GET / HTTP/1.1\r\nHost: x\r\n\r\nbody",
+            "\r\n\r\n");
+        check("\r\r\n\r\r\n\n\r\n\r\n", "\r\n\r\n");
+        check("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaab", "aab");
+        check("xyzzy", "xyzzy");
+        {
+            std::string const t = "abc";
+            BEAST_EXPECT(detail::find_delimiter_generic(t.data(),
+                t.data() + t.size(), "", 0) == t.data());
+        }
+
+        // Long inputs, so the vectorized loop runs, with
+        // many candidates which match the first and last
+        // octets of the delimiter but not the middle ones.
+        std::string s;
+        for(int i = 0; i < 20; ++i)
+            s += "Field: value\r\n\r\r\n";
+        auto const s1 = s + "\r\n" + std::string(40, '*');
+        std::string const delim = "\r\n\r\n";
+        for(std::size_t i = 0; i <= 40; ++i)
+        {
+            auto const t = s1.substr(i);
+            std::size_t start = 0;
+            BEAST_EXPECT(detail::find_delimiter(
+                boost::asio::buffer(t), start, delim) ==
+                    t.find(delim) + delim.size());
+        }
+        check(s.substr(0, 60) + "\r\n\r\n", delim);
+        std::size_t start = 0;
+        BEAST_EXPECT(detail::find_delimiter(
+            boost::asio::buffer(s), start, delim) == 0);
+        BEAST_EXPECT(start == s.size() - 3);
+    }
+
+    void
+    testResume()
+    {
+        std::string const delim = "\r\n\r\n";
+        std::string const s =
+            "GET / HTTP/1.1\r\nUser-Agent: test\r\n\r\nbody";
+        auto const expected = s.find(delim) + delim.size();
+        // Append one octet at a time, resuming each search
+        // where the previous one left off.
+        std::size_t start = 0;
+        for(std::size_t i = 0; i <= s.size(); ++i)
+        {
+            auto const n = detail::find_delimiter(
+                boost::asio::buffer(s.data(), i), start, delim);
+            if(i < expected)
+            {
+                BEAST_EXPECT(n == 0);
+                BEAST_EXPECT(start + 3 >= i);
+            }
+            else
+            {
+                BEAST_EXPECT(n == expected);
+                break;
+            }
+        }
+    }
+
+    template<class DynamicBuffer>
+    void
+    testRead(DynamicBuffer&& db)
+    {
+        std::string const s =
+            "GET / HTTP/1.1\r\nUser-Agent: test\r\n\r\nbody";
+        std::size_t const expected = s.find("\r\n\r\nbody") + 4;
+        boost::asio::io_service ios;
+        for(std::size_t limit : {1, 2, 3, 7, 100})
+        {
+            db.consume(db.size());
+            trickle_stream ts(ios, s, limit);
+            auto const n = read_until(ts, db, "\r\n\r\n");
+            BEAST_EXPECT(n == expected);
+            BEAST_EXPECT(to_string(db.data()).substr(0, n) ==
+                s.substr(0, n));
+            // Already buffered, no read is performed
+            auto const reads = ts.reads;
+            BEAST_EXPECT(read_until(ts, db, "\r\n") ==
+                s.find("\r\n") + 2);
+            BEAST_EXPECT(ts.reads == reads);
+        }
+        {
+            db.consume(db.size());
+            trickle_stream ts(ios, "abc", 1);
+            error_code ec;
+            auto const n = read_until(ts, db, "\r\n", ec);
+            BEAST_EXPECT(ec == boost::asio::error::eof);
+            BEAST_EXPECT(n == 0);
+            BEAST_EXPECT(to_string(db.data()) == "abc");
+        }
+        {
+            db.consume(db.size());
+            trickle_stream ts(ios, "abc", 100);
+            ts.eof_with_data = true;
+            error_code ec;
+            BEAST_EXPECT(read_until(ts, db, "\r\n", ec) == 0);
+            BEAST_EXPECT(ec == boost::asio::error::eof);
+            BEAST_EXPECT(to_string(db.data()) == "abc");
+        }
+        {
+            db.consume(db.size());
+            trickle_stream ts(ios, "abc", 1);
+            error_code ec;
+            BEAST_EXPECT(read_until(ts, db, "", ec) == 0);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(ts.reads == 0);
+        }
+    }
+
+    template<class DynamicBuffer>
+    void
+    testAsyncRead(DynamicBuffer&& db)
+    {
+        std::string const s =
+            "GET / HTTP/1.1\r\nUser-Agent: test\r\n\r\nbody";
+        std::size_t const expected = s.find("\r\n\r\nbody") + 4;
+        boost::asio::io_service ios;
+        for(std::size_t limit : {1, 5, 100})
+        {
+            db.consume(db.size());
+            trickle_stream ts(ios, s, limit);
+            error_code result;
+            std::size_t n = 0;
+            bool invoked = false;
+            auto const handler =
+                [&](error_code const& ec, std::size_t bytes)
+                {
+                    invoked = true;
+                    result = ec;
+                    n = bytes;
+                };
+            async_read_until(ts, db, "\r\n\r\n", handler);
+            BEAST_EXPECT(! invoked);
+            ios.run();
+            ios.reset();
+            BEAST_EXPECT(invoked);
+            BEAST_EXPECTS(! result, result.message());
+            BEAST_EXPECT(n == expected);
+
+            // Already buffered, completes without reading
+            auto const reads = ts.reads;
+            invoked = false;
+            async_read_until(ts, db, "\r\n", handler);
+            BEAST_EXPECT(! invoked);
+            ios.run();
+            ios.reset();
+            BEAST_EXPECT(invoked);
+            BEAST_EXPECTS(! result, result.message());
+            BEAST_EXPECT(n == s.find("\r\n") + 2);
+            BEAST_EXPECT(ts.reads == reads);
+
+            // Reads until eof
+            invoked = false;
+            async_read_until(ts, db, "xyz", handler);
+            ios.run();
+            ios.reset();
+            BEAST_EXPECT(invoked);
+            BEAST_EXPECT(result == boost::asio::error::eof);
+            BEAST_EXPECT(n == 0);
+            BEAST_EXPECT(to_string(db.data()) == s);
+        }
+        {
+            // Bytes received with an error are kept
+            db.consume(db.size());
+            trickle_stream ts(ios, "abc", 100);
+            ts.eof_with_data = true;
+            error_code result;
+            async_read_until(ts, db, "\r\n",
+                [&](error_code const& ec, std::size_t)
+                {
+                    result = ec;
+                });
+            ios.run();
+            ios.reset();
+            BEAST_EXPECT(result == boost::asio::error::eof);
+            BEAST_EXPECT(to_string(db.data()) == "abc");
+        }
+    }
+
+    void
+    testLimit()
+    {
+        boost::asio::io_service ios;
+        {
+            flat_streambuf db{10};
+            trickle_stream ts(ios, std::string(100, '*'), 3);
+            error_code ec;
+            auto const n = read_until(ts, db, "\r\n", ec);
+            BEAST_EXPECT(ec == boost::asio::error::not_found);
+            BEAST_EXPECT(n == 0);
+            BEAST_EXPECT(db.size() == 10);
+        }
+        {
+            flat_streambuf db{10};
+            trickle_stream ts(ios, std::string(100, '*'), 3);
+            error_code result;
+            async_read_until(ts, db, "\r\n",
+                [&](error_code const& ec, std::size_t)
+                {
+                    result = ec;
+                });
+            ios.run();
+            BEAST_EXPECT(result == boost::asio::error::not_found);
+            BEAST_EXPECT(db.size() == 10);
+        }
+    }
+
+    void
+    run() override
+    {
+        testFind();
+        testResume();
+        testRead(streambuf{4});
+        testRead(flat_streambuf{});
+        testRead(ring_streambuf{});
+        testAsyncRead(streambuf{4});
+        testAsyncRead(flat_streambuf{});
+        testAsyncRead(ring_streambuf{});
+        testLimit();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(read_until,core,beast);
+
+} // beast
@@ -0,0 +1,263 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/core/ring_streambuf.hpp>
+
+#include <beast/core/buffer_concepts.hpp>
+#include <beast/core/dynabuf_readstream.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/test/string_stream.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/read.hpp>
+#include <algorithm>
+#include <ios>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+namespace beast {
+
+static_assert(is_DynamicBuffer<ring_streambuf>::value, "");
+
+class ring_streambuf_test : public beast::unit_test::suite
+{
+public:
+    static
+    void
+    append(ring_streambuf& sb, std::string const& s)
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        sb.commit(buffer_copy(
+            sb.prepare(s.size()), buffer(s)));
+    }
+
+    template<class BufferSequence>
+    static
+    std::size_t
+    count(BufferSequence const& bs)
+    {
+        return std::distance(bs.begin(), bs.end());
+    }
+
+    void testMatrix()
+    {
+        std::string const s = "Hello, world";
+        for(std::size_t i = 0; i <= s.size(); ++i)
+        {
+            for(std::size_t j = 0; j <= s.size() - i; ++j)
+            {
+                ring_streambuf sb;
+                append(sb, s.substr(0, i));
+                append(sb, s.substr(i, j));
+                append(sb, s.substr(i + j));
+                BEAST_EXPECT(sb.size() == s.size());
+                BEAST_EXPECT(to_string(sb.data()) == s);
+                for(std::size_t n = 0; n <= s.size(); ++n)
+                {
+                    auto sb2 = sb;
+                    sb2.consume(n);
+                    BEAST_EXPECT(to_string(sb2.data()) ==
+                        s.substr((std::min)(n, s.size())));
+                }
+            }
+        }
+    }
+
+    void testWrap()
+    {
+        using boost::asio::buffer_size;
+        ring_streambuf sb;
+        append(sb, "x");
+        auto const cap = sb.capacity();
+        sb.consume(1);
+        // Stream many times the capacity through the
+        // buffer, so the sequences wrap around its end.
+        std::string expected;
+        std::size_t n = 0;
+        for(int i = 0; i < 10000; ++i)
+        {
+            auto const piece = std::to_string(i) + ",";
+            append(sb, piece);
+            expected += piece;
+            if(sb.size() > cap / 2)
+            {
+                auto const used = sb.size() / 3;
+                BEAST_EXPECT(to_string(sb.data()) ==
+                    expected.substr(0, sb.size()));
+                sb.consume(used);
+                expected.erase(0, used);
+                n += used;
+            }
+            if(sb.mirrored())
+                BEAST_EXPECT(count(sb.data()) == 1);
+            else
+                BEAST_EXPECT(count(sb.data()) <= 2);
+        }
+        BEAST_EXPECT(n > 4 * cap);
+        BEAST_EXPECT(to_string(sb.data()) == expected);
+        // the storage was reused, never grown
+        BEAST_EXPECT(sb.capacity() == cap);
+    }
+
+    void testGrow()
+    {
+        // growing keeps a wrapped input sequence in order
+        ring_streambuf sb;
+        append(sb, "x");
+        auto const cap = sb.capacity();
+        append(sb, std::string(cap - 1, '*'));
+        sb.consume(cap - 10);
+        append(sb, std::string(100, '+'));
+        BEAST_EXPECT(sb.capacity() == cap);
+        append(sb, std::string(cap, '-'));
+        BEAST_EXPECT(sb.capacity() > cap);
+        BEAST_EXPECT(to_string(sb.data()) ==
+            std::string(10, '*') + std::string(100, '+') +
+                std::string(cap, '-'));
+    }
+
+    void testPrepare()
+    {
+        using boost::asio::buffer_size;
+        ring_streambuf sb;
+        append(sb, "x");
+        auto const cap = sb.capacity();
+        append(sb, std::string(cap - 101, '*'));
+        sb.consume(cap - 200);
+        // the output sequence wraps around the end
+        auto const mb = sb.prepare(cap - 100);
+        BEAST_EXPECT(buffer_size(mb) == cap - 100);
+        if(sb.mirrored())
+            BEAST_EXPECT(count(mb) == 1);
+        else
+            BEAST_EXPECT(count(mb) == 2);
+        sb.commit(1000);
+        BEAST_EXPECT(sb.size() == 1100);
+        BEAST_EXPECT(sb.capacity() == cap);
+        sb.commit(1);
+        BEAST_EXPECT(sb.size() == 1100);
+    }
+
+    void testLimit()
+    {
+        ring_streambuf sb{10};
+        BEAST_EXPECT(sb.max_size() == 10);
+        append(sb, "0123456789");
+        try
+        {
+            sb.prepare(1);
+            fail();
+        }
+        catch(std::length_error const&)
+        {
+            pass();
+        }
+        BEAST_EXPECT(read_size_helper(sb, 100) == 1);
+        sb.consume(5);
+        BEAST_EXPECT(read_size_helper(sb, 100) == 5);
+        append(sb, "abcde");
+        BEAST_EXPECT(to_string(sb.data()) == "56789abcde");
+    }
+
+    void testReadSizeHelper()
+    {
+        ring_streambuf sb;
+        BEAST_EXPECT(read_size_helper(sb, 65536) == 4096);
+        BEAST_EXPECT(read_size_helper(sb, 100) == 100);
+        append(sb, "x");
+        BEAST_EXPECT(read_size_helper(sb, 65536) ==
+            sb.capacity() - 1);
+        append(sb, std::string(sb.capacity() - 1, 'x'));
+        BEAST_EXPECT(read_size_helper(sb, 65536) == sb.capacity());
+    }
+
+    void testSpecialMembers()
+    {
+        ring_streambuf sb;
+        append(sb, "Hello");
+        sb.prepare(10);
+        {
+            ring_streambuf sb2{sb};
+            BEAST_EXPECT(to_string(sb2.data()) == "Hello");
+        }
+        {
+            ring_streambuf sb2;
+            append(sb2, "something longer than hello");
+            sb2 = sb;
+            BEAST_EXPECT(to_string(sb2.data()) == "Hello");
+        }
+        {
+            auto sb1 = sb;
+            ring_streambuf sb2{std::move(sb1)};
+            BEAST_EXPECT(to_string(sb2.data()) == "Hello");
+            BEAST_EXPECT(sb1.size() == 0);
+            BEAST_EXPECT(sb1.capacity() == 0);
+            ring_streambuf sb3;
+            sb3 = std::move(sb2);
+            BEAST_EXPECT(to_string(sb3.data()) == "Hello");
+            BEAST_EXPECT(sb2.capacity() == 0);
+            // a moved-from buffer is usable
+            append(sb2, "again");
+            BEAST_EXPECT(to_string(sb2.data()) == "again");
+        }
+    }
+
+    void testOutputStream()
+    {
+        ring_streambuf sb;
+        sb << "x" << 1 << std::string{"y"};
+        BEAST_EXPECT(to_string(sb.data()) == "x1y");
+    }
+
+    void testReadStream()
+    {
+        using boost::asio::buffer;
+        boost::asio::io_service ios;
+        std::string const s(10000, '*');
+        dynabuf_readstream<test::string_stream,
+            ring_streambuf> srs(ios, s);
+        std::string got;
+        got.resize(s.size());
+        boost::asio::read(srs, buffer(&got[0], got.size()));
+        BEAST_EXPECT(got == s);
+    }
+
+    void testMirrored()
+    {
+        ring_streambuf sb;
+        append(sb, "x");
+#ifdef BEAST_NO_MIRRORED_MEMORY
+        // The fallback of two buffers is always used
+        BEAST_EXPECT(! sb.mirrored());
+#else
+        log << "mirrored: " << std::boolalpha <<
+            sb.mirrored() << std::endl;
+#endif
+    }
+
+    void run() override
+    {
+        testMirrored();
+        testMatrix();
+        testWrap();
+        testGrow();
+        testPrepare();
+        testLimit();
+        testReadSizeHelper();
+        testSpecialMembers();
+        testOutputStream();
+        testReadStream();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(ring_streambuf,core,beast);
+
+} // beast
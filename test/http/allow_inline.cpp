@@ -0,0 +1,57 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/allow_inline.hpp>
+
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/handler_continuation_hook.hpp>
+
+namespace beast {
+namespace http {
+
+class allow_inline_test : public beast::unit_test::suite
+{
+public:
+    struct handler
+    {
+        int& n;
+
+        void
+        operator()(int v)
+        {
+            n += v;
+        }
+
+        friend
+        bool
+        asio_handler_is_continuation(handler*)
+        {
+            return true;
+        }
+    };
+
+    void
+    run() override
+    {
+        int n = 0;
+        handler h{n};
+        BEAST_EXPECT(! detail::inline_allowed(h));
+        auto h2 = allow_inline(h);
+        BEAST_EXPECT(detail::inline_allowed(h2));
+        BEAST_EXPECT(boost_asio_handler_cont_helpers::
+            is_continuation(h2));
+        auto h3 = h2;
+        h3(2);
+        BEAST_EXPECT(n == 2);
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(allow_inline,http,beast);
+
+} // http
+} // beast
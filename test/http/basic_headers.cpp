@@ -82,10 +82,39 @@ public:
         BEAST_EXPECT(h.size() == 2);
     }
 
+    void testField()
+    {
+        bh h;
+        h.insert("host", "example.com");
+        h.insert("X-Custom", "1");
+        h.insert(field::content_type, "text/html");
+        h.insert("COOKIE", "a=1");
+        h.insert("Cookie", "b=2");
+        BEAST_EXPECT(h[field::host] == "example.com");
+        BEAST_EXPECT(h["Host"] == "example.com");
+        BEAST_EXPECT(h["content-type"] == "text/html");
+        BEAST_EXPECT(h.find(field::content_type)->first == "Content-Type");
+        BEAST_EXPECT(h[field::cookie] == "a=1");
+        BEAST_EXPECT(h.count(field::cookie) == 2);
+        BEAST_EXPECT(h.count("cookie") == 2);
+        BEAST_EXPECT(h["x-custom"] == "1");
+        BEAST_EXPECT(h.exists(field::host));
+        BEAST_EXPECT(! h.exists(field::accept));
+        BEAST_EXPECT(h.find(field::unknown) == h.end());
+        BEAST_EXPECT(h.count(field::unknown) == 0);
+        BEAST_EXPECT(h.erase("Cookie") == 2);
+        BEAST_EXPECT(! h.exists(field::cookie));
+        BEAST_EXPECT(h.size() == 3);
+        h.replace("HOST", "example.org");
+        BEAST_EXPECT(h[field::host] == "example.org");
+        BEAST_EXPECT(h.size() == 3);
+    }
+
     void run() override
     {
         testHeaders();
         testRFC2616();
+        testField();
     }
 };
 
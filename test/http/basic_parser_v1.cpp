@@ -13,6 +13,7 @@
 #include <beast/core/buffer_cat.hpp>
 #include <beast/core/detail/ci_char_traits.hpp>
 #include <beast/http/rfc7230.hpp>
+#include <beast/http/detail/chunk_size.hpp>
 #include <beast/unit_test/suite.hpp>
 #include <boost/assert.hpp>
 #include <boost/utility/string_ref.hpp>
@@ -21,6 +22,7 @@
 #include <new>
 #include <random>
 #include <type_traits>
+#include <vector>
 
 namespace beast {
 namespace http {
@@ -1085,6 +1087,24 @@ public:
             "10\r\n" "1234567890123456\r\n" "0\r\n" "\r\n"
             ), body("1234567890123456"));
 
+        // Chunk sizes decoded with and without the fast path
+        good<true>(ce(
+            "A\r\n" "0123456789\r\n" "0\r\n" "\r\n"
+            ), body("0123456789"));
+
+        good<true>(ce(
+            "0000001\r\n" "*\r\n" "00000000\r\n" "\r\n"
+            ), body("*"));
+
+        good<true>(ce(
+            "000000001\r\n" "*\r\n" "000000000\r\n" "\r\n"
+            ), body("*"));
+
+        good<true>(ce(
+            "1\r\n" "a\r\n" "2\r\n" "bc\r\n" "3\r\n" "def\r\n"
+            "0\r\n" "Expires: never\r\n" "\r\n"
+            ), body("abcdef"));
+
         bad<true>(ce("ffffffffffffffff0\r\n0\r\n\r\n"), parse_error::bad_content_length);
         bad<true>(ce("g\r\n0\r\n\r\n"),                 parse_error::invalid_chunk_size);
         bad<true>(ce("0g\r\n0\r\n\r\n"),                parse_error::invalid_chunk_size);
@@ -1093,6 +1113,394 @@ public:
         bad<true>(ce("1\r\n*\r_\n"),                    parse_error::bad_crlf);
         bad<true>(ce("1;,x\r\n*\r\n" "0\r\n\r\n"),      parse_error::invalid_ext_name);
         bad<true>(ce("1;x,\r\n*\r\n" "0\r\n\r\n"),      parse_error::invalid_ext_name);
+        bad<true>(ce("1\r_*\r\n" "0\r\n\r\n"),          parse_error::bad_crlf);
+        bad<true>(ce("1g\r\n*\r\n" "0\r\n\r\n"),        parse_error::invalid_chunk_size);
+        bad<true>(ce("1\x80\r\n*\r\n" "0\r\n\r\n"),      parse_error::invalid_chunk_size);
+    }
+
+    void testChunkSize()
+    {
+        using detail::parse_chunk_size;
+        auto const check =
+            [&](std::string const& s, std::size_t n, std::uint64_t v)
+            {
+                std::uint64_t v1 = 0;
+                auto const n1 = parse_chunk_size(
+                    s.data(), s.data() + s.size(), v1);
+                if(! BEAST_EXPECTS(n1 == n, s))
+                    return;
+                if(n1 > 0)
+                    BEAST_EXPECTS(v1 == v, s);
+            };
+        check("1\r\n*\r\n0\r\n",   1, 0x1);
+        check("fF\r\n",          0, 0);  // too short
+        check("fF\r\n\r\n\r\n\r\n",  2, 0xff);
+        check("aBcDeF0;x=y",     7, 0xabcdef0);
+        check("1234567\r\n",     7, 0x1234567);
+        check("12345678\r\n",    0, 0);  // too many digits
+        check(";x=y\r\n\r\n\r\n",  0, 0);  // no digits
+        check("9:\r\n\r\n\r\n\r\n",  1, 0x9);
+        check("g\r\n\r\n\r\n\r\n",   0, 0);
+        check("`0\r\n\r\n\r\n\r",   0, 0);
+        check("0/\r\n\r\n\r\n",    1, 0);
+        check("@\r\n\r\n\r\n\r\n",   0, 0);
+        check("F\x80\r\n\r\n\r\n\r", 1, 0xf);
+        check("\xc6\r\n\r\n\r\n\r\n", 0, 0);
+        // Every octet value after a single digit
+        for(int c = 0; c < 256; ++c)
+        {
+            std::string s = "a";
+            s.push_back(static_cast<char>(c));
+            s.append("\r\n\r\n\r\n");
+            std::uint64_t v;
+            auto const n = parse_chunk_size(
+                s.data(), s.data() + s.size(), v);
+            BEAST_EXPECT(n == (detail::unhex(
+                static_cast<char>(c)) == -1 ? 1u : 2u));
+        }
+    }
+
+    void testWriteBody()
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_cast;
+        using boost::asio::buffer_size;
+        std::string const s =
+            "GET / HTTP/1.1\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "3\r\n" "abc\r\n"
+            "a;x=y\r\n" "0123456789\r\n"
+            "0\r\n"
+            "\r\n"
+            "GET / HTTP/1.1\r\n";
+        for_split(s,
+            [&](boost::string_ref const& s1, boost::string_ref const& s2)
+            {
+                direct_checker<true> p;
+                error_code ec;
+                auto used = p.write(buffer(s1.data(), s1.size()), ec);
+                if(! p.complete())
+                    used = s1.size() + p.write(
+                        buffer(s2.data(), s2.size()), ec);
+                if(! BEAST_EXPECT(! ec && p.complete()))
+                    return;
+                p.resume_direct(ec);
+                std::vector<boost::asio::const_buffer> v;
+                if(used < s1.size())
+                    used += p.write_body(buffer(s1.data() + used,
+                        s1.size() - used), v, ec);
+                if(! BEAST_EXPECT(! ec))
+                    return;
+                if(! p.complete())
+                {
+                    auto const n = used - s1.size();
+                    used += p.write_body(buffer(s2.data() + n,
+                        s2.size() - n), v, ec);
+                }
+                if(! BEAST_EXPECT(! ec))
+                    return;
+                BEAST_EXPECT(p.complete());
+                BEAST_EXPECT(p.completes == 1);
+                BEAST_EXPECT(used == s.size() - 16);
+                std::string body;
+                for(auto const& b : v)
+                {
+                    // Buffers refer to the input
+                    auto const q = buffer_cast<char const*>(b);
+                    BEAST_EXPECT(
+                        (q >= s1.data() && q < s1.data() + s1.size()) ||
+                        (q >= s2.data() && q < s2.data() + s2.size()));
+                    body.append(q, buffer_size(b));
+                }
+                BEAST_EXPECT(body == "abc0123456789");
+            });
+    }
+
+    // Records the well-known field of each value
+    struct field_id_checker
+        : public basic_parser_v1<true, field_id_checker>
+    {
+        std::vector<http::field> ids;
+
+    private:
+        friend class basic_parser_v1<true, field_id_checker>;
+
+        bool first_ = false;
+
+        void on_start(error_code&) {}
+        void on_method(boost::string_ref const&, error_code&) {}
+        void on_uri(boost::string_ref const&, error_code&) {}
+        void on_reason(boost::string_ref const&, error_code&) {}
+        void on_request(error_code&) {}
+        void on_response(error_code&) {}
+        void on_field(boost::string_ref const&, error_code&)
+        {
+            first_ = true;
+        }
+        void on_value(boost::string_ref const&, error_code&)
+        {
+            if(! first_)
+                return;
+            first_ = false;
+            ids.push_back(this->field_id());
+        }
+        void on_headers(std::uint64_t, error_code&) {}
+        body_what on_body_what(std::uint64_t, error_code&)
+        {
+            return body_what::normal;
+        }
+        void on_body(boost::string_ref const&, error_code&) {}
+        void on_complete(error_code&) {}
+    };
+
+    void testFieldIds()
+    {
+        using boost::asio::buffer;
+        std::string const s =
+            "GET / HTTP/1.1\r\n"
+            "Host: x\r\n"
+            "content-TYPE: y\r\n"
+            "Content: z\r\n"
+            "Content-Types: z\r\n"
+            "X-Custom: z\r\n"
+            "Upgrade-Insecure-Requests: 1\r\n"
+            "te: trailers\r\n"
+            "Proxy-Connection: keep-alive\r\n"
+            "Content-Length: 0\r\n"
+            "\r\n";
+        std::vector<http::field> const expected = {
+            field::host, field::content_type,
+            field::unknown, field::unknown, field::unknown,
+            field::upgrade_insecure_requests, field::te,
+            field::proxy_connection, field::content_length};
+        for_split(s,
+            [&](boost::string_ref const& s1, boost::string_ref const& s2)
+            {
+                field_id_checker p;
+                error_code ec;
+                p.write(buffer(s1.data(), s1.size()), ec);
+                if(! BEAST_EXPECT(! ec))
+                    return;
+                p.write(buffer(s2.data(), s2.size()), ec);
+                if(! BEAST_EXPECT(! ec))
+                    return;
+                BEAST_EXPECT(p.complete());
+                BEAST_EXPECT(p.ids == expected);
+            });
+    }
+
+    // Pauses before the body, and records body callbacks
+    template<bool isRequest>
+    struct direct_checker
+        : public basic_parser_v1<isRequest, direct_checker<isRequest>>
+    {
+        std::size_t bodies = 0;
+        std::size_t completes = 0;
+
+    private:
+        friend class basic_parser_v1<isRequest, direct_checker<isRequest>>;
+
+        void on_start(error_code&) {}
+        void on_method(boost::string_ref const&, error_code&) {}
+        void on_uri(boost::string_ref const&, error_code&) {}
+        void on_reason(boost::string_ref const&, error_code&) {}
+        void on_request(error_code&) {}
+        void on_response(error_code&) {}
+        void on_field(boost::string_ref const&, error_code&) {}
+        void on_value(boost::string_ref const&, error_code&) {}
+        void on_headers(std::uint64_t, error_code&) {}
+        body_what on_body_what(std::uint64_t, error_code&)
+        {
+            return body_what::pause;
+        }
+        void on_body(boost::string_ref const&, error_code&)
+        {
+            ++bodies;
+        }
+        void on_complete(error_code&)
+        {
+            ++completes;
+        }
+    };
+
+    // Parse the message in pieces of at most `step` octets,
+    // reading the body directly from the input.
+    template<bool isRequest>
+    void
+    direct(std::string const& s, std::string const& expected)
+    {
+        using boost::asio::buffer;
+        for(std::size_t step = 1; step <= s.size(); ++step)
+        {
+            direct_checker<isRequest> p;
+            error_code ec;
+            std::size_t pos = 0;
+            auto const next =
+                [&]
+                {
+                    return buffer(s.data() + pos,
+                        (std::min)(step, s.size() - pos));
+                };
+            while(! p.complete() && pos < s.size())
+            {
+                pos += p.write(next(), ec);
+                if(! BEAST_EXPECTS(! ec, ec.message()))
+                    return;
+            }
+            p.resume_direct(ec);
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                return;
+            std::string body;
+            while(! p.complete())
+            {
+                if(pos == s.size())
+                {
+                    BEAST_EXPECT(p.body_remain() ==
+                        no_content_length);
+                    p.write_eof(ec);
+                    break;
+                }
+                if(auto const n = p.body_remain())
+                {
+                    auto const m = static_cast<std::size_t>(
+                        (std::min<std::uint64_t>)(n,
+                            (std::min)(step, s.size() - pos)));
+                    body.append(s.data() + pos, m);
+                    pos += m;
+                    p.consume_body(m, ec);
+                }
+                else
+                {
+                    pos += p.write(next(), ec);
+                }
+                if(! BEAST_EXPECTS(! ec, ec.message()))
+                    return;
+            }
+            BEAST_EXPECT(! ec);
+            BEAST_EXPECT(p.complete());
+            BEAST_EXPECT(pos == s.size());
+            BEAST_EXPECT(body == expected);
+            BEAST_EXPECT(p.bodies == 0);
+            BEAST_EXPECT(p.completes == 1);
+        }
+    }
+
+    void testDirectBody()
+    {
+        direct<true>(
+            "GET / HTTP/1.1\r\n"
+            "\r\n", "");
+        direct<true>(
+            "GET / HTTP/1.1\r\n"
+            "Content-Length: 0\r\n"
+            "\r\n", "");
+        direct<true>(
+            "GET / HTTP/1.1\r\n"
+            "Content-Length: 10\r\n"
+            "\r\n"
+            "0123456789", "0123456789");
+        direct<true>(
+            "GET / HTTP/1.1\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "3\r\n" "abc\r\n"
+            "a;x=y\r\n" "0123456789\r\n"
+            "0\r\n"
+            "Trailer: t\r\n"
+            "\r\n", "abc0123456789");
+        direct<false>(
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "*****", "*****");
+        direct<false>(
+            "HTTP/1.0 200 OK\r\n"
+            "\r\n"
+            "until eof", "until eof");
+
+        // Body size limit
+        {
+            using boost::asio::buffer;
+            std::string const s =
+                "GET / HTTP/1.1\r\n"
+                "Content-Length: 4\r\n"
+                "\r\n"
+                "****";
+            direct_checker<true> p;
+            p.set_option(body_max_size{2});
+            error_code ec;
+            p.write(buffer(s.data(), s.size()), ec);
+            BEAST_EXPECT(! ec);
+            BEAST_EXPECT(p.complete());
+            // The announced size is checked up front
+            p.resume_direct(ec);
+            BEAST_EXPECT(ec == parse_error::body_too_big);
+        }
+        {
+            using boost::asio::buffer;
+            std::string const s =
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "4\r\n****\r\n";
+            direct_checker<false> p;
+            p.set_option(body_max_size{2});
+            error_code ec;
+            auto const used =
+                p.write(buffer(s.data(), s.size()), ec);
+            BEAST_EXPECT(! ec);
+            p.resume_direct(ec);
+            BEAST_EXPECT(! ec);
+            p.write(buffer(
+                s.data() + used, s.size() - used), ec);
+            BEAST_EXPECT(ec == parse_error::body_too_big);
+        }
+        {
+            using boost::asio::buffer;
+            std::string const s =
+                "HTTP/1.1 200 OK\r\n"
+                "\r\n"
+                "****";
+            direct_checker<false> p;
+            p.set_option(body_max_size{2});
+            error_code ec;
+            p.write(buffer(s.data(), s.size()), ec);
+            BEAST_EXPECT(! ec);
+            p.resume_direct(ec);
+            BEAST_EXPECT(! ec);
+            BEAST_EXPECT(p.body_remain() == no_content_length);
+            p.consume_body(4, ec);
+            BEAST_EXPECT(ec == parse_error::body_too_big);
+        }
+    }
+
+    void testLongRuns()
+    {
+        // Runs of TEXT are scanned in blocks, so place
+        // the delimiter or bad octet around each boundary.
+        for(std::size_t n = 1; n <= 130; n += 3)
+        {
+            std::string const t(n, 'x');
+            good<true>("GET /" + t + " HTTP/1.1\r\n"
+                "Cookie: " + t + "\t" + t + "\r\n"
+                "\r\n");
+            good<false>("HTTP/1.1 200 " + t + "\x80 " + t + "\r\n"
+                "Server: " + t + "\r\n"
+                "\r\n");
+            bad<true>("GET /" + t + "\x01 HTTP/1.1\r\n"
+                "\r\n",                            parse_error::bad_uri);
+            bad<true>("GET /" + t + "\x7f HTTP/1.1\r\n"
+                "\r\n",                            parse_error::bad_uri);
+            bad<true>("GET / HTTP/1.1\r\n"
+                "Cookie: " + t + "\x7f\r\n"
+                "\r\n",                            parse_error::bad_value);
+            bad<true>("GET / HTTP/1.1\r\n"
+                "Cookie: " + t + "\n"
+                "\r\n",                            parse_error::bad_value);
+            bad<false>("HTTP/1.1 200 " + t + "\x1f\r\n"
+                "\r\n",                            parse_error::bad_reason);
+        }
     }
 
     void testLimits()
@@ -1165,6 +1573,11 @@ public:
         testUpgradeHeader();
         testBody();
         testChunkedBody();
+        testLongRuns();
+        testFieldIds();
+        testDirectBody();
+        testChunkSize();
+        testWriteBody();
         testLimits();
     }
 };
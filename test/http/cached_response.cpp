@@ -0,0 +1,223 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/cached_response.hpp>
+
+#include <beast/http/headers.hpp>
+#include <beast/http/string_body.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/test/yield_to.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/lexical_cast.hpp>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class cached_response_test
+    : public beast::unit_test::suite
+    , public test::enable_yield_to
+{
+public:
+    class string_write_stream
+    {
+        boost::asio::io_service& ios_;
+
+    public:
+        std::string str;
+
+        explicit
+        string_write_stream(boost::asio::io_service& ios)
+            : ios_(ios)
+        {
+        }
+
+        boost::asio::io_service&
+        get_io_service()
+        {
+            return ios_;
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(ConstBufferSequence const& buffers)
+        {
+            error_code ec;
+            return write_some(buffers, ec);
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(
+            ConstBufferSequence const& buffers, error_code&)
+        {
+            using boost::asio::buffer_cast;
+            using boost::asio::buffer_size;
+            std::size_t n = 0;
+            for(auto const& b : buffers)
+            {
+                str.append(buffer_cast<char const*>(b),
+                    buffer_size(b));
+                n += buffer_size(b);
+            }
+            return n;
+        }
+
+        template<class ConstBufferSequence, class WriteHandler>
+        typename async_completion<
+            WriteHandler, void(error_code)>::result_type
+        async_write_some(ConstBufferSequence const& buffers,
+            WriteHandler&& handler)
+        {
+            error_code ec;
+            auto const bytes_transferred = write_some(buffers, ec);
+            async_completion<
+                WriteHandler, void(error_code, std::size_t)
+                    > completion(handler);
+            get_io_service().post(
+                bind_handler(completion.handler, ec, bytes_transferred));
+            return completion.result.get();
+        }
+    };
+
+    static
+    response<string_body>
+    make_response()
+    {
+        response<string_body> m;
+        m.version = 11;
+        m.status = 404;
+        m.reason = "Not Found";
+        m.headers.insert("Server", "test");
+        m.body = "*****";
+        prepare(m);
+        return m;
+    }
+
+    // Returns the Date field value of a serialized message
+    static
+    std::string
+    date_of(std::string const& s)
+    {
+        auto const pos = s.find("\r\nDate: ");
+        if(pos == std::string::npos)
+            return {};
+        return s.substr(pos + 8, s.find("\r\n", pos + 2) - pos - 8);
+    }
+
+    void testConstruct()
+    {
+        auto const m = make_response();
+        cached_response const cr{m};
+        auto const expected =
+            boost::lexical_cast<std::string>(m);
+        BEAST_EXPECT(cr.size() == expected.size());
+        BEAST_EXPECT(beast::to_string(cr.data()) == expected);
+        BEAST_EXPECT(! cr.has_date());
+        BEAST_EXPECT(cr.keep_alive());
+
+        // Copies share the buffer
+        auto const cr2 = cr;
+        BEAST_EXPECT(
+            boost::asio::buffer_cast<char const*>(cr2.data()) ==
+            boost::asio::buffer_cast<char const*>(cr.data()));
+
+        char date[cached_response::date_size];
+        auto const b = cr.buffers(date);
+        BEAST_EXPECT(boost::asio::buffer_size(b) == cr.size());
+        BEAST_EXPECT(beast::to_string(b) == expected);
+    }
+
+    void testDate()
+    {
+        auto m = make_response();
+        m.headers.insert("Date", "Sun, 06 Nov 1994 08:49:37 GMT");
+        cached_response const cr{m};
+        BEAST_EXPECT(cr.has_date());
+        BEAST_EXPECT(date_of(beast::to_string(cr.data())) ==
+            "Sun, 06 Nov 1994 08:49:37 GMT");
+
+        // The date is replaced when sending
+        string_write_stream ss(ios_);
+        write(ss, cr);
+        BEAST_EXPECT(ss.str.size() == cr.size());
+        auto const date = date_of(ss.str);
+        BEAST_EXPECT(date.size() == cached_response::date_size);
+        BEAST_EXPECT(date != "Sun, 06 Nov 1994 08:49:37 GMT");
+        BEAST_EXPECT(date.substr(date.size() - 4) == " GMT");
+        BEAST_EXPECT(ss.str.substr(0, ss.str.find("Date")) ==
+            beast::to_string(cr.data()).substr(0, ss.str.find("Date")));
+        BEAST_EXPECT(ss.str.substr(ss.str.size() - 9) ==
+            "\r\n\r\n*****");
+
+        // The stored message is unchanged
+        BEAST_EXPECT(date_of(beast::to_string(cr.data())) ==
+            "Sun, 06 Nov 1994 08:49:37 GMT");
+
+        // A value of another size is left alone
+        m.headers.replace("date", "yesterday");
+        cached_response const cr2{m};
+        BEAST_EXPECT(! cr2.has_date());
+        string_write_stream ss2(ios_);
+        write(ss2, cr2);
+        BEAST_EXPECT(ss2.str == beast::to_string(cr2.data()));
+    }
+
+    void testClose()
+    {
+        auto m = make_response();
+        m.headers.insert("Connection", "close");
+        cached_response const cr{m};
+        BEAST_EXPECT(! cr.keep_alive());
+        string_write_stream ss(ios_);
+        error_code ec;
+        write(ss, cr, ec);
+        BEAST_EXPECT(ec == boost::asio::error::eof);
+        BEAST_EXPECT(ss.str == beast::to_string(cr.data()));
+    }
+
+    void testAsyncWrite(yield_context do_yield)
+    {
+        auto m = make_response();
+        set_date(m);
+        cached_response const cr{m};
+        for(int i = 0; i < 3; ++i)
+        {
+            string_write_stream ss(ios_);
+            error_code ec;
+            async_write(ss, cr, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(ss.str.size() == cr.size());
+            BEAST_EXPECT(date_of(ss.str).size() ==
+                cached_response::date_size);
+        }
+        {
+            m.headers.insert("Connection", "close");
+            cached_response const cr2{m};
+            string_write_stream ss(ios_);
+            error_code ec;
+            async_write(ss, cr2, do_yield[ec]);
+            BEAST_EXPECT(ec == boost::asio::error::eof);
+            BEAST_EXPECT(ss.str.size() == cr2.size());
+        }
+    }
+
+    void run() override
+    {
+        testConstruct();
+        testDate();
+        testClose();
+        yield_to(std::bind(&cached_response_test::testAsyncWrite,
+            this, std::placeholders::_1));
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(cached_response,http,beast);
+
+} // http
+} // beast
@@ -0,0 +1,107 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/date.hpp>
+
+#include <beast/http/empty_body.hpp>
+#include <beast/http/headers.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace beast {
+namespace http {
+
+class date_test : public beast::unit_test::suite
+{
+public:
+    static
+    std::string
+    fmt(std::int64_t t)
+    {
+        char buf[detail::date_size];
+        detail::format_date(t, buf);
+        return {buf, sizeof(buf)};
+    }
+
+    static
+    bool
+    valid(std::string const& s)
+    {
+        // "Sun, 06 Nov 1994 08:49:37 GMT"
+        auto const pattern = "Aaa, 00 Aaa 0000 00:00:00 GMT";
+        if(s.size() != detail::date_size)
+            return false;
+        for(std::size_t i = 0; i < s.size(); ++i)
+        {
+            auto const c = s[i];
+            switch(pattern[i])
+            {
+            case 'A': if(c < 'A' || c > 'Z') return false; break;
+            case 'a': if(c < 'a' || c > 'z') return false; break;
+            case '0': if(c < '0' || c > '9') return false; break;
+            default: if(c != pattern[i]) return false; break;
+            }
+        }
+        return true;
+    }
+
+    void testFormat()
+    {
+        BEAST_EXPECT(fmt(0) == "Thu, 01 Jan 1970 00:00:00 GMT");
+        BEAST_EXPECT(fmt(784111777) == "Sun, 06 Nov 1994 08:49:37 GMT");
+        BEAST_EXPECT(fmt(951782400) == "Tue, 29 Feb 2000 00:00:00 GMT");
+        BEAST_EXPECT(fmt(1483228799) == "Sat, 31 Dec 2016 23:59:59 GMT");
+        BEAST_EXPECT(fmt(4107542400) == "Mon, 01 Mar 2100 00:00:00 GMT");
+        BEAST_EXPECT(fmt(-1) == "Wed, 31 Dec 1969 23:59:59 GMT");
+    }
+
+    void testSetDate()
+    {
+        response<empty_body> m;
+        set_date(m);
+        BEAST_EXPECT(valid(m.headers["Date"].to_string()));
+        set_date(m);
+        BEAST_EXPECT(m.headers.count("Date") == 1);
+    }
+
+    void testThreads()
+    {
+        std::vector<std::thread> v;
+        std::vector<int> ok(4, 0);
+        for(std::size_t i = 0; i < ok.size(); ++i)
+            v.emplace_back(
+                [&ok, i]
+                {
+                    char buf[detail::date_size];
+                    for(int n = 0; n < 10000; ++n)
+                    {
+                        detail::date_cache::get().copy(buf);
+                        if(valid({buf, sizeof(buf)}))
+                            ++ok[i];
+                    }
+                });
+        for(auto& t : v)
+            t.join();
+        for(auto n : ok)
+            BEAST_EXPECT(n == 10000);
+    }
+
+    void run() override
+    {
+        testFormat();
+        testSetDate();
+        testThreads();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(date,http,beast);
+
+} // http
+} // beast
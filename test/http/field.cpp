@@ -0,0 +1,78 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/field.hpp>
+
+#include <beast/unit_test/suite.hpp>
+#include <beast/core/detail/ci_char_traits.hpp>
+#include <cctype>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class field_test : public unit_test::suite
+{
+public:
+    void
+    testNames()
+    {
+        using beast::detail::ci_less;
+        BEAST_EXPECT(to_string(field::unknown).empty());
+        BEAST_EXPECT(to_string(field::host) == "Host");
+        BEAST_EXPECT(to_string(field::www_authenticate) ==
+            "WWW-Authenticate");
+        boost::string_ref prev;
+        for(int i = 1;; ++i)
+        {
+            auto const f = static_cast<field>(i);
+            auto const s = to_string(f);
+            if(s.empty())
+                break;
+            // names must be sorted for the matcher
+            if(! prev.empty())
+                BEAST_EXPECT(ci_less{}(prev, s));
+            prev = s;
+            BEAST_EXPECT(string_to_field(s) == f);
+            std::string u(s.begin(), s.end());
+            for(auto& c : u)
+                c = static_cast<char>(std::toupper(c));
+            BEAST_EXPECT(string_to_field(u) == f);
+        }
+    }
+
+    void
+    testLookup()
+    {
+        BEAST_EXPECT(string_to_field("") == field::unknown);
+        BEAST_EXPECT(string_to_field("content-length") ==
+            field::content_length);
+        BEAST_EXPECT(string_to_field("Content-Lengt") ==
+            field::unknown);
+        BEAST_EXPECT(string_to_field("Content-Lengths") ==
+            field::unknown);
+        BEAST_EXPECT(string_to_field("Content") == field::unknown);
+        BEAST_EXPECT(string_to_field("Upgrade") == field::upgrade);
+        BEAST_EXPECT(string_to_field("upgrade-insecure-requests") ==
+            field::upgrade_insecure_requests);
+        BEAST_EXPECT(string_to_field("X-Unknown") == field::unknown);
+        BEAST_EXPECT(string_to_field("te") == field::te);
+        BEAST_EXPECT(string_to_field("t") == field::unknown);
+    }
+
+    void run() override
+    {
+        testNames();
+        testLookup();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(field,http,beast);
+
+} // http
+} // beast
@@ -0,0 +1,235 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/file_body.hpp>
+
+#include "temp_file.hpp"
+
+#include <beast/http/headers.hpp>
+#include <beast/http/write.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace beast {
+namespace http {
+
+class file_body_test : public beast::unit_test::suite
+{
+public:
+    struct string_write_stream
+    {
+        std::string str;
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(ConstBufferSequence const& buffers)
+        {
+            error_code ec;
+            return write_some(buffers, ec);
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(
+            ConstBufferSequence const& buffers, error_code&)
+        {
+            using boost::asio::buffer_cast;
+            using boost::asio::buffer_size;
+            std::size_t n = 0;
+            for(auto const& b : buffers)
+            {
+                str.append(buffer_cast<char const*>(b),
+                    buffer_size(b));
+                n += buffer_size(b);
+            }
+            return n;
+        }
+    };
+
+    static
+    std::string
+    make_data(std::size_t n)
+    {
+        std::string s;
+        s.reserve(n);
+        for(std::size_t i = 0; i < n; ++i)
+            s.push_back(static_cast<char>('a' + i % 26));
+        return s;
+    }
+
+    static
+    response<file_body>
+    make_response(std::string const& path,
+        std::size_t size)
+    {
+        response<file_body> m;
+        m.version = 11;
+        m.status = 200;
+        m.reason = "OK";
+        m.headers.insert("Content-Length", size);
+        m.body = path;
+        return m;
+    }
+
+    static
+    std::string
+    head(std::size_t size)
+    {
+        return
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: " + std::to_string(size) + "\r\n"
+            "\r\n";
+    }
+
+    void testWrite()
+    {
+        for(std::size_t size : {
+            std::size_t{0}, std::size_t{1}, std::size_t{100},
+            file_body::block_size + 1, 3 * file_body::block_size})
+        {
+            auto const data = make_data(size);
+            temp_file f{data};
+            auto const m = make_response(f.path(), size);
+            string_write_stream ss;
+            error_code ec;
+            write(ss, m, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(ss.str == head(size) + data);
+        }
+        {
+            auto const m = make_response(
+                temp_file{""}.path() + ".missing", 0);
+            string_write_stream ss;
+            error_code ec;
+            write(ss, m, ec);
+            BEAST_EXPECT(ec == errc::no_such_file_or_directory);
+            BEAST_EXPECT(ss.str.empty());
+        }
+    }
+
+    // Sends through a socket, which uses sendfile where available
+    void testSocket(bool serialize)
+    {
+        using boost::asio::ip::tcp;
+        boost::asio::io_service ios;
+        tcp::acceptor a{ios, tcp::endpoint{
+            boost::asio::ip::address_v4::loopback(), 0}};
+        tcp::socket s1{ios};
+        tcp::socket s2{ios};
+        s1.connect(a.local_endpoint());
+        a.accept(s2);
+        auto const size = 4 * file_body::block_size + 7;
+        auto const data = make_data(size);
+        temp_file f{data};
+        std::string received;
+        std::thread t{
+            [&]
+            {
+                error_code ec;
+                char buf[8192];
+                for(;;)
+                {
+                    auto const n = s2.read_some(
+                        boost::asio::buffer(buf), ec);
+                    if(ec)
+                        break;
+                    received.append(buf, n);
+                }
+            }};
+        error_code ec;
+        if(serialize)
+        {
+            response<file_body> m;
+            m.version = 11;
+            m.status = 200;
+            m.reason = "OK";
+            m.body = f.path();
+            serializer<false, file_body, headers> sr{m};
+            prepare(m, sr);
+            write(s1, sr, ec);
+        }
+        else
+        {
+            write(s1, make_response(f.path(), size), ec);
+        }
+        BEAST_EXPECTS(! ec, ec.message());
+        s1.shutdown(tcp::socket::shutdown_send, ec);
+        t.join();
+        BEAST_EXPECT(received == head(size) + data);
+    }
+
+    // Sends asynchronously through a socket. The file is much
+    // larger than the send buffer and the reader starts late, so
+    // sendfile reports would_block and the operation must wait
+    // for the socket to become writable before resuming.
+    void testAsyncSocket()
+    {
+        using boost::asio::ip::tcp;
+        boost::asio::io_service ios;
+        tcp::acceptor a{ios, tcp::endpoint{
+            boost::asio::ip::address_v4::loopback(), 0}};
+        tcp::socket s1{ios};
+        tcp::socket s2{ios};
+        s1.connect(a.local_endpoint());
+        a.accept(s2);
+        s1.set_option(tcp::socket::send_buffer_size{4096});
+        auto const size = 64 * file_body::block_size + 7;
+        auto const data = make_data(size);
+        temp_file f{data};
+        std::string received;
+        std::thread t{
+            [&]
+            {
+                std::this_thread::sleep_for(
+                    std::chrono::milliseconds(50));
+                error_code ec;
+                char buf[8192];
+                for(;;)
+                {
+                    auto const n = s2.read_some(
+                        boost::asio::buffer(buf), ec);
+                    if(ec)
+                        break;
+                    received.append(buf, n);
+                }
+            }};
+        auto const m = make_response(f.path(), size);
+        bool invoked = false;
+        error_code ec;
+        async_write(s1, m,
+            [&](error_code const& ev)
+            {
+                invoked = true;
+                ec = ev;
+            });
+        ios.run();
+        BEAST_EXPECT(invoked);
+        BEAST_EXPECTS(! ec, ec.message());
+        s1.shutdown(tcp::socket::shutdown_send, ec);
+        t.join();
+        BEAST_EXPECT(received.size() == head(size).size() + size);
+        BEAST_EXPECT(received == head(size) + data);
+    }
+
+    void run() override
+    {
+        testWrite();
+        testSocket(false);
+        testSocket(true);
+        testAsyncSocket();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(file_body,http,beast);
+
+} // http
+} // beast
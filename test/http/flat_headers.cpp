@@ -0,0 +1,192 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/flat_headers.hpp>
+
+#include <beast/http/headers.hpp>
+#include <beast/http/parser_v1.hpp>
+#include <beast/http/string_body.hpp>
+#include <beast/http/write.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <boost/lexical_cast.hpp>
+#include <string>
+#include <vector>
+
+namespace beast {
+namespace http {
+
+class flat_headers_test : public beast::unit_test::suite
+{
+public:
+    template<class FieldSequence>
+    static
+    std::string
+    str(FieldSequence const& h)
+    {
+        std::string s;
+        for(auto const& f : h)
+        {
+            s.append(f.name().data(), f.name().size());
+            s.push_back('=');
+            s.append(f.value().data(), f.value().size());
+            s.push_back(';');
+        }
+        return s;
+    }
+
+    void testHeaders()
+    {
+        flat_headers h1;
+        BEAST_EXPECT(h1.empty());
+        h1.insert("a", 1);
+        BEAST_EXPECT(h1.size() == 1);
+        flat_headers h2;
+        h2 = h1;
+        BEAST_EXPECT(h2.size() == 1);
+        h2.insert("b", "2");
+        BEAST_EXPECT(std::distance(h2.begin(), h2.end()) == 2);
+        h1 = std::move(h2);
+        BEAST_EXPECT(h1.size() == 2);
+        BEAST_EXPECT(h2.size() == 0);
+        flat_headers h3(std::move(h1));
+        BEAST_EXPECT(h3.size() == 2);
+        BEAST_EXPECT(h1.size() == 0);
+        BEAST_EXPECT(str(h3) == "a=1;b=2;");
+        BEAST_EXPECT(h2.erase("Not-Present") == 0);
+        h3.clear();
+        BEAST_EXPECT(h3.empty());
+        BEAST_EXPECT(h3.begin() == h3.end());
+    }
+
+    void testMultimap()
+    {
+        flat_headers h;
+        h.insert("a", "w");
+        h.insert("A", "x");
+        h.insert("aa", "y");
+        h.insert("b", " z ");
+        BEAST_EXPECT(h.count("a") == 2);
+        BEAST_EXPECT(h["a"] == "w");
+        BEAST_EXPECT(h["b"] == "z");
+        BEAST_EXPECT(h["c"].empty());
+        BEAST_EXPECT(str(h) == "a=w;A=x;aa=y;b=z;");
+        BEAST_EXPECT(h.erase("a") == 2);
+        BEAST_EXPECT(h.size() == 2);
+        BEAST_EXPECT(str(h) == "aa=y;b=z;");
+        h.replace("aa", "v");
+        BEAST_EXPECT(str(h) == "b=z;aa=v;");
+        h.replace("B", 3);
+        BEAST_EXPECT(str(h) == "aa=v;B=3;");
+    }
+
+    void testField()
+    {
+        flat_headers h;
+        h.insert("host", "example.com");
+        h.insert(field::content_type, "text/html");
+        h.insert("COOKIE", "a=1");
+        h.insert("Cookie", "b=2");
+        h.insert("X-Custom", "1");
+        BEAST_EXPECT(h[field::host] == "example.com");
+        BEAST_EXPECT(h["Host"] == "example.com");
+        BEAST_EXPECT(h["Content-Type"] == "text/html");
+        BEAST_EXPECT((*h.find(field::content_type)).first ==
+            "Content-Type");
+        BEAST_EXPECT(h.count(field::cookie) == 2);
+        BEAST_EXPECT(h[field::cookie] == "a=1");
+        BEAST_EXPECT(h["x-custom"] == "1");
+        BEAST_EXPECT(! h.exists(field::accept));
+        BEAST_EXPECT(h.find(field::unknown) == h.end());
+    }
+
+    void testAliasing()
+    {
+        flat_headers h;
+        for(int i = 0; i < 10; ++i)
+            h.insert(std::to_string(i), std::string(100, 'a' + i));
+        // values which refer into the container
+        h.insert("copy", h["5"]);
+        BEAST_EXPECT(h["copy"] == std::string(100, 'f'));
+        h.replace("0", h["9"]);
+        BEAST_EXPECT(h["0"] == std::string(100, 'j'));
+        // erasing most fields reclaims the space
+        for(int i = 1; i < 9; ++i)
+            h.erase(std::to_string(i));
+        BEAST_EXPECT(h.size() == 3);
+        BEAST_EXPECT(str(h) ==
+            "9=" + std::string(100, 'j') + ";" +
+            "copy=" + std::string(100, 'f') + ";" +
+            "0=" + std::string(100, 'j') + ";");
+    }
+
+    void testConvert()
+    {
+        headers h0;
+        h0.insert("a", "1");
+        h0.insert("b", "2");
+        h0.insert("a", "3");
+        flat_headers h1(h0.begin(), h0.end());
+        BEAST_EXPECT(str(h1) == str(h0));
+        headers h2(h1.begin(), h1.end());
+        BEAST_EXPECT(str(h2) == str(h0));
+    }
+
+    void testMessage()
+    {
+        {
+            error_code ec;
+            parser_v1<true, string_body, flat_headers> p;
+            std::string const s =
+                "GET / HTTP/1.1\r\n"
+                "Host: localhost\r\n"
+                "Cookie: a=1\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "*****";
+            p.write(boost::asio::buffer(s), ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.complete());
+            auto const& m = p.get();
+            BEAST_EXPECT(m.headers.size() == 3);
+            BEAST_EXPECT(m.headers[field::host] == "localhost");
+            BEAST_EXPECT(m.headers["cookie"] == "a=1");
+            BEAST_EXPECT(m.body == "*****");
+        }
+        {
+            response<string_body, flat_headers> m;
+            m.version = 11;
+            m.status = 200;
+            m.reason = "OK";
+            m.headers.insert("Server", "test");
+            m.body = "*";
+            prepare(m);
+            BEAST_EXPECT(boost::lexical_cast<std::string>(m) ==
+                "HTTP/1.1 200 OK\r\n"
+                "Server: test\r\n"
+                "Content-Length: 1\r\n"
+                "\r\n"
+                "*");
+        }
+    }
+
+    void run() override
+    {
+        testHeaders();
+        testMultimap();
+        testField();
+        testAliasing();
+        testConvert();
+        testMessage();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(flat_headers,http,beast);
+
+} // http
+} // beast
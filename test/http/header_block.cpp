@@ -0,0 +1,76 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/header_block.hpp>
+
+#include <beast/unit_test/suite.hpp>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class header_block_test : public beast::unit_test::suite
+{
+public:
+    static
+    std::string
+    str(boost::asio::const_buffer const& b)
+    {
+        using boost::asio::buffer_cast;
+        using boost::asio::buffer_size;
+        return {buffer_cast<char const*>(b), buffer_size(b)};
+    }
+
+    void testBlock()
+    {
+        header_block h1;
+        BEAST_EXPECT(h1.empty());
+        h1.insert("a", "w");
+        h1.insert("A", " x\t");
+        h1.insert("aa", "y");
+        h1.insert("b", 1);
+        BEAST_EXPECT(h1.size() == 4);
+        BEAST_EXPECT(std::distance(h1.begin(), h1.end()) == 4);
+        BEAST_EXPECT(h1.count("a") == 2);
+        BEAST_EXPECT(h1.count("AA") == 1);
+        BEAST_EXPECT(h1.count("c") == 0);
+        BEAST_EXPECT(h1.exists("B"));
+        BEAST_EXPECT(! h1.exists("c"));
+        BEAST_EXPECT(h1["a"] == "w");
+        BEAST_EXPECT(h1["b"] == "1");
+        BEAST_EXPECT(h1["c"].empty());
+        BEAST_EXPECT((*h1.find("aa")).name() == "aa");
+        BEAST_EXPECT(h1.find("c") == h1.end());
+        BEAST_EXPECT(str(h1.data()) ==
+            "a: w\r\n"
+            "A: x\r\n"
+            "aa: y\r\n"
+            "b: 1\r\n");
+
+        header_block h2(h1);
+        BEAST_EXPECT(h2.size() == 4);
+        BEAST_EXPECT(h2["A"] == "w");
+        header_block h3(std::move(h2));
+        BEAST_EXPECT(h3.size() == 4);
+        h3.clear();
+        BEAST_EXPECT(h3.empty());
+        BEAST_EXPECT(h3.data().size() == 0);
+        h3 = h1;
+        BEAST_EXPECT(h3["aa"] == "y");
+    }
+
+    void run() override
+    {
+        testBlock();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(header_block,http,beast);
+
+} // http
+} // beast
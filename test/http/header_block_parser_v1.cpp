@@ -0,0 +1,115 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/header_block_parser_v1.hpp>
+
+#include <beast/unit_test/suite.hpp>
+#include <boost/asio/buffer.hpp>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class header_block_parser_v1_test : public beast::unit_test::suite
+{
+public:
+    void testParser()
+    {
+        {
+            error_code ec;
+            header_block_parser_v1<true> p;
+            BEAST_EXPECT(! p.complete());
+            auto const n = p.write(boost::asio::buffer(
+                "GET /x HTTP/1.1\r\n"
+                "User-Agent: test\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "*****"
+                ), ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.complete());
+            BEAST_EXPECT(n == 56);
+            auto const& h = p.get();
+            BEAST_EXPECT(h.method == "GET");
+            BEAST_EXPECT(h.url == "/x");
+            BEAST_EXPECT(h.version == 11);
+            BEAST_EXPECT(h.headers.size() == 2);
+            BEAST_EXPECT(h.headers["user-agent"] == "test");
+            BEAST_EXPECT(h.headers["Content-Length"] == "5");
+        }
+        {
+            error_code ec;
+            header_block_parser_v1<false> p;
+            auto const n = p.write(boost::asio::buffer(
+                "HTTP/1.0 404 Not Found\r\n"
+                "Server: test\r\n"
+                "Empty:\r\n"
+                "Folded: a \r\n"
+                "  b \r\n"
+                "\r\n"
+                ), ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(p.complete());
+            BEAST_EXPECT(n == 66);
+            auto const h = p.release();
+            BEAST_EXPECT(h.status == 404);
+            BEAST_EXPECT(h.reason == "Not Found");
+            BEAST_EXPECT(h.version == 10);
+            BEAST_EXPECT(h.headers.size() == 3);
+            BEAST_EXPECT(h.headers.exists("Empty"));
+            BEAST_EXPECT(h.headers["Empty"].empty());
+            BEAST_EXPECT(h.headers["Folded"] == "a   b");
+        }
+    }
+
+    // Every split of the input must produce the same block
+    void testSplit()
+    {
+        std::string const s =
+            "GET /path?q=1 HTTP/1.1\r\n"
+            "Host: www.example.com\r\n"
+            "Cookie: a=1; b=2\r\n"
+            "Cookie: c=3\r\n"
+            "X-Long-Field-Name: value with  spaces \r\n"
+            "\r\n";
+        for(std::size_t i = 0; i < s.size(); ++i)
+        {
+            error_code ec;
+            header_block_parser_v1<true> p;
+            auto n = p.write(boost::asio::buffer(s.data(), i), ec);
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                break;
+            n += p.write(boost::asio::buffer(
+                s.data() + n, s.size() - n), ec);
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                break;
+            BEAST_EXPECT(p.complete());
+            auto const& h = p.get();
+            BEAST_EXPECT(h.url == "/path?q=1");
+            BEAST_EXPECT(h.headers.size() == 4);
+            BEAST_EXPECT(h.headers.count("cookie") == 2);
+            BEAST_EXPECT(h.headers["Cookie"] == "a=1; b=2");
+            BEAST_EXPECT(h.headers["x-long-field-name"] ==
+                "value with  spaces");
+            using boost::asio::buffer_size;
+            BEAST_EXPECT(buffer_size(h.headers.data()) == s.size() -
+                std::string{"GET /path?q=1 HTTP/1.1\r\n\r\n"}.size() - 1);
+        }
+    }
+
+    void run() override
+    {
+        testParser();
+        testSplit();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(header_block_parser_v1,http,beast);
+
+} // http
+} // beast
@@ -0,0 +1,147 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/header_buffer.hpp>
+
+#include <beast/http/headers.hpp>
+#include <beast/http/string_body.hpp>
+#include <beast/http/write.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class header_buffer_test : public beast::unit_test::suite
+{
+public:
+    struct string_write_stream
+    {
+        std::string str;
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(ConstBufferSequence const& buffers)
+        {
+            error_code ec;
+            return write_some(buffers, ec);
+        }
+
+        template<class ConstBufferSequence>
+        std::size_t
+        write_some(
+            ConstBufferSequence const& buffers, error_code&)
+        {
+            using boost::asio::buffer_cast;
+            using boost::asio::buffer_size;
+            std::size_t n = 0;
+            for(auto const& b : buffers)
+            {
+                str.append(buffer_cast<char const*>(b),
+                    buffer_size(b));
+                n += buffer_size(b);
+            }
+            return n;
+        }
+    };
+
+    static
+    std::string
+    str(boost::asio::const_buffer const& b)
+    {
+        using boost::asio::buffer_cast;
+        using boost::asio::buffer_size;
+        return {buffer_cast<char const*>(b), buffer_size(b)};
+    }
+
+    void testBuffer()
+    {
+        header_buffer hb;
+        BEAST_EXPECT(hb.size() == 0);
+        BEAST_EXPECT(hb.capacity() == 0);
+        hb.reserve(100);
+        BEAST_EXPECT(hb.capacity() == 100);
+        auto p = hb.prepare(5);
+        std::memcpy(p, "hello", 5);
+        BEAST_EXPECT(hb.size() == 5);
+        BEAST_EXPECT(str(*hb.data().begin()) == "hello");
+        BEAST_EXPECT(hb.prepare(200) != nullptr);
+        BEAST_EXPECT(hb.capacity() == 200);
+        hb.clear();
+        BEAST_EXPECT(hb.size() == 0);
+        BEAST_EXPECT(hb.capacity() == 200);
+        header_buffer hb2(std::move(hb));
+        BEAST_EXPECT(hb.size() == 0);
+        BEAST_EXPECT(hb2.capacity() == 200);
+    }
+
+    void testWrite()
+    {
+        header_buffer hb;
+        {
+            response<string_body> m;
+            m.version = 11;
+            m.status = 200;
+            m.reason = "OK";
+            m.headers.insert("Server", "test");
+            m.headers.insert("Content-Length", "5");
+            m.body = "*****";
+            string_write_stream ss;
+            write(ss, m, hb);
+            BEAST_EXPECT(ss.str ==
+                "HTTP/1.1 200 OK\r\n"
+                "Server: test\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "*****");
+        }
+        // The storage is reused for a smaller message
+        auto const capacity = hb.capacity();
+        BEAST_EXPECT(capacity > 0);
+        {
+            request<string_body> m;
+            m.method = "GET";
+            m.url = "/";
+            m.version = 10;
+            m.headers.insert("Content-Length", "0");
+            string_write_stream ss;
+            error_code ec;
+            write(ss, m, hb, ec);
+            BEAST_EXPECT(! ec);
+            BEAST_EXPECT(ss.str ==
+                "GET / HTTP/1.0\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n");
+            BEAST_EXPECT(hb.capacity() == capacity);
+        }
+        {
+            response<string_body> m;
+            m.version = 20;
+            m.status = 42;
+            m.reason = "Unknown";
+            m.headers.insert("Content-Length", "0");
+            string_write_stream ss;
+            write(ss, m, hb);
+            BEAST_EXPECT(ss.str ==
+                "HTTP/2.0 42 Unknown\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n");
+        }
+    }
+
+    void run() override
+    {
+        testBuffer();
+        testWrite();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(header_buffer,http,beast);
+
+} // http
+} // beast
@@ -0,0 +1,154 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "message_fuzz.hpp"
+
+#include <beast/http.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace beast {
+namespace http {
+
+class headers_bench_test : public beast::unit_test::suite
+{
+public:
+    static std::size_t constexpr N = 1000;
+
+    std::vector<streambuf> corpus_;
+
+    headers_bench_test()
+    {
+        corpus_.resize(N);
+        message_fuzz mg;
+        for(auto& sb : corpus_)
+            mg.request(sb);
+    }
+
+    template<class Function>
+    void
+    timedTest(std::size_t repeat, std::string const& name, Function&& f)
+    {
+        using namespace std::chrono;
+        using clock_type = std::chrono::high_resolution_clock;
+        log << name << std::endl;
+        for(std::size_t trial = 1; trial <= repeat; ++trial)
+        {
+            auto const t0 = clock_type::now();
+            f();
+            auto const elapsed = clock_type::now() - t0;
+            log <<
+                "Trial " << trial << ": " <<
+                duration_cast<milliseconds>(elapsed).count() << " ms" << std::endl;
+        }
+    }
+
+    // Parse each message, then look up fields
+    // the way a typical server would.
+    template<class Headers>
+    std::size_t
+    parseAndLookup(std::size_t repeat)
+    {
+        std::size_t n = 0;
+        while(repeat--)
+            for(auto const& sb : corpus_)
+            {
+                parser_v1<true, streambuf_body, Headers> p;
+                error_code ec;
+                p.write(sb.data(), ec);
+                if(! BEAST_EXPECTS(! ec, ec.message()))
+                    return n;
+                auto const& h = p.get().headers;
+                n += h["Host"].size();
+                n += h["Content-Type"].size();
+                n += h["Cookie"].size();
+                n += h["X-Not-Present"].size();
+                for(auto const& f : h)
+                    n += f.value().size();
+            }
+        return n;
+    }
+
+    // Look up fields in an already parsed message
+    template<class Headers>
+    std::size_t
+    lookup(std::size_t repeat)
+    {
+        std::vector<Headers> v;
+        v.reserve(corpus_.size());
+        for(auto const& sb : corpus_)
+        {
+            parser_v1<true, streambuf_body, Headers> p;
+            error_code ec;
+            p.write(sb.data(), ec);
+            v.emplace_back(p.release().headers);
+        }
+        std::size_t n = 0;
+        while(repeat--)
+            for(auto const& h : v)
+            {
+                n += h["Host"].size();
+                n += h["Content-Type"].size();
+                n += h["Cookie"].size();
+                n += h["X-Not-Present"].size();
+                n += h[field::host].size();
+            }
+        return n;
+    }
+
+    void
+    testSpeed()
+    {
+        static std::size_t constexpr Trials = 3;
+        static std::size_t constexpr Repeat = 20;
+
+        std::size_t n0 = 0;
+        std::size_t n1 = 0;
+
+        testcase << "Parse and lookup, " <<
+            (Repeat * corpus_.size()) << " messages";
+        timedTest(Trials, "basic_headers",
+            [&]
+            {
+                n0 = parseAndLookup<headers>(Repeat);
+            });
+        timedTest(Trials, "flat_headers",
+            [&]
+            {
+                n1 = parseAndLookup<flat_headers>(Repeat);
+            });
+        BEAST_EXPECT(n0 == n1);
+
+        testcase << "Lookup, " <<
+            (Repeat * 10 * corpus_.size()) << " messages";
+        timedTest(Trials, "basic_headers",
+            [&]
+            {
+                n0 = lookup<headers>(Repeat * 10);
+            });
+        timedTest(Trials, "flat_headers",
+            [&]
+            {
+                n1 = lookup<flat_headers>(Repeat * 10);
+            });
+        BEAST_EXPECT(n0 == n1);
+    }
+
+    void run() override
+    {
+        pass();
+        testSpeed();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(headers_bench,http,beast);
+
+} // http
+} // beast
@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/mapped_file.hpp>
+
+#include "temp_file.hpp"
+
+#include <beast/core/to_string.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace beast {
+namespace http {
+
+class mapped_file_test : public beast::unit_test::suite
+{
+public:
+    void testFile()
+    {
+        temp_file f;
+        f.write("Hello, world!");
+        mapped_file mf;
+        BEAST_EXPECT(mf.size() == 0);
+        error_code ec;
+        mf.open(f.path(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(mf.size() == 13);
+        BEAST_EXPECT(to_string(mf.data()) == "Hello, world!");
+        mf.close();
+        BEAST_EXPECT(mf.size() == 0);
+
+        temp_file empty;
+        empty.write("");
+        mf.open(empty.path(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(mf.size() == 0);
+
+        mf.open(f.path() + ".missing", ec);
+        BEAST_EXPECT(ec == errc::no_such_file_or_directory);
+    }
+
+    void testCache()
+    {
+        temp_file f1;
+        temp_file f2;
+        temp_file f3;
+        f1.write("1");
+        f2.write("22");
+        f3.write("333");
+        mapped_file_cache cache{2};
+        BEAST_EXPECT(cache.capacity() == 2);
+        error_code ec;
+
+        // The same file is shared
+        auto const p1 = cache.get(f1.path(), ec);
+        BEAST_EXPECT(! ec);
+        BEAST_EXPECT(p1 && to_string(p1->data()) == "1");
+        BEAST_EXPECT(cache.get(f1.path(), ec) == p1);
+        BEAST_EXPECT(cache.size() == 1);
+
+        // The least recently used file is evicted
+        auto const p2 = cache.get(f2.path(), ec);
+        BEAST_EXPECT(cache.get(f1.path(), ec) == p1);
+        auto const p3 = cache.get(f3.path(), ec);
+        BEAST_EXPECT(cache.size() == 2);
+        BEAST_EXPECT(cache.get(f1.path(), ec) == p1);
+        BEAST_EXPECT(cache.get(f3.path(), ec) == p3);
+        auto const p2b = cache.get(f2.path(), ec);
+        BEAST_EXPECT(p2b != p2);
+        // An evicted mapping is still valid
+        BEAST_EXPECT(to_string(p2->data()) == "22");
+
+        // A changed file is mapped again
+        f3.write("4444");
+        auto const p4 = cache.get(f3.path(), ec);
+        BEAST_EXPECT(p4 != p3);
+        BEAST_EXPECT(to_string(p4->data()) == "4444");
+
+        // A file rewritten with the same size within
+        // the same second is mapped again
+        {
+            temp_file f;
+            f.write("aaaa");
+            auto const pa = cache.get(f.path(), ec);
+            std::this_thread::sleep_for(
+                std::chrono::milliseconds(20));
+            f.write("bbbb");
+            mapped_file mf;
+            mf.open(f.path(), ec);
+            // Unless the file system only keeps seconds
+            if(mf.mtime() != pa->mtime())
+                BEAST_EXPECT(to_string(cache.get(
+                    f.path(), ec)->data()) == "bbbb");
+        }
+
+        // Errors are reported
+        BEAST_EXPECT(! cache.get(f1.path() + ".missing", ec));
+        BEAST_EXPECT(ec == errc::no_such_file_or_directory);
+
+        cache.clear();
+        BEAST_EXPECT(cache.size() == 0);
+        BEAST_EXPECT(to_string(p1->data()) == "1");
+    }
+
+    void testConcurrent()
+    {
+        temp_file f;
+        f.write("Hello, world!");
+        mapped_file_cache cache;
+        // Lookups racing to map the same file
+        // leave one mapping in the cache
+        std::vector<std::shared_ptr<
+            mapped_file const>> v(8);
+        std::vector<std::thread> threads;
+        for(auto& p : v)
+            threads.emplace_back(
+                [&]
+                {
+                    error_code ec;
+                    p = cache.get(f.path(), ec);
+                });
+        for(auto& t : threads)
+            t.join();
+        for(auto const& p : v)
+            BEAST_EXPECT(p && to_string(
+                p->data()) == "Hello, world!");
+        BEAST_EXPECT(cache.size() == 1);
+    }
+
+    void run() override
+    {
+        testFile();
+        testCache();
+        testConcurrent();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(mapped_file,http,beast);
+
+} // http
+} // beast
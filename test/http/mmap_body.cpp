@@ -0,0 +1,82 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/mmap_body.hpp>
+
+#include "temp_file.hpp"
+
+#include <beast/http/headers.hpp>
+#include <beast/http/write.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <boost/lexical_cast.hpp>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class mmap_body_test : public beast::unit_test::suite
+{
+public:
+    template<bool isRequest, class Body, class Headers>
+    static
+    std::string
+    str(message<isRequest, Body, Headers> const& m)
+    {
+        return boost::lexical_cast<std::string>(m);
+    }
+
+    void testWrite()
+    {
+        temp_file f{"*****"};
+        mapped_file_cache cache;
+        error_code ec;
+        response<mmap_body> m;
+        m.version = 11;
+        m.status = 200;
+        m.reason = "OK";
+        m.body = cache.get(f.path(), ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        prepare(m);
+        // Both messages refer to the same mapping
+        auto m2 = m;
+        BEAST_EXPECT(m2.body == m.body);
+        BEAST_EXPECT(str(m2) ==
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "*****");
+        m.headers.erase("Content-Length");
+        m.headers.insert("Transfer-Encoding", "chunked");
+        BEAST_EXPECT(str(m) ==
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "5\r\n*****\r\n"
+            "0\r\n\r\n");
+        m.body = nullptr;
+        try
+        {
+            str(m);
+            fail();
+        }
+        catch(system_error const&)
+        {
+            pass();
+        }
+    }
+
+    void run() override
+    {
+        testWrite();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(mmap_body,http,beast);
+
+} // http
+} // beast
@@ -14,6 +14,9 @@
 #include <beast/unit_test/suite.hpp>
 #include <chrono>
 #include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
 #include <vector>
 
 namespace beast {
@@ -28,12 +31,82 @@ public:
 
     corpus creq_;
     corpus cres_;
+    corpus clong_;
+    corpus cchunk_;
     std::size_t size_ = 0;
+    std::size_t long_size_ = 0;
+    std::size_t chunk_size_ = 0;
 
     parser_bench_test()
     {
         creq_ = build_corpus(N/2, std::true_type{});
         cres_ = build_corpus(N/2, std::false_type{});
+        clong_ = build_long_corpus(N/8);
+        cchunk_ = build_chunked_corpus(N/8);
+    }
+
+    // Responses streaming many small chunks
+    corpus
+    build_chunked_corpus(std::size_t n)
+    {
+        corpus v;
+        v.resize(n);
+        std::mt19937 rng;
+        std::uniform_int_distribution<std::size_t> d(8, 64);
+        for(auto& sb : v)
+        {
+            write(sb,
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Type: text/event-stream\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n");
+            for(int i = 0; i < 200; ++i)
+            {
+                std::string const s =
+                    "data: " + std::string(d(rng), '*') + "\n\n";
+                std::ostringstream ss;
+                ss << std::hex << s.size();
+                write(sb, ss.str(), "\r\n", s, "\r\n");
+            }
+            write(sb, "0\r\n\r\n");
+            chunk_size_ += sb.size();
+        }
+        return v;
+    }
+
+    // Requests with a long query string and multi-KB cookie
+    corpus
+    build_long_corpus(std::size_t n)
+    {
+        corpus v;
+        v.resize(n);
+        std::mt19937 rng;
+        auto const text =
+            [&](std::size_t len)
+            {
+                static char constexpr alphabet[] =
+                    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"
+                    "0123456789-_.~%=&;+";
+                std::string s;
+                s.reserve(len);
+                std::uniform_int_distribution<std::size_t>
+                    d(0, sizeof(alphabet) - 2);
+                while(s.size() < len)
+                    s.push_back(alphabet[d(rng)]);
+                return s;
+            };
+        for(auto& sb : v)
+        {
+            write(sb,
+                "GET /search?q=", text(1024), " HTTP/1.1\r\n"
+                "Host: www.example.com\r\n"
+                "User-Agent: ", text(128), "\r\n"
+                "Cookie: ", text(4096), "\r\n"
+                "Referer: http://www.example.com/", text(256), "\r\n"
+                "\r\n");
+            long_size_ += sb.size();
+        }
+        return v;
     }
 
     corpus
@@ -114,6 +187,12 @@ public:
         log << "sizeof(response parser) == " <<
             sizeof(basic_parser_v1<false, null_parser<true>>)<< '\n';
 
+#if BEAST_HTTP_COMPUTED_GOTO
+        log << "dispatch: computed goto" << '\n';
+#else
+        log << "dispatch: switch" << '\n';
+#endif
+
         testcase << "Parser speed test, " <<
             ((Repeat * size_ + 512) / 1024) << "KB in " <<
                 (Repeat * (creq_.size() + cres_.size())) << " messages";
@@ -138,6 +217,44 @@ public:
                     false, streambuf_body, headers>>(
                         Repeat, cres_);
             });
+
+        testcase << "Parser speed test, long fields, " <<
+            ((Repeat * long_size_ + 512) / 1024) << "KB in " <<
+                (Repeat * clong_.size()) << " messages";
+
+        timedTest(Trials, "nodejs_parser",
+            [&]
+            {
+                testParser<nodejs_parser<
+                    true, streambuf_body, headers>>(
+                        Repeat, clong_);
+            });
+        timedTest(Trials, "http::basic_parser_v1",
+            [&]
+            {
+                testParser<parser_v1<
+                    true, streambuf_body, headers>>(
+                        Repeat, clong_);
+            });
+
+        testcase << "Parser speed test, small chunks, " <<
+            ((Repeat * chunk_size_ + 512) / 1024) << "KB in " <<
+                (Repeat * cchunk_.size()) << " messages";
+
+        timedTest(Trials, "nodejs_parser",
+            [&]
+            {
+                testParser<nodejs_parser<
+                    false, streambuf_body, headers>>(
+                        Repeat, cchunk_);
+            });
+        timedTest(Trials, "http::basic_parser_v1",
+            [&]
+            {
+                testParser<parser_v1<
+                    false, streambuf_body, headers>>(
+                        Repeat, cchunk_);
+            });
         pass();
     }
 
@@ -10,13 +10,22 @@
 
 #include "fail_parser.hpp"
 
+#include <beast/http/allow_inline.hpp>
 #include <beast/http/headers.hpp>
 #include <beast/http/streambuf_body.hpp>
+#include <beast/http/string_body.hpp>
+#include <beast/core/flat_streambuf.hpp>
+#include <beast/core/ring_streambuf.hpp>
+#include <beast/core/to_string.hpp>
 #include <beast/test/fail_stream.hpp>
 #include <beast/test/string_stream.hpp>
 #include <beast/test/yield_to.hpp>
 #include <beast/unit_test/suite.hpp>
 #include <boost/asio/spawn.hpp>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
 
 namespace beast {
 namespace http {
@@ -308,6 +317,537 @@ public:
         BEAST_EXPECT(n < limit);
     }
 
+    void testReadBatch(yield_context do_yield)
+    {
+        std::string const s =
+            "GET /1 HTTP/1.1\r\n"
+            "Content-Length: 0\r\n"
+            "\r\n"
+            "GET /2 HTTP/1.1\r\n"
+            "Content-Length: 1\r\n"
+            "\r\n"
+            "*"
+            "GET /3 HTTP/1.1\r\n"
+            "Connection: close\r\n"
+            "\r\n"
+            "GET /4 HTTP/1.1\r\n"
+            "\r\n"
+            "GET /5 HTTP/1.1\r\n";
+        {
+            streambuf sb;
+            test::string_stream ss(ios_, s);
+            std::vector<request<streambuf_body>> v;
+            read_batch(ss, sb, v);
+            if(BEAST_EXPECT(v.size() == 3))
+            {
+                BEAST_EXPECT(v[0].url == "/1");
+                BEAST_EXPECT(v[1].url == "/2");
+                BEAST_EXPECT(v[1].body.size() == 1);
+                BEAST_EXPECT(v[2].url == "/3");
+            }
+            // A message following Connection: close starts a new batch
+            error_code ec;
+            read_batch(ss, sb, v, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            if(BEAST_EXPECT(v.size() == 1))
+                BEAST_EXPECT(v[0].url == "/4");
+            // The incomplete message remains in the buffer
+            BEAST_EXPECT(sb.size() == 17);
+        }
+        {
+            streambuf sb;
+            test::string_stream ss(ios_, s);
+            std::vector<request<streambuf_body>> v;
+            error_code ec;
+            async_read_batch(ss, sb, v, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            if(BEAST_EXPECT(v.size() == 3))
+            {
+                BEAST_EXPECT(v[0].url == "/1");
+                BEAST_EXPECT(v[1].url == "/2");
+                BEAST_EXPECT(v[2].url == "/3");
+            }
+            async_read_batch(ss, sb, v, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            if(BEAST_EXPECT(v.size() == 1))
+                BEAST_EXPECT(v[0].url == "/4");
+            async_read_batch(ss, sb, v, do_yield[ec]);
+            BEAST_EXPECT(ec);
+        }
+        {
+            // An invalid message ends the batch,
+            // and is reported by the next call.
+            streambuf sb;
+            test::string_stream ss(ios_,
+                "GET /1 HTTP/1.1\r\n"
+                "\r\n"
+                "GET /2 X\r\n"
+                "\r\n");
+            std::vector<request<streambuf_body>> v;
+            error_code ec;
+            read_batch(ss, sb, v, ec);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(v.size() == 1);
+            read_batch(ss, sb, v, ec);
+            BEAST_EXPECT(ec);
+            BEAST_EXPECT(v.empty());
+        }
+        {
+            static std::size_t constexpr limit = 100;
+            std::size_t n;
+            for(n = 0; n < limit; ++n)
+            {
+                test::fail_stream<test::string_stream> fs(n, ios_, s);
+                std::vector<request<streambuf_body>> v;
+                error_code ec;
+                streambuf sb;
+                async_read_batch(fs, sb, v, do_yield[ec]);
+                if(! ec)
+                    break;
+            }
+            BEAST_EXPECT(n < limit);
+        }
+    }
+
+    // Reads messages one at a time as continuations,
+    // optionally permitting inline completion.
+    class chain_reader
+    {
+        test::string_stream& s_;
+        streambuf& sb_;
+        request<streambuf_body>& m_;
+        std::size_t& n_;
+        std::size_t& depth_;
+        std::size_t& max_depth_;
+        bool inline_;
+
+    public:
+        chain_reader(test::string_stream& s, streambuf& sb,
+                request<streambuf_body>& m, std::size_t& n,
+                    std::size_t& depth, std::size_t& max_depth,
+                        bool inline_)
+            : s_(s)
+            , sb_(sb)
+            , m_(m)
+            , n_(n)
+            , depth_(depth)
+            , max_depth_(max_depth)
+            , inline_(inline_)
+        {
+        }
+
+        void
+        operator()(error_code const& ec)
+        {
+            if(ec)
+                return;
+            max_depth_ = (std::max)(max_depth_, ++depth_);
+            if(--n_ > 0)
+            {
+                if(inline_)
+                    async_read(s_, sb_, m_,
+                        allow_inline(std::move(*this)));
+                else
+                    async_read(s_, sb_, m_, std::move(*this));
+            }
+            --depth_;
+        }
+
+        friend
+        bool
+        asio_handler_is_continuation(chain_reader*)
+        {
+            return true;
+        }
+    };
+
+    void testContinuation()
+    {
+        using clock_type = std::chrono::high_resolution_clock;
+        using namespace std::chrono;
+        static std::size_t constexpr Batch = 1000;
+        static std::size_t constexpr Repeat = 10;
+        std::string s;
+        for(std::size_t i = 0; i < Batch; ++i)
+            s.append(
+                "GET / HTTP/1.1\r\n"
+                "Host: localhost\r\n"
+                "Content-Length: 0\r\n"
+                "\r\n");
+        auto const measure =
+            [&](bool inline_)
+            {
+                boost::asio::io_service ios;
+                std::size_t total = 0;
+                std::size_t depth = 0;
+                std::size_t max_depth = 0;
+                auto const t0 = clock_type::now();
+                for(std::size_t i = 0; i < Repeat; ++i)
+                {
+                    test::string_stream ss(ios, s);
+                    streambuf sb;
+                    request<streambuf_body> m;
+                    std::size_t n = Batch;
+                    async_read(ss, sb, m, chain_reader{
+                        ss, sb, m, n, depth, max_depth, inline_});
+                    ios.run();
+                    ios.reset();
+                    total += Batch - n;
+                }
+                auto const elapsed = clock_type::now() - t0;
+                BEAST_EXPECT(total == Repeat * Batch);
+                // Continuations are posted unless allowed inline,
+                // and inline completions do not nest without bound
+                if(inline_)
+                    BEAST_EXPECT(max_depth > 1 && max_depth <=
+                        detail::parse_depth::limit + 1);
+                else
+                    BEAST_EXPECT(max_depth == 1);
+                return duration_cast<nanoseconds>(
+                    elapsed).count() / (Repeat * Batch);
+            };
+        log << "async_read, posted completion: " <<
+            measure(false) << " ns per message" << std::endl;
+        log << "async_read, allow_inline:      " <<
+            measure(true) << " ns per message" << std::endl;
+    }
+
+    template<bool isRequest, class Body>
+    void
+    direct(std::string const& pre, std::string const& rest,
+        std::string const& body, error_code const& ev,
+            yield_context do_yield)
+    {
+        using boost::asio::buffer;
+        using boost::asio::buffer_copy;
+        for(int i = 0; i < 2; ++i)
+        {
+            streambuf sb;
+            sb.commit(buffer_copy(
+                sb.prepare(pre.size()), buffer(pre)));
+            test::string_stream ss(ios_, rest);
+            message<isRequest, Body, headers> m;
+            error_code ec;
+            if(i == 0)
+                read(ss, sb, m, ec);
+            else
+                async_read(ss, sb, m, do_yield[ec]);
+            if(! BEAST_EXPECTS(ec == ev, ec.message()))
+                continue;
+            if(! ec)
+                BEAST_EXPECT(body_string(m.body) == body);
+        }
+    }
+
+    static
+    std::string const&
+    body_string(std::string const& s)
+    {
+        return s;
+    }
+
+    static
+    std::string
+    body_string(streambuf const& sb)
+    {
+        return beast::to_string(sb.data());
+    }
+
+    // A string body which counts the steps of a direct read
+    struct counting_body
+    {
+        struct value_type
+        {
+            std::string s;
+            std::size_t steps = 0;
+        };
+
+        class reader
+        {
+            value_type& v_;
+            std::size_t len_ = 0;
+
+        public:
+            template<bool isRequest, class Headers>
+            explicit
+            reader(message<isRequest,
+                    counting_body, Headers>& m) noexcept
+                : v_(m.body)
+            {
+            }
+
+            void
+            init(error_code&) noexcept
+            {
+            }
+
+            void
+            write(void const* data,
+                std::size_t size, error_code&) noexcept
+            {
+                v_.s.append(static_cast<char const*>(data), size);
+            }
+
+            boost::asio::mutable_buffers_1
+            prepare(std::size_t n, error_code&)
+            {
+                ++v_.steps;
+                len_ = v_.s.size();
+                v_.s.resize(len_ + n);
+                return {&v_.s[len_], n};
+            }
+
+            void
+            commit(std::size_t n, error_code&)
+            {
+                v_.s.resize(len_ + n);
+            }
+        };
+    };
+
+    template<bool isRequest>
+    std::size_t
+    direct_steps(std::string const& s,
+        std::string const& body, bool async,
+            yield_context do_yield)
+    {
+        test::string_stream ss(ios_, s);
+        streambuf sb;
+        message<isRequest, counting_body, headers> m;
+        error_code ec;
+        if(async)
+            async_read(ss, sb, m, do_yield[ec]);
+        else
+            read(ss, sb, m, ec);
+        BEAST_EXPECTS(! ec, ec.message());
+        BEAST_EXPECT(m.body.s == body);
+        return m.body.steps;
+    }
+
+    void testDirectSteps(yield_context do_yield)
+    {
+        std::string const body(1024 * 1024, '*');
+        for(int i = 0; i < 2; ++i)
+        {
+            // Checked against the body limit, read in one step
+            BEAST_EXPECT(direct_steps<true>(
+                "POST / HTTP/1.1\r\n"
+                "Content-Length: 1048576\r\n"
+                "\r\n" + body, body, i == 1, do_yield) == 1);
+            BEAST_EXPECT(direct_steps<true>(
+                "POST / HTTP/1.1\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "100000\r\n" + body + "\r\n"
+                "0\r\n\r\n", body, i == 1, do_yield) == 1);
+            // Without a limit the step doubles the body
+            BEAST_EXPECT(direct_steps<false>(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 1048576\r\n"
+                "\r\n" + body, body, i == 1, do_yield) <= 5);
+            BEAST_EXPECT(direct_steps<false>(
+                "HTTP/1.1 200 OK\r\n"
+                "\r\n" + body, body, i == 1, do_yield) <= 7);
+        }
+    }
+
+    void testReadDirect(yield_context do_yield)
+    {
+        std::string const h =
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 10\r\n"
+            "\r\n";
+        // Content-Length
+        direct<false, string_body>(
+            "", h + "0123456789", "0123456789", {}, do_yield);
+        direct<false, string_body>(
+            h + "012", "3456789", "0123456789", {}, do_yield);
+        direct<false, string_body>(
+            h, "0123456789", "0123456789", {}, do_yield);
+        direct<false, streambuf_body>(
+            h + "01234", "56789", "0123456789", {}, do_yield);
+        direct<false, string_body>(
+            h + "01234", "", "", parse_error::short_read, do_yield);
+        direct<false, string_body>(
+            "HTTP/1.1 204 No Content\r\n\r\n", "", "", {}, do_yield);
+        // chunked
+        direct<false, string_body>("",
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "5\r\nhello\r\n"
+            "6;x=y\r\n world\r\n"
+            "0\r\n"
+            "\r\n", "hello world", {}, do_yield);
+        direct<false, streambuf_body>(
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "5\r\nhel",
+            "lo\r\n"
+            "6\r\n world\r\n"
+            "0\r\n"
+            "\r\n", "hello world", {}, do_yield);
+        direct<false, string_body>(
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "5\r\nhel",
+            "lo\r\n", "", parse_error::short_read, do_yield);
+        // body ends at eof
+        direct<false, string_body>(
+            "HTTP/1.1 200 OK\r\n\r\nhel", "lo", "hello", {}, do_yield);
+        direct<false, string_body>(
+            "", "HTTP/1.1 200 OK\r\n\r\n", "", {}, do_yield);
+        // Storage grows with the octets received,
+        // not with the size announced by the peer
+        direct<false, string_body>(
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 99999999999999\r\n"
+            "\r\n", "hello", "", parse_error::short_read, do_yield);
+        direct<false, streambuf_body>(
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 99999999999999\r\n"
+            "\r\n", "hello", "", parse_error::short_read, do_yield);
+        direct<false, string_body>(
+            "HTTP/1.1 200 OK\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "ffffffffffff\r\n", "hello", "",
+                parse_error::short_read, do_yield);
+        {
+            std::string const body(200000, '*');
+            direct<false, string_body>(
+                "HTTP/1.1 200 OK\r\n"
+                "Content-Length: 200000\r\n"
+                "\r\n", body, body, {}, do_yield);
+            direct<false, string_body>(
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "30d40\r\n", body + "\r\n0\r\n\r\n",
+                    body, {}, do_yield);
+        }
+        // The limit applies before storage is allocated
+        direct<true, string_body>(
+            "GET / HTTP/1.1\r\n"
+            "Content-Length: 1000000000\r\n"
+            "\r\n", "", "", parse_error::body_too_big, do_yield);
+        direct<true, string_body>(
+            "GET / HTTP/1.1\r\n"
+            "Transfer-Encoding: chunked\r\n"
+            "\r\n"
+            "40000000\r\n", "", "", parse_error::body_too_big, do_yield);
+
+        // Octets after the message remain in the buffer
+        {
+            streambuf sb;
+            test::string_stream ss(ios_,
+                "GET / HTTP/1.1\r\n"
+                "Content-Length: 3\r\n"
+                "\r\n"
+                "abc"
+                "GET /2 HTTP/1.1\r\n");
+            request<string_body> m;
+            read(ss, sb, m);
+            BEAST_EXPECT(m.body == "abc");
+            BEAST_EXPECT(beast::to_string(sb.data()) ==
+                "GET /2 HTTP/1.1\r\n");
+        }
+    }
+
+    void testFlatStreambuf(yield_context do_yield)
+    {
+        std::string const body(2000, '*');
+        std::string const s =
+            "POST /1 HTTP/1.1\r\n"
+            "Content-Length: 2000\r\n"
+            "\r\n" + body +
+            "POST /2 HTTP/1.1\r\n"
+            "Content-Length: 2000\r\n"
+            "\r\n" + body;
+        {
+            flat_streambuf sb;
+            test::string_stream ss(ios_, s);
+            request<string_body> m1;
+            request<string_body> m2;
+            read(ss, sb, m1);
+            read(ss, sb, m2);
+            BEAST_EXPECT(m1.url == "/1");
+            BEAST_EXPECT(m1.body == body);
+            BEAST_EXPECT(m2.url == "/2");
+            BEAST_EXPECT(m2.body == body);
+            BEAST_EXPECT(sb.size() == 0);
+        }
+        {
+            flat_streambuf sb;
+            test::string_stream ss(ios_, s);
+            request<string_body> m1;
+            request<string_body> m2;
+            error_code ec;
+            async_read(ss, sb, m1, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            async_read(ss, sb, m2, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(m1.body == body);
+            BEAST_EXPECT(m2.url == "/2");
+            BEAST_EXPECT(m2.body == body);
+        }
+        {
+            // A small buffer is enough, the parser
+            // consumes the input as it arrives
+            flat_streambuf sb{16};
+            test::string_stream ss(ios_, s);
+            request<string_body> m;
+            read(ss, sb, m);
+            BEAST_EXPECT(m.body == body);
+            BEAST_EXPECT(sb.capacity() <= 16);
+        }
+    }
+
+    void testRingStreambuf(yield_context do_yield)
+    {
+        // Many pipelined messages wrap around the end of the ring
+        std::string s;
+        for(int i = 0; i < 100; ++i)
+            s +=
+                "POST /" + std::to_string(i) + " HTTP/1.1\r\n"
+                "Content-Length: 100\r\n"
+                "\r\n" + std::string(100, '*');
+        {
+            ring_streambuf sb;
+            test::string_stream ss(ios_, s);
+            std::size_t cap = 0;
+            for(int i = 0; i < 100; ++i)
+            {
+                parser_v1<true, string_body, headers> p;
+                parse(ss, sb, p);
+                auto const m = p.release();
+                BEAST_EXPECT(m.url == "/" + std::to_string(i));
+                BEAST_EXPECT(m.body == std::string(100, '*'));
+                if(i == 0)
+                    cap = sb.capacity();
+            }
+            // The first allocation is reused, whatever its
+            // size after rounding up to the page size.
+            BEAST_EXPECT(cap > 0);
+            BEAST_EXPECT(sb.capacity() == cap);
+        }
+        {
+            ring_streambuf sb;
+            test::string_stream ss(ios_, s);
+            for(int i = 0; i < 100; ++i)
+            {
+                request<string_body> m;
+                error_code ec;
+                async_read(ss, sb, m, do_yield[ec]);
+                if(! BEAST_EXPECTS(! ec, ec.message()))
+                    break;
+                BEAST_EXPECT(m.url == "/" + std::to_string(i));
+            }
+        }
+    }
+
     void testEof(yield_context do_yield)
     {
         {
@@ -338,8 +878,24 @@ public:
         yield_to(std::bind(&read_test::testRead,
             this, std::placeholders::_1));
 
+        yield_to(std::bind(&read_test::testReadBatch,
+            this, std::placeholders::_1));
+
+        yield_to(std::bind(&read_test::testReadDirect,
+            this, std::placeholders::_1));
+
+        yield_to(std::bind(&read_test::testDirectSteps,
+            this, std::placeholders::_1));
+        yield_to(std::bind(&read_test::testFlatStreambuf,
+            this, std::placeholders::_1));
+
+        yield_to(std::bind(&read_test::testRingStreambuf,
+            this, std::placeholders::_1));
+
         yield_to(std::bind(&read_test::testEof,
             this, std::placeholders::_1));
+
+        testContinuation();
     }
 };
 
@@ -0,0 +1,247 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Test that header file is self-contained.
+#include <beast/http/serializer.hpp>
+
+#include <beast/http/headers.hpp>
+#include <beast/http/string_body.hpp>
+#include <beast/core/buffer_cat.hpp>
+#include <beast/core/to_string.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <string>
+
+namespace beast {
+namespace http {
+
+class serializer_test : public beast::unit_test::suite
+{
+public:
+    // Produces one octet per call, suspending
+    // until the test sets the ready flag.
+    struct slow_body
+    {
+        struct value_type
+        {
+            std::string s;
+            bool ready = true;
+            resume_context rc;
+        };
+
+        class writer
+        {
+            value_type& body_;
+            std::size_t n_ = 0;
+
+        public:
+            template<bool isRequest, class Headers>
+            explicit
+            writer(message<isRequest,
+                    slow_body, Headers> const& m) noexcept
+                : body_(const_cast<value_type&>(m.body))
+            {
+            }
+
+            void
+            init(error_code&) noexcept
+            {
+            }
+
+            template<class WriteFunction>
+            boost::tribool
+            write(resume_context&& rc, error_code&,
+                WriteFunction&& wf) noexcept
+            {
+                if(! body_.ready)
+                {
+                    body_.rc = std::move(rc);
+                    return boost::indeterminate;
+                }
+                if(n_ < body_.s.size())
+                    wf(boost::asio::buffer(&body_.s[n_++], 1));
+                return n_ == body_.s.size();
+            }
+        };
+    };
+
+    template<class Serializer>
+    std::string
+    drain(Serializer& sr, std::size_t step = 0)
+    {
+        std::string s;
+        error_code ec;
+        while(! sr.is_done())
+        {
+            auto const b = sr.next(ec);
+            if(! BEAST_EXPECTS(! ec, ec.message()))
+                break;
+            auto const n = boost::asio::buffer_size(b);
+            if(! BEAST_EXPECT(n > 0))
+                break;
+            auto const used = step == 0 ? n : std::min(step, n);
+            s += beast::to_string(b).substr(0, used);
+            sr.consume(used);
+        }
+        return s;
+    }
+
+    void testSerialize()
+    {
+        response<string_body> m;
+        m.version = 11;
+        m.status = 200;
+        m.reason = "OK";
+        m.headers.insert("Content-Length", "5");
+        m.body = "*****";
+        std::string const s =
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "*****";
+        {
+            serializer<false, string_body, headers> sr{m};
+            BEAST_EXPECT(! sr.is_done());
+            BEAST_EXPECT(sr.keep_alive());
+            error_code ec;
+            auto const b = sr.next(ec);
+            BEAST_EXPECT(! ec);
+            // Headers and body are returned together
+            BEAST_EXPECT(beast::to_string(b) == s);
+            // Unconsumed octets are returned again
+            BEAST_EXPECT(beast::to_string(sr.next(ec)) == s);
+            sr.consume(3);
+            BEAST_EXPECT(beast::to_string(sr.next(ec)) == s.substr(3));
+            sr.consume(1000);
+            BEAST_EXPECT(sr.is_done());
+            BEAST_EXPECT(boost::asio::buffer_size(sr.next(ec)) == 0);
+        }
+        for(std::size_t step = 1; step < 8; ++step)
+        {
+            serializer<false, string_body, headers> sr{m};
+            BEAST_EXPECT(drain(sr, step) == s);
+        }
+        {
+            m.version = 10;
+            m.headers.erase("Content-Length");
+            serializer<false, string_body, headers> sr{m};
+            BEAST_EXPECT(! sr.keep_alive());
+        }
+    }
+
+    void testChunked()
+    {
+        response<string_body> m;
+        m.version = 11;
+        m.status = 200;
+        m.reason = "OK";
+        m.headers.insert("Transfer-Encoding", "chunked");
+        m.body = "hello";
+        {
+            serializer<false, string_body, headers> sr{m};
+            error_code ec;
+            // The final chunk is coalesced with the body
+            BEAST_EXPECT(beast::to_string(sr.next(ec)) ==
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "5\r\nhello\r\n"
+                "0\r\n\r\n");
+        }
+        {
+            m.body = "";
+            serializer<false, string_body, headers> sr{m};
+            BEAST_EXPECT(drain(sr) ==
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "0\r\n\r\n");
+        }
+        {
+            response<slow_body> m1;
+            m1.version = 11;
+            m1.status = 200;
+            m1.reason = "OK";
+            m1.headers.insert("Transfer-Encoding", "chunked");
+            m1.body.s = "abc";
+            serializer<false, slow_body, headers> sr{m1};
+            BEAST_EXPECT(drain(sr) ==
+                "HTTP/1.1 200 OK\r\n"
+                "Transfer-Encoding: chunked\r\n"
+                "\r\n"
+                "1\r\na\r\n"
+                "1\r\nb\r\n"
+                "1\r\nc\r\n"
+                "0\r\n\r\n");
+        }
+    }
+
+    void testSuspend()
+    {
+        response<slow_body> m;
+        m.version = 11;
+        m.status = 200;
+        m.reason = "OK";
+        m.headers.insert("Content-Length", "2");
+        m.body.s = "ab";
+        m.body.ready = false;
+        bool resumed = false;
+        serializer<false, slow_body, headers> sr{m,
+            [&]{ resumed = true; }};
+        error_code ec;
+        // The headers are available before the body
+        auto b = sr.next(ec);
+        BEAST_EXPECT(beast::to_string(b) ==
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 2\r\n"
+            "\r\n");
+        sr.consume(boost::asio::buffer_size(b));
+        BEAST_EXPECT(boost::asio::buffer_size(sr.next(ec)) == 0);
+        BEAST_EXPECT(! ec);
+        BEAST_EXPECT(! sr.is_done());
+        m.body.ready = true;
+        m.body.rc();
+        BEAST_EXPECT(resumed);
+        BEAST_EXPECT(drain(sr) == "ab");
+    }
+
+    void testBatch()
+    {
+        response<string_body> m1;
+        m1.version = 11;
+        m1.status = 200;
+        m1.reason = "OK";
+        m1.headers.insert("Content-Length", "1");
+        m1.body = "1";
+        response<string_body> m2 = m1;
+        m2.body = "2";
+        serializer<false, string_body, headers> sr1{m1};
+        serializer<false, string_body, headers> sr2{m2};
+        error_code ec;
+        // Both responses in a single gathered write
+        auto const b = buffer_cat(sr1.next(ec), sr2.next(ec));
+        BEAST_EXPECT(beast::to_string(b) ==
+            "HTTP/1.1 200 OK\r\nContent-Length: 1\r\n\r\n1"
+            "HTTP/1.1 200 OK\r\nContent-Length: 1\r\n\r\n2");
+        sr1.consume(boost::asio::buffer_size(b));
+        sr2.consume(boost::asio::buffer_size(b));
+        BEAST_EXPECT(sr1.is_done());
+        BEAST_EXPECT(sr2.is_done());
+    }
+
+    void run() override
+    {
+        testSerialize();
+        testChunked();
+        testSuspend();
+        testBatch();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(serializer,http,beast);
+
+} // http
+} // beast
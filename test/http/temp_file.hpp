@@ -0,0 +1,64 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BEAST_HTTP_TEST_TEMP_FILE_HPP
+#define BEAST_HTTP_TEST_TEMP_FILE_HPP
+
+#include <boost/filesystem.hpp>
+#include <fstream>
+#include <string>
+
+namespace beast {
+namespace http {
+
+// A file with a unique name which is removed on destruction
+class temp_file
+{
+    boost::filesystem::path path_;
+
+public:
+    temp_file()
+        : path_(boost::filesystem::temp_directory_path() /
+            boost::filesystem::unique_path())
+    {
+    }
+
+    explicit
+    temp_file(std::string const& data)
+        : temp_file()
+    {
+        write(data);
+    }
+
+    ~temp_file()
+    {
+        boost::system::error_code ec;
+        boost::filesystem::remove(path_, ec);
+    }
+
+    temp_file(temp_file const&) = delete;
+    temp_file& operator=(temp_file const&) = delete;
+
+    // Replace the contents of the file
+    void
+    write(std::string const& data)
+    {
+        std::ofstream os(path_.string(), std::ios::binary);
+        os.write(data.data(), data.size());
+    }
+
+    std::string
+    path() const
+    {
+        return path_.string();
+    }
+};
+
+} // http
+} // beast
+
+#endif
@@ -22,6 +22,7 @@
 #include <boost/asio/error.hpp>
 #include <sstream>
 #include <string>
+#include <thread>
 
 namespace beast {
 namespace http {
@@ -93,6 +94,128 @@ public:
         }
     };
 
+    // Counts the number of times a writer is initialized
+    struct counted_body
+    {
+        struct value_type
+        {
+            std::string s;
+            int inits = 0;
+        };
+
+        class writer
+        {
+            value_type& body_;
+
+        public:
+            template<bool isRequest, class Headers>
+            explicit
+            writer(message<isRequest,
+                    counted_body, Headers> const& msg) noexcept
+                : body_(const_cast<value_type&>(msg.body))
+            {
+            }
+
+            void
+            init(error_code&) noexcept
+            {
+                ++body_.inits;
+            }
+
+            std::uint64_t
+            content_length() const noexcept
+            {
+                return body_.s.size();
+            }
+
+            template<class WriteFunction>
+            boost::tribool
+            write(resume_context&&, error_code&,
+                WriteFunction&& wf) noexcept
+            {
+                wf(boost::asio::buffer(body_.s));
+                return true;
+            }
+        };
+    };
+
+    // Produces the body one octet at a time
+    struct chatty_body
+    {
+        struct value_type
+        {
+            std::string s;
+            std::size_t min = 0;
+            std::size_t flush_at = 0;
+            std::size_t suspend_at = 0;
+            // If set, receives the resume context
+            resume_context* hold = nullptr;
+        };
+
+        class writer
+        {
+            value_type const& body_;
+            std::size_t n_ = 0;
+            bool suspended_ = false;
+            std::thread t_;
+
+        public:
+            template<bool isRequest, class Headers>
+            explicit
+            writer(message<isRequest,
+                    chatty_body, Headers> const& msg) noexcept
+                : body_(msg.body)
+            {
+            }
+
+            ~writer()
+            {
+                if(t_.joinable())
+                    t_.join();
+            }
+
+            void
+            init(error_code&) noexcept
+            {
+            }
+
+            std::size_t
+            min_chunk_size() const noexcept
+            {
+                return body_.min;
+            }
+
+            template<class WriteFunction>
+            boost::tribool
+            write(resume_context&& rc, error_code&,
+                WriteFunction&& wf) noexcept
+            {
+                if(n_ == body_.suspend_at && ! suspended_)
+                {
+                    suspended_ = true;
+                    if(body_.hold)
+                    {
+                        *body_.hold = std::move(rc);
+                        return boost::indeterminate;
+                    }
+                    t_ = std::thread{
+                        [rc]() mutable
+                        {
+                            rc();
+                        }};
+                    return boost::indeterminate;
+                }
+                if(n_ >= body_.s.size())
+                    return true;
+                wf(boost::asio::buffer(&body_.s[n_], 1));
+                ++n_;
+                if(n_ == body_.flush_at)
+                    wf.flush();
+                return n_ == body_.s.size();
+            }
+        };
+    };
+
     struct unsized_body
     {
         using value_type = std::string;
@@ -599,6 +722,170 @@ public:
         }
     }
 
+    void
+    testSerializer(yield_context do_yield)
+    {
+        auto const expected =
+            "HTTP/1.1 200 OK\r\n"
+            "Content-Length: 5\r\n"
+            "\r\n"
+            "*****";
+        {
+            response<counted_body> m;
+            m.version = 11;
+            m.status = 200;
+            m.reason = "OK";
+            m.body.s = "*****";
+            serializer<false, counted_body, headers> sr{m};
+            prepare(m, sr);
+            BEAST_EXPECT(m.body.inits == 1);
+            string_write_stream ss(ios_);
+            write(ss, sr);
+            BEAST_EXPECT(ss.str == expected);
+            // The writer is initialized only once
+            BEAST_EXPECT(m.body.inits == 1);
+        }
+        {
+            response<counted_body> m;
+            m.version = 11;
+            m.status = 200;
+            m.reason = "OK";
+            m.body.s = "*****";
+            serializer<false, counted_body, headers> sr{m};
+            prepare(m, sr);
+            error_code ec;
+            string_write_stream ss(ios_);
+            async_write(ss, sr, do_yield[ec]);
+            BEAST_EXPECTS(! ec, ec.message());
+            BEAST_EXPECT(ss.str == expected);
+            BEAST_EXPECT(m.body.inits == 1);
+        }
+        {
+            // prepare options apply to the serializer
+            response<counted_body> m;
+            m.version = 11;
+            m.status = 200;
+            m.reason = "OK";
+            m.body.s = "*****";
+            serializer<false, counted_body, headers> sr{m};
+            BEAST_EXPECT(sr.keep_alive());
+            prepare(m, sr, connection::close);
+            BEAST_EXPECT(! sr.keep_alive());
+            error_code ec;
+            string_write_stream ss(ios_);
+            write(ss, sr, ec);
+            BEAST_EXPECT(ec == boost::asio::error::eof);
+            BEAST_EXPECT(m.body.inits == 1);
+        }
+    }
+
+    void
+    testCoalesce(yield_context do_yield)
+    {
+        auto const check =
+            [&](std::size_t min, std::size_t flush_at,
+                std::size_t suspend_at, std::string const& body)
+            {
+                response<chatty_body> m;
+                m.version = 11;
+                m.status = 200;
+                m.reason = "OK";
+                m.headers.insert("Transfer-Encoding", "chunked");
+                m.body.s = "abcdefghij";
+                m.body.min = min;
+                m.body.flush_at = flush_at;
+                m.body.suspend_at = suspend_at;
+                auto const expected =
+                    "HTTP/1.1 200 OK\r\n"
+                    "Transfer-Encoding: chunked\r\n"
+                    "\r\n" + body;
+                {
+                    string_write_stream ss(ios_);
+                    error_code ec;
+                    write(ss, m, ec);
+                    BEAST_EXPECTS(! ec, ec.message());
+                    BEAST_EXPECT(ss.str == expected);
+                }
+                {
+                    string_write_stream ss(ios_);
+                    error_code ec;
+                    async_write(ss, m, do_yield[ec]);
+                    BEAST_EXPECTS(! ec, ec.message());
+                    BEAST_EXPECT(ss.str == expected);
+                }
+            };
+        // each octet is its own chunk
+        check(0, 0, 100,
+            "1\r\na\r\n1\r\nb\r\n1\r\nc\r\n1\r\nd\r\n"
+            "1\r\ne\r\n1\r\nf\r\n1\r\ng\r\n1\r\nh\r\n"
+            "1\r\ni\r\n1\r\nj\r\n0\r\n\r\n");
+        // the last chunk goes out with the final chunk
+        check(4, 0, 100,
+            "4\r\nabcd\r\n4\r\nefgh\r\n2\r\nij\r\n0\r\n\r\n");
+        check(5, 0, 100,
+            "5\r\nabcde\r\n5\r\nfghij\r\n0\r\n\r\n");
+        check(100, 0, 100,
+            "a\r\nabcdefghij\r\n0\r\n\r\n");
+        // explicit flush
+        check(4, 2, 100,
+            "2\r\nab\r\n4\r\ncdef\r\n4\r\nghij\r\n0\r\n\r\n");
+        // suspending sends what was collected
+        check(4, 0, 5,
+            "4\r\nabcd\r\n1\r\ne\r\n4\r\nfghi\r\n1\r\nj\r\n0\r\n\r\n");
+        check(100, 0, 0,
+            "a\r\nabcdefghij\r\n0\r\n\r\n");
+        check(100, 0, 10,
+            "a\r\nabcdefghij\r\n0\r\n\r\n");
+        {
+            // A failed write of the collected data completes
+            // the operation without waiting for the resume.
+            response<chatty_body> m;
+            m.version = 11;
+            m.status = 200;
+            m.reason = "OK";
+            m.headers.insert("Transfer-Encoding", "chunked");
+            m.body.s = "abcdefghij";
+            m.body.min = 100;
+            m.body.suspend_at = 5;
+            resume_context rc;
+            m.body.hold = &rc;
+            test::fail_counter fc(0);
+            test::fail_stream<string_write_stream> fs(fc, ios_);
+            error_code ec;
+            async_write(fs, m, do_yield[ec]);
+            BEAST_EXPECTS(ec == test::error::fail_error,
+                ec.message());
+            BEAST_EXPECT(rc);
+            // Resuming afterwards does nothing
+            rc();
+            BEAST_EXPECT(fs.next_layer().str.empty());
+        }
+    }
+
+    void testStatusLine()
+    {
+        auto const line =
+            [&](int version, int status, std::string const& reason)
+            {
+                message<false, string_body, headers> m;
+                m.version = version;
+                m.status = status;
+                m.reason = reason;
+                m.headers.insert("Content-Length", "0");
+                auto const s = str(m);
+                return s.substr(0, s.find("\r\n"));
+            };
+        BEAST_EXPECT(line(11, 200, "OK") == "HTTP/1.1 200 OK");
+        BEAST_EXPECT(line(10, 404, "Not Found") == "HTTP/1.0 404 Not Found");
+        BEAST_EXPECT(line(11, 200, "Fine") == "HTTP/1.1 200 Fine");
+        BEAST_EXPECT(line(11, 200, "O") == "HTTP/1.1 200 O");
+        BEAST_EXPECT(line(11, 200, "") == "HTTP/1.1 200 ");
+        BEAST_EXPECT(line(11, 299, "Custom") == "HTTP/1.1 299 Custom");
+        BEAST_EXPECT(line(11, 306, "<reserved>") == "HTTP/1.1 306 <reserved>");
+        BEAST_EXPECT(line(20, 200, "OK") == "HTTP/2.0 200 OK");
+        BEAST_EXPECT(line(11, 1000, "Big") == "HTTP/1.1 1000 Big");
+    }
+
     void testConvert()
     {
         message<true, string_body, headers> m;
@@ -635,15 +922,98 @@ public:
         }
     }
 
+    void testToString()
+    {
+        auto const check =
+            [&](message<false, string_body, headers> const& m)
+            {
+                auto const expected =
+                    boost::lexical_cast<std::string>(m);
+                BEAST_EXPECT(to_string(m) == expected);
+                streambuf sb;
+                error_code ec;
+                serialize_to(sb, m, ec);
+                BEAST_EXPECTS(! ec, ec.message());
+                BEAST_EXPECT(beast::to_string(sb.data()) == expected);
+                // appends to existing content
+                serialize_to(sb, m);
+                BEAST_EXPECT(beast::to_string(sb.data()) ==
+                    expected + expected);
+            };
+        message<false, string_body, headers> m;
+        m.version = 11;
+        m.status = 200;
+        m.reason = "OK";
+        m.headers.insert("Server", "test");
+        m.body = "*****";
+        prepare(m);
+        check(m);
+        {
+            auto const s = to_string(m);
+            BEAST_EXPECT(s ==
+                "HTTP/1.1 200 OK\r\n"
+                "Server: test\r\n"
+                "Content-Length: 5\r\n"
+                "\r\n"
+                "*****");
+        }
+        m.body = std::string(10000, '*');
+        m.headers.replace("Content-Length", "10000");
+        check(m);
+        // no error for a message which closes the connection
+        m.headers.insert("Connection", "close");
+        check(m);
+        m.headers.erase("Content-Length");
+        m.headers.erase("Connection");
+        m.headers.insert("Transfer-Encoding", "chunked");
+        check(m);
+        BEAST_EXPECT(to_string(m).substr(to_string(m).size() - 5) ==
+            "0\r\n\r\n");
+        {
+            test::fail_counter fc(0);
+            message<false, fail_body, headers> fm(
+                std::piecewise_construct,
+                    std::forward_as_tuple(fc, ios_));
+            fm.version = 11;
+            fm.status = 200;
+            fm.reason = "OK";
+            try
+            {
+                to_string(fm);
+                fail();
+            }
+            catch(system_error const&)
+            {
+                pass();
+            }
+            test::fail_counter fc2(0);
+            message<false, fail_body, headers> fm2(
+                std::piecewise_construct,
+                    std::forward_as_tuple(fc2, ios_));
+            fm2.version = 11;
+            streambuf sb;
+            error_code ec;
+            serialize_to(sb, fm2, ec);
+            BEAST_EXPECT(ec == test::error::fail_error);
+            BEAST_EXPECT(sb.size() == 0);
+        }
+    }
+
     void run() override
     {
         yield_to(std::bind(&write_test::testAsyncWrite,
             this, std::placeholders::_1));
         yield_to(std::bind(&write_test::testFailures,
             this, std::placeholders::_1));
+        yield_to(std::bind(&write_test::testSerializer,
+            this, std::placeholders::_1));
+        yield_to(std::bind(&write_test::testCoalesce,
+            this, std::placeholders::_1));
         testOutput();
+        testStatusLine();
         testConvert();
         testOstream();
+        testToString();
     }
 };
 
@@ -0,0 +1,120 @@
+//
+// Copyright (c) 2013-2016 Vinnie Falco (vinnie dot falco at gmail dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "message_fuzz.hpp"
+
+#include <beast/http.hpp>
+#include <beast/core/streambuf.hpp>
+#include <beast/unit_test/suite.hpp>
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace beast {
+namespace http {
+
+class write_bench_test : public beast::unit_test::suite
+{
+public:
+    static std::size_t constexpr N = 1000;
+
+    std::vector<request<string_body>> corpus_;
+
+    write_bench_test()
+    {
+        corpus_.reserve(N);
+        message_fuzz mg;
+        for(std::size_t i = 0; i < N; ++i)
+        {
+            streambuf sb;
+            mg.request(sb);
+            parser_v1<true, string_body, headers> p;
+            error_code ec;
+            p.write(sb.data(), ec);
+            if(! ec)
+                corpus_.emplace_back(p.release());
+        }
+    }
+
+    template<class Function>
+    void
+    timedTest(std::size_t repeat, std::string const& name, Function&& f)
+    {
+        using namespace std::chrono;
+        using clock_type = std::chrono::high_resolution_clock;
+        log << name << std::endl;
+        for(std::size_t trial = 1; trial <= repeat; ++trial)
+        {
+            auto const t0 = clock_type::now();
+            f();
+            auto const elapsed = clock_type::now() - t0;
+            log <<
+                "Trial " << trial << ": " <<
+                duration_cast<milliseconds>(elapsed).count() << " ms" << std::endl;
+        }
+    }
+
+    void
+    testSpeed()
+    {
+        static std::size_t constexpr Trials = 3;
+        static std::size_t constexpr Repeat = 50;
+
+        std::size_t n0 = 0;
+        std::size_t n1 = 0;
+        std::size_t n2 = 0;
+
+        testcase << "Serialize " <<
+            (Repeat * corpus_.size()) << " messages";
+        timedTest(Trials, "operator<<",
+            [&]
+            {
+                n0 = 0;
+                for(std::size_t i = 0; i < Repeat; ++i)
+                    for(auto const& m : corpus_)
+                    {
+                        std::ostringstream ss;
+                        ss << m;
+                        n0 += ss.str().size();
+                    }
+            });
+        timedTest(Trials, "to_string",
+            [&]
+            {
+                n1 = 0;
+                for(std::size_t i = 0; i < Repeat; ++i)
+                    for(auto const& m : corpus_)
+                        n1 += to_string(m).size();
+            });
+        timedTest(Trials, "serialize_to",
+            [&]
+            {
+                n2 = 0;
+                for(std::size_t i = 0; i < Repeat; ++i)
+                    for(auto const& m : corpus_)
+                    {
+                        streambuf sb;
+                        serialize_to(sb, m);
+                        n2 += sb.size();
+                    }
+            });
+        BEAST_EXPECT(n0 == n1);
+        BEAST_EXPECT(n0 == n2);
+    }
+
+    void run() override
+    {
+        pass();
+        testSpeed();
+    }
+};
+
+BEAST_DEFINE_TESTSUITE(write_bench,http,beast);
+
+} // http
+} // beast